@@ -22,6 +22,21 @@
 
 namespace QuantLib {
 
+    void Lattice::rollback(
+              const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets,
+              Time to) const {
+        partialRollback(assets, to);
+        for (Size k=0; k<assets.size(); ++k)
+            assets[k]->adjustValues();
+    }
+
+    void Lattice::partialRollback(
+              const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets,
+              Time to) const {
+        for (Size k=0; k<assets.size(); ++k)
+            partialRollback(*assets[k], to);
+    }
+
     void DiscretizedOption::postAdjustValuesImpl() {
         /* In the real world, with time flowing forward, first
            any payment is settled and only after options can be
@@ -55,6 +55,14 @@ namespace QuantLib {
                       Array& newSpreadAdjustedRate) const;
         void rollback(DiscretizedAsset&, Time to) const;
         void partialRollback(DiscretizedAsset&, Time to) const;
+        using Lattice::rollback;
+        // convertibles need their own rollback, one at a time
+        void partialRollback(
+                const std::vector<boost::shared_ptr<DiscretizedAsset> >&
+                                                                  assets,
+                Time to) const {
+            Lattice::partialRollback(assets, to);
+        }
 
       private:
         Spread creditSpread_;
@@ -23,6 +23,8 @@
 #include <ql/math/beta.hpp>
 #include <ql/math/statistics/histogram.hpp>
 #include <ql/math/statistics/riskstatistics.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/experimental/credit/basket.hpp>
@@ -36,6 +38,10 @@
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
 */
@@ -73,10 +79,26 @@ namespace QuantLib {
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample.
+    They also have the accompanying event trait to specify.
+
+    When the sequence generator can be split (see SplittingTraits) the
+    simulations are divided into a fixed number of shards, each drawing from
+    its own split of the generator, which are run in parallel by OpenMP
+    threads. The scenarios don't depend on the number of threads. With a
+    generator whose split skips ahead in its sequence (e.g., Sobol) they are
+    also the same as those drawn from the unsplit generator; with a
+    pseudo-random one each shard is an independent stream seeded from the
+    parent generator, so that the scenarios differ from those of a model
+    whose generator can't be split. The default time inversion reads the default curves concurrently,
+    so derived classes must evaluate in initDates() (which is called
+    serially before the simulations) every term structure their nextSample()
+    reads; lazy curves are then bootstrapped before they are shared.
+
+    In streaming mode (see setStreamingDates) the scenarios are not stored;
+    the tranche loss and the number and order of defaults at the requested
+    dates are accumulated while simulating instead.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -100,6 +122,29 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        // statistics accumulated on the fly in streaming mode, one entry per
+        //   streaming date
+        struct StreamedStatistics {
+            StreamedStatistics(Size nDates = 0, Size nNames = 0)
+            : trancheLoss(nDates),
+              eventCounts(nDates, std::vector<Real>(nNames+1, 0.)),
+              nthEventHits(nDates, Matrix(nNames, nNames, 0.)) {}
+            void merge(const StreamedStatistics& other) {
+                for(Size i=0; i<trancheLoss.size(); i++) {
+                    trancheLoss[i].merge(other.trancheLoss[i]);
+                    std::transform(eventCounts[i].begin(),
+                        eventCounts[i].end(), other.eventCounts[i].begin(),
+                        eventCounts[i].begin(), std::plus<Real>());
+                    nthEventHits[i] += other.nthEventHits[i];
+                }
+            }
+            // tranched portfolio losses
+            std::vector<IncrementalStatistics> trancheLoss;
+            // number of scenarios with a given number of events
+            std::vector<std::vector<Real> > eventCounts;
+            // (n-1, name): number of scenarios where the name is the n-th
+            std::vector<Matrix> nthEventHits;
+        };
     protected:
         RandomLM(Size numFactors,
             Size numLMVars,
@@ -124,16 +169,167 @@ namespace QuantLib {
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            const Date today = Settings::instance().evaluationDate();
+            streamingDays_.clear();
+            for(Size i=0; i<streamingDates_.size(); i++) {
+                QL_REQUIRE(streamingDates_[i] > today,
+                    "Streaming dates must be in the future.");
+                streamingDays_.push_back(streamingDates_[i].serialNumber()
+                    - today.serialNumber());
+            }
+            streamedStats_ =
+                StreamedStatistics(streamingDays_.size(), basket_->size());
+            simsBuffer_.clear();
+            if(streamingDays_.empty())
+                simsBuffer_.resize(nSims_);
+
+            performSimulations(boost::integral_constant<bool,
+                SplittingTraits<USNG>::allowsSplitting != 0>());
+        }
+
+        void performSimulations(boost::false_type) const {
+            simulate(*copulasRng_, 0, nSims_, streamedStats_);
+        }
+
+        void performSimulations(boost::true_type) const {
+            // the number of shards doesn't depend on the number of threads
+            //   and the generator is split serially, so that each shard is
+            //   given the same scenarios however many threads run them
+            Size nShards = std::min<Size>(Size(maxShards_), nSims_);
+            std::vector<Size> firstSims(nShards), sizes(nShards);
+            std::vector<boost::shared_ptr<copulaRNG_type> > rngs(nShards);
+            for(Size i=0, first=0; i<nShards; i++) {
+                sizes[i] = nSims_/nShards + (i < nSims_%nShards ? 1 : 0);
+                firstSims[i] = first;
+                first += sizes[i];
+                rngs[i] = boost::make_shared<copulaRNG_type>(
+                    copulasRng_->split(sizes[i]));
+            }
+
+            // shards are run one per thread, a batch at a time, and their
+            //   statistics are merged in shard order
+            Size nThreads = 1;
+            #ifdef _OPENMP
+            nThreads = std::min<Size>(omp_get_max_threads(), nShards);
+            #endif
+            const StreamedStatistics noStats = streamedStats_;
+            std::vector<StreamedStatistics> stats(nThreads);
+            std::vector<std::string> errors(nThreads);
+
+            for(Size batch=0; batch<nShards; batch+=nThreads) {
+                Size n = std::min(nThreads, nShards-batch);
+                // initDates() has evaluated the default curves already
+                #if defined(_OPENMP)
+                #pragma omp parallel for
+                #endif
+                for(Size i=0; i<n; i++) {
+                    try {
+                        stats[i] = noStats;
+                        simulate(*rngs[batch+i], firstSims[batch+i],
+                            sizes[batch+i], stats[i]);
+                    } catch (std::exception& e) {
+                        errors[i] = e.what();
+                    } catch (...) {
+                        errors[i] = "unknown error";
+                    }
+                }
+
+                for(Size i=0; i<n; i++) {
+                    QL_REQUIRE(errors[i].empty(), errors[i]);
+                    streamedStats_.merge(stats[i]);
+                }
             }
         }
 
+        /* Simulates the scenarios [firstSim, firstSim+nSims) drawing from the
+        given generator; stores them in the buffer or, in streaming mode,
+        adds them to the given statistics.
+        */
+        void simulate(const copulaRNG_type& rng, Size firstSim, Size nSims,
+            StreamedStatistics& stats) const {
+            std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >
+                events;
+            for(Size iSim=firstSim; iSim<firstSim+nSims; iSim++) {
+                const std::vector<Real>& sample = rng.nextSequence().value;
+                if(streamingDays_.empty()) {
+                    static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
+                        this)->nextSample(sample, simsBuffer_[iSim]);
+                } else {
+                    events.clear();
+                    static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
+                        this)->nextSample(sample, events);
+                    accumulate(events, stats);
+                }
+            }
+        }
+
+        // Adds the statistics of a scenario at each streaming date.
+        void accumulate(
+            const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
+                events,
+            StreamedStatistics& stats) const
+        {
+            const Date today = Settings::instance().evaluationDate();
+            const Real attachAmount = basket_->attachmentAmount();
+            const Real detachAmount = basket_->detachmentAmount();
+
+            for(Size iDate=0; iDate<streamingDays_.size(); iDate++) {
+                const Natural val = streamingDays_[iDate];
+                Size simCount = 0;
+                // sorted by date, one name per date as in probsBeingNthEvent
+                std::map<Size, Size> namesDefaulting;
+                for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+                    if(val > events[iEvt].dayFromRef) {
+                        simCount++;
+                        namesDefaulting.insert(std::make_pair(
+                            Size(events[iEvt].dayFromRef),
+                            Size(events[iEvt].nameIdx)));
+                    }
+                }
+                stats.eventCounts[iDate][simCount]++;
+                Size nth = 0;
+                for(std::map<Size, Size>::const_iterator it =
+                    namesDefaulting.begin(); it != namesDefaulting.end();
+                    ++it, ++nth)
+                    stats.nthEventHits[iDate][nth][it->second]++;
+                stats.trancheLoss[iDate].add(trancheLoss(events, val, today,
+                    attachAmount, detachAmount));
+            }
+        }
+
+        // Tranche loss in a scenario, counting the events before the given
+        //   number of days from today.
+        Real trancheLoss(
+            const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
+                events,
+            BigInteger days, const Date& today,
+            Real attachAmount, Real detachAmount) const
+        {
+            Real portfSimLoss = 0.;
+            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+                // if event is within time horizon...
+                if(days > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
+                    Size iName = events[iEvt].nameIdx;
+                    portfSimLoss +=
+                        basket_->exposure(basket_->names()[iName],
+                            Date(events[iEvt].dayFromRef +
+                                today.serialNumber())) *
+                                    (1.-getEventRecovery(events[iEvt]));
+                }
+            }
+            return std::min(std::max(portfSimLoss - attachAmount, 0.),
+                detachAmount - attachAmount);
+        }
+
+        // Position of the date among the streaming dates.
+        Size streamingDateIndex(const Date& d) const {
+            std::vector<Date>::const_iterator it =
+                std::find(streamingDates_.begin(), streamingDates_.end(), d);
+            QL_REQUIRE(it != streamingDates_.end(), "Statistics at " << d <<
+                " were not accumulated; not one of the streaming dates.");
+            return std::distance(streamingDates_.begin(), it);
+        }
+
         /* Method to access simulation results and avoiding a copy of
         each thread results buffer. PerformCalculations should have been called.
         Here in the monothread version this method is redundant/trivial but
@@ -141,7 +337,11 @@ namespace QuantLib {
         stored.
         */
         const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+            getSim(const Size iSim) const {
+            QL_REQUIRE(streamingDates_.empty(),
+                "Simulations are not stored in streaming mode.");
+            return simsBuffer_[iSim];
+        }
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -204,8 +404,21 @@ namespace QuantLib {
         //@}
     public:
         virtual ~RandomLM() {}
+        /*! Switches to streaming mode: the scenarios are not stored, and
+        the tranche loss and N-th-to-default statistics at the given dates are
+        accumulated on the fly. Only probAtLeastNEvents, probsBeingNthEvent
+        and expectedTrancheLoss(Interval) are then available, and at these
+        dates only. An empty vector switches back to storing the scenarios.
+        */
+        void setStreamingDates(const std::vector<Date>& dates) {
+            streamingDates_ = dates;
+            update();
+        }
     private:
         BigNatural seed_;
+        std::vector<Date> streamingDates_;
+        mutable std::vector<Natural> streamingDays_;
+        mutable StreamedStatistics streamedStats_;
     protected:
         const Size numFactors_;
         const Size numLMVars_;
@@ -220,6 +433,8 @@ namespace QuantLib {
 
         // Maximum time inversion horizon
         static const Size maxHorizon_ = 4050; // over 11 years
+        // Number of blocks the simulations are split into
+        static const Size maxShards_ = 64;
         // Inversion probability limits are computed by children in initdates()
     };
 
@@ -239,6 +454,14 @@ namespace QuantLib {
 
         if(n==0) return 1.;
 
+        if(!streamingDates_.empty()) {
+            const std::vector<Real>& eventCounts =
+                streamedStats_.eventCounts[streamingDateIndex(d)];
+            return std::accumulate(
+                eventCounts.begin() + std::min(n, eventCounts.size()),
+                eventCounts.end(), Real(0.)) / nSims_;
+        }
+
         Real counts = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
@@ -268,6 +491,16 @@ namespace QuantLib {
         // casted to natural to avoid warning, we have just checked the sign
         Natural val = d.serialNumber() - today.serialNumber();
 
+        if(!streamingDates_.empty()) {
+            const Matrix& hits =
+                streamedStats_.nthEventHits[streamingDateIndex(d)];
+            std::vector<Probability> probs(hits.row_begin(n-1),
+                hits.row_end(n-1));
+            std::transform(probs.begin(), probs.end(), probs.begin(),
+                std::bind2nd(std::divides<Real>(), nSims_));
+            return probs;
+        }
+
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
             const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
@@ -352,31 +585,21 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         BigInteger val = d.serialNumber() - today.serialNumber();
 
+        if(!streamingDates_.empty()) {
+            const IncrementalStatistics& lossStats =
+                streamedStats_.trancheLoss[streamingDateIndex(d)];
+            return std::make_pair(lossStats.mean(), lossStats.errorEstimate()*
+                InverseCumulativeNormal::standard_value(
+                    0.5*(1.+confidencePerc)));
+        }
+
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        // Real trancheLoss= 0.;
         GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                // if event is within time horizon...
-                if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-               }
-            }
-            lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
-                    detachAmount - attachAmount) );
-        }
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            lossStats.add(trancheLoss(getSim(iSim), val, today,
+                attachAmount, detachAmount));
         return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
             InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
     }
@@ -865,7 +1088,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -874,6 +1098,9 @@ namespace QuantLib {
             Date today = Settings::instance().evaluationDate();
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
+            // this also evaluates the default curves before the simulations
+            //   read them concurrently
+            horizonDefaultPs_.clear();
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
@@ -924,11 +1151,11 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
+        // events is passed empty
 
         for(Size iName=0; iName<copula_->size(); iName++) {
             Real latentVarSample =
@@ -956,8 +1183,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.push_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
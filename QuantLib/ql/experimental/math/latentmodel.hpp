@@ -416,6 +416,18 @@ namespace QuantLib {
             : sequenceGen_(copula.numFactors(), seed), // base case construction
               x_(std::vector<Real>(copula.numFactors()), 1.0),
               copula_(copula) { }
+            //! uses a generator already in position, e.g. a split one
+            FactorSampler(const copulaType& copula, const USNG& generator)
+            : sequenceGen_(generator),
+              x_(std::vector<Real>(copula.numFactors()), 1.0),
+              copula_(copula) { }
+            /*! Returns a sampler drawing the next \f$ n \f$ samples and
+                skips this one past them; only available when the sequence
+                generator can be split (see SplittingTraits.)
+            */
+            FactorSampler split(Size n) {
+                return FactorSampler(copula_, sequenceGen_.split(n));
+            }
             /*! Returns a sample of the factor set \f$ M_k\,Z_i\f$. 
             This method has the vocation of being specialized at particular 
             types of the copula with a more efficient inversion to generate the 
@@ -45,6 +45,15 @@ namespace QuantLib {
         return blackVolatility()->blackVol(t, x, true);
     }
 
+    void ExtendedBlackScholesMertonProcess::evolveBlock(Time t0,
+                                                        const Array& x0,
+                                                        Time dt,
+                                                        const Array& dw,
+                                                        Array& x) const {
+        // the optimized base-class version would bypass evolve()
+        StochasticProcess1D::evolveBlock(t0, x0, dt, dw, x);
+    }
+
     Real ExtendedBlackScholesMertonProcess::evolve(Time t0, Real x0,
                                                    Time dt, Real dw) const {
         Real predictor, sigma0, sigma1;
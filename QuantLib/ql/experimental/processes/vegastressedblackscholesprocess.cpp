@@ -98,6 +98,15 @@ namespace QuantLib {
 
 
 
+    void VegaStressedBlackScholesProcess::evolveBlock(Time t0,
+                                                      const Array& x0,
+                                                      Time dt,
+                                                      const Array& dw,
+                                                      Array& x) const {
+        // the stressed diffusion depends on the asset value
+        StochasticProcess1D::evolveBlock(t0, x0, dt, dw, x);
+    }
+
     Real VegaStressedBlackScholesProcess::diffusion(Time t, Real x) const {
         if (lowerTimeBorderForStressTest_ <= t && t <= upperTimeBorderForStressTest_ 
             && lowerAssetBorderForStressTest_ <= x && x <= upperAssetBorderForStressTest_) {
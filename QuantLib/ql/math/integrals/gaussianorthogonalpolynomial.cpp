@@ -29,15 +29,18 @@
 namespace QuantLib {
 
     Real GaussianOrthogonalPolynomial::value(Size n, Real x) const {
-        if (n > 1) {
-            return  (x-alpha(n-1)) * value(n-1, x)
-                       - beta(n-1) * value(n-2, x);
-        }
-        else if (n == 1) {
-            return x-alpha(0);
+        if (n == 0)
+            return 1;
+
+        // iterate the three-term recurrence instead of recursing twice
+        Real p0 = 1.0, p1 = x-alpha(0);
+        for (Size i=2; i<=n; ++i) {
+            const Real p2 = (x-alpha(i-1))*p1 - beta(i-1)*p0;
+            p0 = p1;
+            p1 = p2;
         }
 
-        return 1;
+        return p1;
     }
 
     Real GaussianOrthogonalPolynomial::weightedValue(Size n, Real x) const {
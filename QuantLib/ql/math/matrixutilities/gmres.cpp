@@ -0,0 +1,154 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gmres.cpp
+    \brief generalized minimal residual method
+*/
+
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace {
+        Real norm2(const Array& a) {
+            return std::sqrt(DotProduct(a, a));
+        }
+    }
+
+    GMRES::GMRES(const GMRES::MatrixMult& A, Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(A), M_(preConditioner),
+      maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater than zero");
+    }
+
+    GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
+        GMRESResult result = solveImpl(b, x0);
+
+        QL_REQUIRE(result.errors.back() < relTol_, "could not converge");
+
+        return result;
+    }
+
+    GMRESResult GMRES::solveWithRestart(
+        Size restart, const Array& b, const Array& x0) const {
+
+        GMRESResult result = solveImpl(b, x0);
+        std::list<Real> errors = result.errors;
+
+        for (Size i=1; i < restart && result.errors.back() >= relTol_; ++i) {
+            result = solveImpl(b, result.x);
+            errors.insert(errors.end(),
+                          result.errors.begin(), result.errors.end());
+        }
+
+        QL_REQUIRE(errors.back() < relTol_, "could not converge");
+
+        result.errors = errors;
+        return result;
+    }
+
+    GMRESResult GMRES::solveImpl(const Array& b, const Array& x0) const {
+        const Array pb = (M_) ? Array(M_(b)) : b;
+        const Real bn = norm2(pb);
+        if (bn == 0.0) {
+            GMRESResult result = { std::list<Real>(1, 0.0), b };
+            return result;
+        }
+
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        Array r = b - A_(x);
+        if (M_)
+            r = M_(r);
+
+        const Real beta = norm2(r);
+        std::list<Real> errors(1, beta/bn);
+        if (errors.back() < relTol_) {
+            GMRESResult result = { errors, x };
+            return result;
+        }
+
+        // Arnoldi basis, Hessenberg matrix stored by rows,
+        // Givens rotations and the rotated right-hand side
+        std::vector<Array> v(1, r/beta);
+        std::vector<Array> h(1, Array(maxIter_, 0.0));
+        std::vector<Real> c(maxIter_), s(maxIter_), g(maxIter_+1, 0.0);
+        g[0] = beta;
+
+        Size j = 0;
+        while (j < maxIter_ && errors.back() >= relTol_) {
+            Array w = A_(v[j]);
+            if (M_)
+                w = M_(w);
+
+            h.push_back(Array(maxIter_, 0.0));
+            for (Size i=0; i <= j; ++i) {
+                h[i][j] = DotProduct(w, v[i]);
+                w -= h[i][j]*v[i];
+            }
+            h[j+1][j] = norm2(w);
+
+            // the Krylov subspace is invariant, x is exact
+            const bool breakdown = (h[j+1][j] <= QL_EPSILON*bn);
+            if (!breakdown)
+                v.push_back(w/h[j+1][j]);
+
+            for (Size i=0; i < j; ++i) {
+                const Real tmp = c[i]*h[i][j] + s[i]*h[i+1][j];
+                h[i+1][j] = c[i]*h[i+1][j] - s[i]*h[i][j];
+                h[i][j] = tmp;
+            }
+
+            const Real nu = std::sqrt(h[j][j]*h[j][j] + h[j+1][j]*h[j+1][j]);
+            // singular Hessenberg matrix, the new direction is dropped
+            // and the caller sees the last residual
+            if (nu == 0.0)
+                break;
+
+            c[j] = h[j][j]/nu;
+            s[j] = h[j+1][j]/nu;
+            h[j][j] = nu;
+            h[j+1][j] = 0.0;
+
+            g[j+1] = -s[j]*g[j];
+            g[j]   =  c[j]*g[j];
+
+            errors.push_back(std::fabs(g[j+1])/bn);
+            ++j;
+
+            if (breakdown)
+                break;
+        }
+
+        // back substitution of the upper triangular system
+        Array y(j, 0.0);
+        for (Size k=j; k > 0; --k) {
+            const Size i = k-1;
+            y[i] = g[i];
+            for (Size l=i+1; l < j; ++l)
+                y[i] -= h[i][l]*y[l];
+            y[i] /= h[i][i];
+        }
+
+        for (Size i=0; i < j; ++i)
+            x += y[i]*v[i];
+
+        GMRESResult result = { errors, x };
+        return result;
+    }
+}
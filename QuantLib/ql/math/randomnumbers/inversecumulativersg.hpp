@@ -63,6 +63,15 @@ namespace QuantLib {
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        /*! returns a generator for the next \f$ n \f$ samples, based
+            on the corresponding split of the uniform generator.
+
+            \pre USG must provide a <tt>split(Size)</tt> method.
+        */
+        InverseCumulativeRsg split(Size n) {
+            return InverseCumulativeRsg(uniformSequenceGenerator_.split(n),
+                                        ICD_);
+        }
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
@@ -84,6 +84,17 @@ namespace QuantLib {
             return sequence_;
         }
         Size dimension() const {return dimensionality_;}
+        /*! returns a generator for an independent stream, seeded
+            from the output of this one.  The number of samples to be
+            drawn from the returned generator is not used.
+        */
+        RandomSequenceGenerator split(Size) {
+            // the result is in [1, 2^31-1]; a null seed would be
+            // replaced by a clock-based one
+            BigNatural seed =
+                static_cast<BigNatural>(rng_.next().value*2147483646.0) + 1;
+            return RandomSequenceGenerator(dimensionality_, RNG(seed));
+        }
       private:
         Size dimensionality_;
         RNG rng_;
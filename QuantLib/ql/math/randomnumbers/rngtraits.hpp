@@ -104,6 +104,35 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+
+    // sequence splitting traits
+
+    //! tells whether a sequence generator can be split into streams
+    /*! Sequence generators providing a <tt>split(Size)</tt> method
+        can specialize this class; the Monte Carlo framework uses it
+        to decide whether paths can be drawn in parallel.
+    */
+    template <class RSG>
+    struct SplittingTraits {
+        enum { allowsSplitting = 0 };
+    };
+
+    template <>
+    struct SplittingTraits<
+                      RandomSequenceGenerator<MersenneTwisterUniformRng> > {
+        enum { allowsSplitting = 1 };
+    };
+
+    template <>
+    struct SplittingTraits<SobolRsg> {
+        enum { allowsSplitting = 1 };
+    };
+
+    template <class USG, class IC>
+    struct SplittingTraits<InverseCumulativeRsg<USG,IC> > {
+        enum { allowsSplitting = SplittingTraits<USG>::allowsSplitting };
+    };
+
 }
 
 
@@ -119,6 +119,19 @@ namespace QuantLib {
                  DirectionIntegers directionIntegers = Jaeckel);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(unsigned long n);
+        /*! returns a copy of the generator that will draw the next
+            \f$ n \f$ samples, and skips this generator past them.
+            Drawing the samples from successive calls to split() gives
+            the same points as drawing them from this generator.
+        */
+        SobolRsg split(Size n) {
+            SobolRsg block(*this);
+            unsigned long drawn =
+                firstDraw_ ? sequenceCounter_ : sequenceCounter_+1;
+            firstDraw_ = true;
+            skipTo(drawn + n);
+            return block;
+        }
         const std::vector<unsigned long>& nextInt32Sequence() const;
         const SobolRsg::sample_type& nextSequence() const {
             const std::vector<unsigned long>& v = nextInt32Sequence();
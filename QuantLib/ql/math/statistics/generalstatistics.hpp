@@ -168,6 +168,9 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data collected by another instance
+        void merge(const GeneralStatistics&);
+
         //! resets the data to a null set
         void reset();
 
@@ -225,6 +228,15 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        QL_REQUIRE(&other != this, "cannot merge statistics with itself");
+        if (other.samples_.empty())
+            return;
+        samples_.insert(samples_.end(),
+                        other.samples_.begin(), other.samples_.end());
+        sorted_ = false;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
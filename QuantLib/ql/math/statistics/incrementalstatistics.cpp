@@ -172,6 +172,32 @@ namespace QuantLib {
         }
     }
 
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        if (other.sampleNumber_ == 0)
+            return;
+
+        Size oldSamples = sampleNumber_;
+        sampleNumber_ += other.sampleNumber_;
+        QL_ENSURE(sampleNumber_ > oldSamples,
+                  "maximum number of samples reached");
+        downsideSampleNumber_ += other.downsideSampleNumber_;
+
+        sampleWeight_ += other.sampleWeight_;
+        downsideSampleWeight_ += other.downsideSampleWeight_;
+        sum_ += other.sum_;
+        quadraticSum_ += other.quadraticSum_;
+        downsideQuadraticSum_ += other.downsideQuadraticSum_;
+        cubicSum_ += other.cubicSum_;
+        fourthPowerSum_ += other.fourthPowerSum_;
+        if (oldSamples == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(other.min_, min_);
+            max_ = std::max(other.max_, max_);
+        }
+    }
+
     void IncrementalStatistics::reset() {
         min_ = QL_MAX_REAL;
         max_ = QL_MIN_REAL;
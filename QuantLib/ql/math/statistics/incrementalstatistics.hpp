@@ -126,6 +126,8 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the data collected by another instance
+        void merge(const IncrementalStatistics&);
         //! resets the data to a null set
         void reset();
         //@}
@@ -42,6 +42,8 @@ namespace QuantLib {
     class GenericRiskStatistics : public S {
       public:
         typedef typename S::value_type value_type;
+        GenericRiskStatistics() {}
+        GenericRiskStatistics(const S& s) : S(s) {}
 
         /*! returns the variance of observations below the mean,
             \f[ \frac{N}{N-1}
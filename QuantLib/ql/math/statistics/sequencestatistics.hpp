@@ -26,6 +26,7 @@
 
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/matrix.hpp>
 
 namespace QuantLib {
@@ -139,6 +140,11 @@ namespace QuantLib {
                 stats_[i].add(*begin, weight);
 
         }
+        /*! adds the data collected by another instance; available
+            when the underlying statistics class provides a merge()
+            method.
+        */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_;
@@ -153,6 +159,8 @@ namespace QuantLib {
     */
     typedef GenericSequenceStatistics<Statistics> SequenceStatistics;
     typedef GenericSequenceStatistics<IncrementalStatistics> SequenceStatisticsInc;
+    typedef GenericSequenceStatistics<StreamingRiskStatistics>
+                                                SequenceStatisticsStreaming;
 
     // inline definitions
 
@@ -226,6 +234,23 @@ namespace QuantLib {
     #undef DEFINE_SEQUENCE_STAT_CONST_METHOD_DOUBLE
 
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                const GenericSequenceStatistics<Stat>& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
     template <class Stat>
     void GenericSequenceStatistics<Stat>::reset(Size dimension) {
         // (re-)initialize
@@ -0,0 +1,202 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        // the quantile at which the k_1 scale function of the
+        // t-digest exceeds its value at q by one
+        Real nextQuantile(Real q, Real compression) {
+            q = std::min(q, 1.0);
+            Real k = compression/(2.0*M_PI)*std::asin(2.0*q-1.0) + 1.0;
+            Real x = 2.0*M_PI*k/compression;
+            return x >= M_PI_2 ? 1.0 : 0.5*(1.0+std::sin(x));
+        }
+
+    }
+
+    StreamingStatistics::StreamingStatistics(Real compression)
+    : compression_(compression), bufferSize_(Size(5*compression)) {
+        QL_REQUIRE(compression >= 20.0,
+                   "compression (" << compression << ") must be >= 20");
+        reset();
+    }
+
+    Real StreamingStatistics::mean() const {
+        QL_REQUIRE(samples() != 0, "empty sample set");
+        return mean_;
+    }
+
+    Real StreamingStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        Real s2 = m2_/sampleWeight_;
+        return s2*N/(N-1.0);
+    }
+
+    Real StreamingStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+
+        Real x = m3_/sampleWeight_;
+        Real sigma = standardDeviation();
+
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real StreamingStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+
+        Real x = m4_/sampleWeight_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(sampleWeight_ > 0.0,
+                   "empty sample set");
+
+        compress();
+
+        Size k = 0, n = centroids_.size();
+        Real integral = 0.0, target = percent*sampleWeight_;
+        while (k < n-1 && integral + centroids_[k].weight < target) {
+            integral += centroids_[k].weight;
+            ++k;
+        }
+        return interpolate(k, (target-integral)/centroids_[k].weight);
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(sampleWeight_ > 0.0,
+                   "empty sample set");
+
+        compress();
+
+        Size k = centroids_.size()-1;
+        Real integral = 0.0, target = percent*sampleWeight_;
+        while (k > 0 && integral + centroids_[k].weight < target) {
+            integral += centroids_[k].weight;
+            --k;
+        }
+        return interpolate(k, 1.0-(target-integral)/centroids_[k].weight);
+    }
+
+    Real StreamingStatistics::interpolate(Size k, Real fraction) const {
+        const Centroid& c = centroids_[k];
+        // single samples are returned exactly
+        if (c.samples == 1)
+            return c.mean;
+        // otherwise, the samples are assumed to be spread uniformly
+        // between the midpoints to the neighboring centroids
+        Real left = (k == 0) ? min_ :
+            std::max(0.5*(centroids_[k-1].mean + c.mean), min_);
+        Real right = (k == centroids_.size()-1) ? max_ :
+            std::min(0.5*(c.mean + centroids_[k+1].mean), max_);
+        fraction = std::max(0.0, std::min(fraction, 1.0));
+        return left + fraction*(right-left);
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        QL_REQUIRE(&other != this, "cannot merge statistics with itself");
+        if (other.sampleNumber_ == 0)
+            return;
+
+        if (sampleNumber_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(other.min_, min_);
+            max_ = std::max(other.max_, max_);
+        }
+        sampleNumber_ += other.sampleNumber_;
+        if (other.sampleWeight_ > 0.0)
+            accumulate(other.sampleWeight_, other.mean_,
+                       other.m2_, other.m3_, other.m4_);
+
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        compress();
+    }
+
+    void StreamingStatistics::reset() {
+        sampleNumber_ = 0;
+        sampleWeight_ = 0.0;
+        mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = max_ = 0.0;
+        centroids_ = std::vector<Centroid>();
+        buffer_ = std::vector<Centroid>();
+        buffer_.reserve(bufferSize_);
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(), lessThan);
+
+        Real total = 0.0;
+        for (Size i=0; i<buffer_.size(); ++i)
+            total += buffer_[i].weight;
+
+        // adjacent centroids are merged as long as the result doesn't
+        // exceed the weight allowed at their position
+        centroids_.clear();
+        Centroid current = buffer_.front();
+        Real weightSoFar = 0.0;
+        Real limit = total*nextQuantile(0.0, compression_);
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& c = buffer_[i];
+            if (weightSoFar + current.weight + c.weight <= limit) {
+                current.weight += c.weight;
+                current.mean += (c.mean - current.mean)*c.weight/current.weight;
+                current.samples += c.samples;
+            } else {
+                weightSoFar += current.weight;
+                centroids_.push_back(current);
+                limit = total*nextQuantile(weightSoFar/total, compression_);
+                current = c;
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+}
+
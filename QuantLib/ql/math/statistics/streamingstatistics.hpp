@@ -0,0 +1,294 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief memory-bounded statistics tool
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Memory-bounded statistics tool
+    /*! This class accumulates a set of data and returns their
+        statistics (e.g: mean, variance, skewness, kurtosis, error
+        estimation, percentile, etc.) without storing the samples.
+
+        Moments are updated in a single pass by means of the
+        pairwise formulas in Pebay, "Formulas for Robust, One-Pass
+        Parallel Computation of Covariances and Arbitrary-Order
+        Statistical Moments", Sandia Report SAND2008-6212 (2008);
+        unlike IncrementalStatistics, they don't suffer from
+        cancellation errors.
+
+        The empirical distribution is summarized by a t-digest
+        (Dunning and Ertl, "Computing Extremely Accurate Quantiles
+        Using t-Digests", 2019) whose size is bounded by the given
+        compression; the error on the rank of the returned
+        percentiles is of the order of the inverse of the
+        compression, and smaller in the tails of the distribution.
+
+        Two instances can be merged, e.g., after having accumulated
+        data in separate threads.
+
+        \test the returned moments and percentiles are checked
+              against those of the GeneralStatistics class, both for
+              a single instance and for merged ones.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        /*! \pre compression must be at least 20; higher values give
+                 more accurate percentiles at the price of higher
+                 memory requirements.
+        */
+        explicit StreamingStatistics(Real compression = 200.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+
+        //! sum of data weights
+        Real weightSum() const;
+
+        //! compression of the quantile sketch
+        Real compression() const;
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, i.e.,
+            \f[ \mathrm{E}\left[f \;|\; \mathcal{R}\right] =
+                \frac{\sum_{x_i \in \mathcal{R}} f(x_i) w_i}{
+                      \sum_{x_i \in \mathcal{R}} w_i}. \f]
+            The range is passed as a boolean function returning
+            <tt>true</tt> if the argument belongs to the range
+            or <tt>false</tt> otherwise.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+
+            \warning the result is approximated by replacing each
+                     group of samples in the quantile sketch with its
+                     mean.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            std::vector<Centroid>::const_iterator i;
+            for (i=centroids_.begin(); i!=centroids_.end(); ++i) {
+                if (inRange(i->mean)) {
+                    num += f(i->mean)*i->weight;
+                    den += i->weight;
+                    N += i->samples;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! estimate of the \f$ y \f$-th percentile, defined as the
+            value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! estimate of the \f$ y \f$-th top percentile, defined as
+            the value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        void merge(const StreamingStatistics&);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size samples;
+        };
+        static bool lessThan(const Centroid& c1, const Centroid& c2) {
+            return c1.mean < c2.mean;
+        }
+        void accumulate(Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        void compress() const;
+        Real interpolate(Size k, Real fraction) const;
+        Real compression_;
+        Size bufferSize_;
+        Size sampleNumber_;
+        Real sampleWeight_, mean_, m2_, m3_, m4_;
+        Real min_, max_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+    //! risk measures based on memory-bounded statistics
+    typedef GenericRiskStatistics<GenericGaussianStatistics<
+                                     StreamingStatistics> >
+                                                    StreamingRiskStatistics;
+
+
+    // inline definitions
+
+    inline Size StreamingStatistics::samples() const {
+        return sampleNumber_;
+    }
+
+    inline Real StreamingStatistics::weightSum() const {
+        return sampleWeight_;
+    }
+
+    inline Real StreamingStatistics::compression() const {
+        return compression_;
+    }
+
+    inline Real StreamingStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real StreamingStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real StreamingStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real StreamingStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    /*! \pre weights must be positive or null */
+    inline void StreamingStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+        if (sampleNumber_ == 0) {
+            min_ = max_ = value;
+        } else {
+            min_ = std::min(value, min_);
+            max_ = std::max(value, max_);
+        }
+        ++sampleNumber_;
+        if (weight > 0.0) {
+            accumulate(weight, value, 0.0, 0.0, 0.0);
+            Centroid c = { value, weight, 1 };
+            buffer_.push_back(c);
+            if (buffer_.size() >= bufferSize_)
+                compress();
+        }
+    }
+
+    inline void StreamingStatistics::accumulate(Real w, Real mean,
+                                                Real m2, Real m3, Real m4) {
+        // pairwise update, see Pebay (2008)
+        Real wa = sampleWeight_, W = wa + w;
+        Real delta = mean - mean_;
+        Real d_W = delta/W, d2 = delta*d_W;
+        Real wawb = wa*w;
+
+        m4_ += m4 + d2*d_W*d_W*wawb*(wa*wa - wawb + w*w)
+            + 6.0*d_W*d_W*(wa*wa*m2 + w*w*m2_)
+            + 4.0*d_W*(wa*m3 - w*m3_);
+        m3_ += m3 + d2*d_W*wawb*(wa - w)
+            + 3.0*d_W*(wa*m2 - w*m2_);
+        m2_ += m2 + d2*wawb;
+        mean_ += d_W*w;
+        sampleWeight_ = W;
+    }
+
+}
+
+
+#endif
@@ -153,6 +153,43 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void Fdm2dBlackScholesOp::apply_into(const Array& x, Array& y) const {
+        opX_.apply_into(x, y);
+        opY_.apply_into(x, work_);
+        y += work_;
+        apply_mixed_into(x, work_);
+        y += work_;
+    }
+
+    void Fdm2dBlackScholesOp::apply_mixed_into(const Array& x,
+                                               Array& y) const {
+        corrMapT_.apply_into(x, y);
+        for (Size i=0; i < y.size(); ++i)
+            y[i] += currentForwardRate_*x[i];
+    }
+
+    void Fdm2dBlackScholesOp::apply_direction_into(Size direction,
+                                                   const Array& x,
+                                                   Array& y) const {
+        if (direction == 0)
+            opX_.apply_into(x, y);
+        else if (direction == 1)
+            opY_.apply_into(x, y);
+        else
+            QL_FAIL("direction is too large");
+    }
+
+    void Fdm2dBlackScholesOp::solve_splitting_into(Size direction,
+                                                   const Array& x, Real s,
+                                                   Array& y) const {
+        if (direction == 0)
+            opX_.solve_splitting_into(direction, x, s, y);
+        else if (direction == 1)
+            opY_.solve_splitting_into(direction, x, s, y);
+        else
+            QL_FAIL("direction is too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     Fdm2dBlackScholesOp::toMatrixDecomp() const {
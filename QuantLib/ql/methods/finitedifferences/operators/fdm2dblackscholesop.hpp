@@ -54,6 +54,13 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(Size direction,
                                           const Array& x, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+        void apply_into(const Array& r, Array& y) const;
+        void apply_mixed_into(const Array& r, Array& y) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& y) const;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s, Array& x) const;
     
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
@@ -69,6 +76,9 @@ namespace QuantLib {
         NinePointLinearOp corrMapT_;
         const NinePointLinearOp corrMapTemplate_;
         const Real illegalLocalVolOverwrite_;
+
+        // work array for the in-place methods
+        mutable Array work_;
     };
 }
 #endif
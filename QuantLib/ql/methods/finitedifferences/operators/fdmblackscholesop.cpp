@@ -47,7 +47,8 @@ namespace QuantLib {
       mapT_  (direction, mesher),
       strike_(strike),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
-      direction_(direction) {
+      direction_(direction),
+      r_(Null<Real>()), q_(Null<Real>()), v_(Null<Real>()) {
     }
 
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
@@ -83,9 +84,19 @@ namespace QuantLib {
         else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
-            mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
-                        dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
-                        Array(1, -r));
+
+            // the map is only rebuilt if the parameters have changed;
+            // this keeps the factorization cached by the map for
+            // time-homogeneous processes.  The parameters are compared
+            // exactly, so that the map is the same as it would be if it
+            // were rebuilt.
+            if (r != r_ || q != q_ || v != v_) {
+                r_ = r; q_ = q; v_ = v;
+                mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
+                            dxxMap_.mult(
+                                0.5*Array(mesher_->layout()->size(), v)),
+                            Array(1, -r));
+            }
         }
     }
 
@@ -127,6 +138,41 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply_into(const Array& r, Array& y) const {
+        mapT_.apply_into(r, y);
+    }
+
+    void FdmBlackScholesOp::apply_direction_into(Size direction,
+                                                 const Array& r,
+                                                 Array& y) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, y);
+        else {
+            if (y.size() != r.size())
+                Array(r.size()).swap(y);
+            std::fill(y.begin(), y.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesOp::apply_mixed_into(const Array& r,
+                                             Array& y) const {
+        if (y.size() != r.size())
+            Array(r.size()).swap(y);
+        std::fill(y.begin(), y.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::solve_splitting_into(Size direction,
+                                                 const Array& r, Real dt,
+                                                 Array& x) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, dt, 1.0, x);
+        else {
+            if (x.size() != r.size())
+                Array(r.size()).swap(x);
+            std::copy(r.begin(), r.end(), x.begin());
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmBlackScholesOp::toMatrixDecomp() const {
@@ -55,6 +55,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& y) const;
+        void apply_mixed_into(const Array& r, Array& y) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& y) const;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s, Array& x) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -70,6 +77,8 @@ namespace QuantLib {
         const Real strike_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
+        // parameters of the current map for constant volatility
+        Real r_, q_, v_;
     };
 }
 
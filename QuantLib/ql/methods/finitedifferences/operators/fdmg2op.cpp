@@ -113,6 +113,42 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
+    void FdmG2Op::apply_into(const Array& r, Array& y) const {
+        mapX_.apply_into(r, y);
+        mapY_.apply_add(r, y);
+        corrMap_.apply_add(r, y);
+    }
+
+    void FdmG2Op::apply_mixed_into(const Array& r, Array& y) const {
+        corrMap_.apply_into(r, y);
+    }
+
+    void FdmG2Op::apply_direction_into(Size direction,
+                                       const Array& r, Array& y) const {
+        if (direction == direction1_)
+            mapX_.apply_into(r, y);
+        else if (direction == direction2_)
+            mapY_.apply_into(r, y);
+        else {
+            if (y.size() != r.size())
+                Array(r.size()).swap(y);
+            std::fill(y.begin(), y.end(), 0.0);
+        }
+    }
+
+    void FdmG2Op::solve_splitting_into(Size direction, const Array& r,
+                                       Real a, Array& x) const {
+        if (direction == direction1_)
+            mapX_.solve_splitting_into(r, a, 1.0, x);
+        else if (direction == direction2_)
+            mapY_.solve_splitting_into(r, a, 1.0, x);
+        else {
+            if (x.size() != r.size())
+                Array(r.size()).swap(x);
+            std::fill(x.begin(), x.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> > FdmG2Op::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
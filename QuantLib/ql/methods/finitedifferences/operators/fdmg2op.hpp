@@ -51,6 +51,13 @@ namespace QuantLib {
             solve_splitting(Size direction, const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& y) const;
+        void apply_mixed_into(const Array& r, Array& y) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& y) const;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s, Array& x) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
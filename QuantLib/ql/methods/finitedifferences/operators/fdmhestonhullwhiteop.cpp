@@ -156,6 +156,47 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonHullWhiteOp::apply_into(const Array& u, Array& y) const {
+        dyMap_.apply_into(u, y);
+        dxMap_.getMap().apply_add(u, y);
+        hullWhiteOp_.apply_into(u, work_);
+        y += work_;
+        hestonCorrMap_.apply_add(u, y);
+        equityIrCorrMap_.apply_add(u, y);
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed_into(const Array& r,
+                                                Array& y) const {
+        hestonCorrMap_.apply_into(r, y);
+        equityIrCorrMap_.apply_add(r, y);
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction_into(Size direction,
+                                                    const Array& r,
+                                                    Array& y) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, y);
+        else if (direction == 1)
+            dyMap_.apply_into(r, y);
+        else if (direction == 2)
+            hullWhiteOp_.apply_into(r, y);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting_into(Size direction,
+                                                    const Array& r, Real a,
+                                                    Array& x) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, a, 1.0, x);
+        else if (direction == 1)
+            dyMap_.solve_splitting_into(r, a, 1.0, x);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting_into(2, r, a, x);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonHullWhiteOp::toMatrixDecomp() const {
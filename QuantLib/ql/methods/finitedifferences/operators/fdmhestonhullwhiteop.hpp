@@ -80,6 +80,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& y) const;
+        void apply_mixed_into(const Array& r, Array& y) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& y) const;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s, Array& x) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -92,6 +99,9 @@ namespace QuantLib {
         TripleBandLinearOp dyMap_;
         FdmHestonHullWhiteEquityPart dxMap_;
         FdmHullWhiteOp hullWhiteOp_;
+
+        // work array for the in-place methods
+        mutable Array work_;
     };
 }
 
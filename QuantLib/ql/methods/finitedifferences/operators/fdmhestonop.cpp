@@ -36,6 +36,9 @@ namespace QuantLib {
       dxMap_ (FirstDerivativeOp(0, mesher)),
       dxxMap_(SecondDerivativeOp(0, mesher).mult(0.5*mesher->locations(1))),
       mapT_  (0, mesher),
+      drift_(varianceValues_.size()),
+      discount_(1),
+      r_(Null<Rate>()), q_(Null<Rate>()),
       mesher_(mesher),
       rTS_(rTS),
       qTS_(qTS),
@@ -60,15 +63,23 @@ namespace QuantLib {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
-        if (quantoHelper_) {
-            mapT_.axpyb(r - q - varianceValues_
-                - quantoHelper_->quantoAdjustment(
-                volatilityValues_, t1, t2),
-                dxMap_, dxxMap_, Array(1, -0.5*r));
-        }
-        else {
-            mapT_.axpyb(r - q - varianceValues_, dxMap_, dxxMap_, Array(1, -0.5*r));
-        }
+        // without quanto adjustment the map only depends on r and q; it
+        // is kept if they are exactly the same, together with the
+        // factorization that it caches.
+        if (!quantoHelper_ && r == r_ && q == q_)
+            return;
+        r_ = r; q_ = q;
+
+        // drift and discount are kept in members so that no temporary
+        // arrays are allocated at each time step
+        for (Size i=0; i < drift_.size(); ++i)
+            drift_[i] = r - q - varianceValues_[i];
+        if (quantoHelper_)
+            drift_ -= quantoHelper_->quantoAdjustment(volatilityValues_,
+                                                      t1, t2);
+        discount_[0] = -0.5*r;
+
+        mapT_.axpyb(drift_, dxMap_, dxxMap_, discount_);
     }
 
     const TripleBandLinearOp& FdmHestonEquityPart::getMap() const {
@@ -84,12 +95,19 @@ namespace QuantLib {
              .add(FirstDerivativeOp(1, mesher)
                   .mult(kappa*(theta - mesher->locations(1))))),
       mapT_(1, mesher),
+      discount_(1),
+      r_(Null<Rate>()),
       rTS_(rTS) {
     }
 
     void FdmHestonVariancePart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
-        mapT_.axpyb(Array(), dyMap_, dyMap_, Array(1,-0.5*r));
+        if (r == r_)
+            return;
+        r_ = r;
+
+        discount_[0] = -0.5*r;
+        mapT_.axpyb(Array(), dyMap_, dyMap_, discount_);
     }
 
     const TripleBandLinearOp& FdmHestonVariancePart::getMap() const {
@@ -162,6 +180,36 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply_into(const Array& r, Array& y) const {
+        dyMap_.getMap().apply_into(r, y);
+        dxMap_.getMap().apply_add(r, y);
+        correlationMap_.apply_add(r, y);
+    }
+
+    void FdmHestonOp::apply_mixed_into(const Array& r, Array& y) const {
+        correlationMap_.apply_into(r, y);
+    }
+
+    void FdmHestonOp::apply_direction_into(Size direction,
+                                           const Array& r, Array& y) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, y);
+        else if (direction == 1)
+            dyMap_.getMap().apply_into(r, y);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting_into(Size direction, const Array& r,
+                                           Real a, Array& x) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, a, 1.0, x);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting_into(r, a, 1.0, x);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonOp::toMatrixDecomp() const {
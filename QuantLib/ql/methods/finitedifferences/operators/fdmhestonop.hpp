@@ -51,6 +51,8 @@ namespace QuantLib {
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
+        Array drift_, discount_;
+        Rate r_, q_;
 
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
@@ -70,6 +72,8 @@ namespace QuantLib {
       protected:
         const TripleBandLinearOp dyMap_;
         TripleBandLinearOp mapT_;
+        Array discount_;
+        Rate r_;
 
         const boost::shared_ptr<YieldTermStructure> rTS_;
     };
@@ -95,6 +99,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& y) const;
+        void apply_mixed_into(const Array& r, Array& y) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& y) const;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s, Array& x) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -94,6 +94,34 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply_into(const Array& r, Array& y) const {
+        mapT_.apply_into(r, y);
+    }
+
+    void FdmHullWhiteOp::apply_mixed_into(const Array& r, Array& y) const {
+        if (y.size() != r.size())
+            Array(r.size()).swap(y);
+        std::fill(y.begin(), y.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction_into(Size direction,
+                                              const Array& r,
+                                              Array& y) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, y);
+        else
+            apply_mixed_into(r, y);
+    }
+
+    void FdmHullWhiteOp::solve_splitting_into(Size direction,
+                                              const Array& r, Real a,
+                                              Array& x) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, a, 1.0, x);
+        else
+            apply_mixed_into(r, x);
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHullWhiteOp::toMatrixDecomp() const {
@@ -51,6 +51,33 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place versions
+            The results are written into the given array, which is
+            resized if needed and must not be the input array. The
+            default implementations call the methods above; operators
+            should override them so that no temporary is allocated.
+            The Black-Scholes, 2D Black-Scholes, Heston, Hull-White,
+            G2 and Heston-Hull-White operators do; the others, e.g.
+            FdmBatesOp and the experimental operators, still use the
+            default implementations.
+        */
+        //@{
+        virtual void apply_into(const Array& r, Array& y) const {
+            y = apply(r);
+        }
+        virtual void apply_mixed_into(const Array& r, Array& y) const {
+            y = apply_mixed(r);
+        }
+        virtual void apply_direction_into(Size direction,
+                                          const Array& r, Array& y) const {
+            y = apply_direction(direction, r);
+        }
+        virtual void solve_splitting_into(Size direction, const Array& r,
+                                          Real s, Array& x) const {
+            x = solve_splitting(direction, r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
@@ -25,6 +25,15 @@
 
 namespace QuantLib {
 
+    namespace {
+        struct assign_result {
+            static void apply(Real& y, Real s) { y = s; }
+        };
+        struct add_result {
+            static void apply(Real& y, Real s) { y += s; }
+        };
+    }
+
     NinePointLinearOp::NinePointLinearOp(
         Size d0, Size d1,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -130,12 +139,31 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
 
-        const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
-        QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
-                    << u.size() << " vs " << index->size());
+    void NinePointLinearOp::apply_into(const Array& u, Array& y) const {
+        QL_REQUIRE(&u != &y, "input and output arrays must be different");
+        if (y.size() != u.size())
+            Array(u.size()).swap(y);
+        apply_impl<assign_result>(u, y);
+    }
+
+    void NinePointLinearOp::apply_add(const Array& u, Array& y) const {
+        QL_REQUIRE(&u != &y, "input and output arrays must be different");
+        QL_REQUIRE(y.size() == u.size(), "inconsistent length of y");
+        apply_impl<add_result>(u, y);
+    }
+
+    template <class Update>
+    void NinePointLinearOp::apply_impl(const Array& r, Array& y) const {
+
+        const boost::shared_ptr<FdmLinearOpLayout>& index=mesher_->layout();
+        QL_REQUIRE(r.size() == index->size(),"inconsistent length of r "
+                    << r.size() << " vs " << index->size());
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -143,20 +171,60 @@ namespace QuantLib {
         const Size *i00(i00_.get()), *i01(i01_.get()), *i02(i02_.get());
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
+        const Real* u = r.begin();
+        Real* yptr = y.begin();
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00[i]*u[i00[i]]
-                        + a01[i]*u[i01[i]]
-                        + a02[i]*u[i02[i]]
-                        + a10[i]*u[i10[i]]
-                        + a11[i]*u[i]
-                        + a12[i]*u[i12[i]]
-                        + a20[i]*u[i20[i]]
-                        + a21[i]*u[i21[i]]
-                        + a22[i]*u[i22[i]];
+        const Size s0 = index->spacing()[d0_], s1 = index->spacing()[d1_];
+
+        // the grid is traversed in blocks along the direction with the
+        // smaller stride; the other direction is constant in a block.
+        const Size inner = (s0 < s1) ? d0_ : d1_;
+        const Size outer = (s0 < s1) ? d1_ : d0_;
+        const Size sInner = index->spacing()[inner];
+        const Size nInner = index->dim()[inner];
+        const Size sOuter = index->spacing()[outer];
+        const Size nOuter = index->dim()[outer];
+        const Size blockSize = nInner*sInner;
+
+        for (Size base=0; base < index->size(); base+=blockSize) {
+            const Size c = (base/sOuter) % nOuter;
+            const bool interior = (nInner > 2 && c > 0 && c < nOuter-1);
+
+            // nodes on the boundary use mirrored neighbours;
+            // we go through the index arrays
+            const Size end = base + blockSize;
+            const Size from = interior ? base + sInner : end;
+            for (Size i=base; i < end; ++i) {
+                if (i == from)
+                    i = end - sInner;
+                Update::apply(yptr[i],  a00[i]*u[i00[i]]
+                                      + a01[i]*u[i01[i]]
+                                      + a02[i]*u[i02[i]]
+                                      + a10[i]*u[i10[i]]
+                                      + a11[i]*u[i]
+                                      + a12[i]*u[i12[i]]
+                                      + a20[i]*u[i20[i]]
+                                      + a21[i]*u[i21[i]]
+                                      + a22[i]*u[i22[i]]);
+            }
+
+            if (interior) {
+                // neighbours of interior nodes are at fixed distances,
+                // so that the compiler can vectorize the loop
+                const Size to = end - sInner;
+                #pragma omp simd
+                for (Size i=from; i < to; ++i)
+                    Update::apply(yptr[i],  a00[i]*u[i-s0-s1]
+                                          + a01[i]*u[i-s0]
+                                          + a02[i]*u[i-s0+s1]
+                                          + a10[i]*u[i-s1]
+                                          + a11[i]*u[i]
+                                          + a12[i]*u[i+s1]
+                                          + a20[i]*u[i+s0-s1]
+                                          + a21[i]*u[i+s0]
+                                          + a22[i]*u[i+s0+s1]);
+            }
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
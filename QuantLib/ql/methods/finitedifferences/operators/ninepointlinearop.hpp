@@ -44,6 +44,10 @@ namespace QuantLib {
         NinePointLinearOp& operator=(const Disposable<NinePointLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        //! writes the result of apply into y, which must not be r
+        void apply_into(const Array& r, Array& y) const;
+        //! adds the result of apply to y, which must not be r
+        void apply_add(const Array& r, Array& y) const;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
@@ -54,6 +58,8 @@ namespace QuantLib {
 
       protected:
         NinePointLinearOp() {}
+        template <class Update>
+        void apply_impl(const Array& r, Array& y) const;
 
         Size d0_, d1_;
         boost::shared_array<Size> i00_, i10_, i20_;
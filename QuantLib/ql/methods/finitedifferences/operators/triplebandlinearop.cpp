@@ -23,40 +23,46 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace {
+        struct assign_result {
+            static void apply(Real& y, Real s) { y = s; }
+        };
+        struct add_result {
+            static void apply(Real& y, Real s) { y += s; }
+        };
+
+        // replaces y with the given value and tells whether it changed
+        inline bool replace(Real& y, Real value) {
+            const bool changed = (y != value);
+            y = value;
+            return changed;
+        }
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
       i0_       (new Size[mesher->layout()->size()]),
       i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
+      factorized_(false),
       mesher_(mesher) {
 
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
         const FdmLinearOpIterator endIter = layout->end();
 
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
         for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
             const Size i = iter.index();
 
             i0_[i] = layout->neighbourhood(iter, direction, -1);
             i2_[i] = layout->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
         }
     }
 
@@ -64,16 +70,14 @@ namespace QuantLib {
     : direction_(m.direction_),
       i0_   (new Size[m.mesher_->layout()->size()]),
       i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
+      factorized_(false),
       mesher_(m.mesher_) {
         const Size len = m.mesher_->layout()->size();
         std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
         std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -81,7 +85,8 @@ namespace QuantLib {
 
 
     TripleBandLinearOp::TripleBandLinearOp(
-        const Disposable<TripleBandLinearOp>& from) {
+        const Disposable<TripleBandLinearOp>& from)
+    : factorized_(false) {
         swap(const_cast<Disposable<TripleBandLinearOp>&>(from));
     }
 
@@ -103,8 +108,11 @@ namespace QuantLib {
         std::swap(direction_, m.direction_);
 
         i0_.swap(m.i0_); i2_.swap(m.i2_);
-        reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
+        tmp_.swap(m.tmp_); bet_.swap(m.bet_);
+        std::swap(factorized_, m.factorized_);
+        std::swap(factorA_, m.factorA_);
+        std::swap(factorB_, m.factorB_);
     }
 
     void TripleBandLinearOp::axpyb(const Array& a,
@@ -121,13 +129,18 @@ namespace QuantLib {
         const Real *y_lower(y.lower_.get());
         const Real *y_upper(y.upper_.get());
 
+        // keeps track of changes in the coefficients; operators that
+        // are rebuilt with the same values at each time step keep
+        // their cached factorization.
+        bool changed = false;
+
         if (a.empty()) {
             if (b.empty()) {
                 //#pragma omp parallel for
                 for (Size i=0; i < size; ++i) {
-                    diag[i]  = y_diag[i];
-                    lower[i] = y_lower[i];
-                    upper[i] = y_upper[i];
+                    changed |= replace(diag[i],  y_diag[i]);
+                    changed |= replace(lower[i], y_lower[i]);
+                    changed |= replace(upper[i], y_upper[i]);
                 }
             }
             else {
@@ -135,9 +148,9 @@ namespace QuantLib {
                 const Size binc = (b.size() > 1) ? 1 : 0;
                 //#pragma omp parallel for
                 for (Size i=0; i < size; ++i) {
-                    diag[i]  = y_diag[i] + bptr[i*binc];
-                    lower[i] = y_lower[i];
-                    upper[i] = y_upper[i];
+                    changed |= replace(diag[i],  y_diag[i] + bptr[i*binc]);
+                    changed |= replace(lower[i], y_lower[i]);
+                    changed |= replace(upper[i], y_upper[i]);
                 }
             }
         }
@@ -152,9 +165,9 @@ namespace QuantLib {
             //#pragma omp parallel for
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
-                diag[i]  = y_diag[i]  + s*x_diag[i];
-                lower[i] = y_lower[i] + s*x_lower[i];
-                upper[i] = y_upper[i] + s*x_upper[i];
+                changed |= replace(diag[i],  y_diag[i]  + s*x_diag[i]);
+                changed |= replace(lower[i], y_lower[i] + s*x_lower[i]);
+                changed |= replace(upper[i], y_upper[i] + s*x_upper[i]);
             }
         }
         else {
@@ -171,11 +184,15 @@ namespace QuantLib {
             //#pragma omp parallel for
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
-                diag[i]  = y_diag[i]  + s*x_diag[i] + bptr[i*binc];
-                lower[i] = y_lower[i] + s*x_lower[i];
-                upper[i] = y_upper[i] + s*x_upper[i];
+                changed |= replace(diag[i],
+                                  y_diag[i]  + s*x_diag[i] + bptr[i*binc]);
+                changed |= replace(lower[i], y_lower[i] + s*x_lower[i]);
+                changed |= replace(upper[i], y_upper[i] + s*x_upper[i]);
             }
         }
+
+        if (changed)
+            factorized_ = false;
     }
 
     Disposable<TripleBandLinearOp>
@@ -226,8 +243,27 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
-        const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
+        Array retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array& r, Array& y) const {
+        QL_REQUIRE(&r != &y, "input and output arrays must be different");
+        if (y.size() != r.size())
+            Array(r.size()).swap(y);
+        apply_impl<assign_result>(r, y);
+    }
+
+    void TripleBandLinearOp::apply_add(const Array& r, Array& y) const {
+        QL_REQUIRE(y.size() == r.size(), "inconsistent length of y");
+        QL_REQUIRE(&r != &y, "input and output arrays must be different");
+        apply_impl<add_result>(r, y);
+    }
 
+    template <class Update>
+    void TripleBandLinearOp::apply_impl(const Array& r, Array& y) const {
+        const boost::shared_ptr<FdmLinearOpLayout>& index = mesher_->layout();
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
 
         const Real* lptr = lower_.get();
@@ -235,14 +271,41 @@ namespace QuantLib {
         const Real* uptr = upper_.get();
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
-
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        const Real* rptr = r.begin();
+        Real* yptr = y.begin();
+
+        const Size n = index->dim()[direction_];
+        const Size stride = index->spacing()[direction_];
+        const Size blockSize = n*stride;
+
+        if (n < 3) {
+            for (Size i=0; i < index->size(); ++i)
+                Update::apply(yptr[i], rptr[i0ptr[i]]*lptr[i]
+                                      +rptr[i]*dptr[i]
+                                      +rptr[i2ptr[i]]*uptr[i]);
+            return;
         }
 
-        return retVal;
+        for (Size base=0; base < index->size(); base+=blockSize) {
+            // the first and the last row along the direction use
+            // mirrored neighbours; we go through the index arrays
+            const Size first[] = { base, base + blockSize - stride };
+            for (Size k=0; k < 2; ++k) {
+                for (Size i=first[k]; i < first[k]+stride; ++i)
+                    Update::apply(yptr[i], rptr[i0ptr[i]]*lptr[i]
+                                          +rptr[i]*dptr[i]
+                                          +rptr[i2ptr[i]]*uptr[i]);
+            }
+
+            // interior nodes are contiguous and their neighbours are
+            // at a fixed distance, so that the compiler can vectorize
+            const Size end = base + blockSize - stride;
+            #pragma omp simd
+            for (Size i=base+stride; i < end; ++i)
+                Update::apply(yptr[i], rptr[i-stride]*lptr[i]
+                                      +rptr[i]*dptr[i]
+                                      +rptr[i+stride]*uptr[i]);
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -264,8 +327,17 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
-        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        Array retVal(r.size());
+        solve_splitting_into(r, a, b, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting_into(const Array& r,
+                                                  Real a, Real b,
+                                                  Array& x) const {
+        const boost::shared_ptr<FdmLinearOpLayout>& layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(&r != &x, "input and output arrays must be different");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -278,36 +350,108 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        // The system decouples into one tridiagonal system for each
+        // line of the grid along direction_. Adjacent lines are solved
+        // together in tiles, so that each step of the Thomas algorithm
+        // reads a contiguous chunk of memory for any direction; tiles
+        // are independent and are solved in parallel.
+        const Size maxTileSize = 64;
+        const Size n = layout->dim()[direction_];
+        const Size stride = layout->spacing()[direction_];
+        const Size tileSize = std::min(stride, maxTileSize);
+        const Size tilesPerBlock = (stride + tileSize - 1)/tileSize;
+        const Size nTiles = (layout->size()/(n*stride))*tilesPerBlock;
+
+        if (x.size() != r.size())
+            Array(r.size()).swap(x);
+
+        // the factorization can be reused if neither the coefficients
+        // nor a and b have changed since it was calculated
+        const bool reuse = factorized_ && a == factorA_ && b == factorB_;
+        if (!reuse) {
+            factorized_ = false;
+            if (tmp_.size() != r.size()) {
+                Array(r.size()).swap(tmp_);
+                Array(r.size()).swap(bet_);
+            }
+        }
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        const Real* rptr = r.begin();
+        Real* xptr = x.begin();
+        Real* tmp = tmp_.begin();
+        Real* bet = bet_.begin();
+
+        Size singular = 0;
+
+        #pragma omp parallel for reduction(+:singular) if(nTiles > 1)
+        for (Size t=0; t < nTiles; ++t) {
+            const Size offset = (t%tilesPerBlock)*tileSize;
+            const Size base = (t/tilesPerBlock)*n*stride + offset;
+            const Size m = std::min(tileSize, stride - offset);
+
+            if (reuse) {
+                // forward substitution with the cached factorization
+                for (Size k=0; k < m; ++k)
+                    xptr[base+k] = rptr[base+k]*bet[base+k];
+
+                for (Size j=1; j < n; ++j) {
+                    const Size row = base + j*stride;
+                    for (Size k=0; k < m; ++k) {
+                        const Size i = row + k;
+                        xptr[i] = (rptr[i]-a*lptr[i]*xptr[i-stride])*bet[i];
+                    }
+                }
+            }
+            else {
+                // Thomson algorithm to solve a tridiagonal system.
+                // Example code taken from Tridiagonalopertor and
+                // changed to fit for the triple band operator.
+                for (Size k=0; k < m; ++k) {
+                    const Size i = base + k;
+                    const Real denom = a*dptr[i]+b;
+                    if (denom == 0.0) {
+                        ++singular;
+                        bet[i] = 0.0;
+                    }
+                    else
+                        bet[i] = 1.0/denom;
+                    xptr[i] = rptr[i]*bet[i];
+                }
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                for (Size j=1; j < n; ++j) {
+                    const Size row = base + j*stride;
+                    for (Size k=0; k < m; ++k) {
+                        const Size i = row + k;
+                        tmp[i] = a*uptr[i-stride]*bet[i-stride];
+
+                        const Real denom = b+a*(dptr[i]-tmp[i]*lptr[i]);
+                        if (denom == 0.0) {
+                            ++singular;
+                            bet[i] = 0.0;
+                        }
+                        else
+                            bet[i] = 1.0/denom;
+
+                        xptr[i] = (rptr[i]-a*lptr[i]*xptr[i-stride])*bet[i];
+                    }
+                }
+            }
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+            for (Size j=n-1; j > 0; --j) {
+                const Size row = base + (j-1)*stride;
+                for (Size k=0; k < m; ++k)
+                    xptr[row+k] -= tmp[row+stride+k]*xptr[row+stride+k];
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(singular == 0, "division by zero");
 
-        return retVal;
+        if (!reuse) {
+            factorized_ = true;
+            factorA_ = a;
+            factorB_ = b;
+        }
     }
 }
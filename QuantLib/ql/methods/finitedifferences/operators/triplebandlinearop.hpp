@@ -47,6 +47,28 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
 
+        //! \name In-place versions
+        //@{
+        //! writes the result of apply into y, which must not be r
+        void apply_into(const Array& r, Array& y) const;
+        //! adds the result of apply to y, which must not be r
+        void apply_add(const Array& r, Array& y) const;
+        /*! writes the result of solve_splitting into x, which must
+            not be r.
+
+            The factorization of \f$ a A + b I \f$ is kept and reused
+            by later calls with the same \f$ a \f$ and \f$ b \f$ until
+            the coefficients change, so that time-independent operators
+            only pay for the substitution at each step.
+
+            \warning the factorization is stored in the operator; the
+                     same operator can't be used by several threads
+                     at once.
+        */
+        void solve_splitting_into(const Array& r, Real a, Real b,
+                                  Array& x) const;
+        //@}
+
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         Disposable<TripleBandLinearOp> add(const TripleBandLinearOp& m) const;
         Disposable<TripleBandLinearOp> add(const Array& u) const;
@@ -62,13 +84,20 @@ namespace QuantLib {
 #endif
 
       protected:
-        TripleBandLinearOp() {}
+        template <class Update>
+        void apply_impl(const Array& r, Array& y) const;
+
+        TripleBandLinearOp() : factorized_(false) {}
 
         Size direction_;
         boost::shared_array<Size> i0_, i2_;
-        boost::shared_array<Size> reverseIndex_;
         boost::shared_array<Real> lower_, diag_, upper_;
 
+        // cached factorization used by solve_splitting_into
+        mutable Array tmp_, bet_;
+        mutable bool factorized_;
+        mutable Real factorA_, factorB_;
+
         boost::shared_ptr<FdmMesher> mesher_;
     };
 }
@@ -37,17 +37,26 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        if (y_.size() != n)
+            Array(n).swap(y_);
+        const Real s = theta_*dt_;
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply_into(a, tmp_);
+        for (Size j=0; j < n; ++j)
+            y_[j] = a[j] + dt_*tmp_[j];
+        bcSet_.applyAfterApplying(y_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, tmp_);
+            for (Size j=0; j < n; ++j)
+                tmp_[j] = y_[j] - s*tmp_[j];
+            map_->solve_splitting_into(i, tmp_, -s, y_);
         }
-        bcSet_.applyAfterSolving(y);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        a.swap(y_);
     }
 
     void DouglasScheme::setStep(Time dt) {
@@ -54,6 +54,8 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace, kept to avoid allocations at each step
+        Array y_, tmp_;
     };
 }
 
@@ -53,6 +53,8 @@ namespace QuantLib {
         Time dt_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace, kept to avoid allocations at each step
+        Array tmp_;
     };
 }
 
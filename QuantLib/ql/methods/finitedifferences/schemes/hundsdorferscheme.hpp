@@ -59,6 +59,8 @@ namespace QuantLib {
 
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace, kept to avoid allocations at each step
+        Array y_, y0_, rhs_, tmp_;
     };
 }
 
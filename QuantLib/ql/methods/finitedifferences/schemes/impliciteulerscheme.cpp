@@ -19,6 +19,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
@@ -36,15 +37,21 @@ namespace QuantLib {
     ImplicitEulerScheme::ImplicitEulerScheme(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const bc_set& bcSet,
-        Real relTol)
+        Real relTol,
+        SolverType solverType)
     : dt_    (Null<Real>()),
       relTol_(relTol),
       map_   (map),
-      bcSet_ (bcSet) {
+      bcSet_ (bcSet),
+      solverType_(solverType) {
     }
 
     Disposable<Array> ImplicitEulerScheme::apply(const Array& r) const {
-        return r - dt_*map_->apply(r);
+        map_->apply_into(r, work_);
+        Array y(r.size());
+        for (Size i=0; i < r.size(); ++i)
+            y[i] = r[i] - dt_*work_[i];
+        return y;
     }
 
     void ImplicitEulerScheme::step(array_type& a, Time t) {
@@ -54,15 +61,26 @@ namespace QuantLib {
 
         bcSet_.applyBeforeSolving(*map_, a);
 
-        a = BiCGstab(
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&ImplicitEulerScheme::apply, this, _1)), 
-                10*a.size(), relTol_,
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&FdmLinearOpComposite::preconditioner, 
-                                map_, _1, -dt_))
-            ).solve(a).x;
-        
+        const boost::function<Disposable<Array>(const Array&)>
+            applyF(boost::bind(&ImplicitEulerScheme::apply, this, _1));
+        const boost::function<Disposable<Array>(const Array&)>
+            preconditioner(boost::bind(&FdmLinearOpComposite::preconditioner,
+                                       map_, _1, -dt_));
+
+        if (solverType_ == BiCGstabSolver) {
+            a = BiCGstab(applyF, 10*a.size(), relTol_,
+                         preconditioner).solve(a).x;
+        }
+        else if (solverType_ == GMRESSolver) {
+            // the previous time level is a good starting point; the
+            // restarts keep the memory for the Krylov basis bounded
+            const Size krylovDim = std::min(Size(30), a.size());
+            a = GMRES(applyF, krylovDim, relTol_, preconditioner)
+                    .solveWithRestart(10*a.size()/krylovDim + 1, a, a).x;
+        }
+        else
+            QL_FAIL("unknown/illegal solver type");
+
         bcSet_.applyAfterSolving(a);
     }
 
@@ -32,8 +32,23 @@
 
 namespace QuantLib {
 
+    //! implicit Euler scheme
+    /*! The linear system of each step is solved iteratively; the
+        split operator given by FdmLinearOpComposite::preconditioner
+        is used as preconditioner. GMRES is usually the more robust
+        choice for the non-symmetric systems of forward (Fokker-Planck)
+        operators.
+
+        Unlike the splitting schemes, this scheme is not free of
+        allocations: the iterative solvers work on functions returning
+        new arrays, so each of their iterations allocates its result.
+        The operator is applied in place into a work array, so that
+        this is the only array allocated by the scheme itself.
+    */
     class ImplicitEulerScheme {
       public:
+        enum SolverType { BiCGstabSolver, GMRESSolver };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -45,7 +60,8 @@ namespace QuantLib {
         ImplicitEulerScheme(
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set(),
-            Real relTol = 1e-8);
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstabSolver);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -57,6 +73,8 @@ namespace QuantLib {
         const Real relTol_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const SolverType solverType_;
+        mutable Array work_;
     };
 }
 
@@ -37,29 +37,51 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        if (y_.size() != n) {
+            Array(n).swap(y_);
+            Array(n).swap(y0_);
+            Array(n).swap(rhs_);
+        }
+        const Real s = theta_*dt_;
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply_into(a, tmp_);
+        for (Size j=0; j < n; ++j)
+            y_[j] = a[j] + dt_*tmp_[j];
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        std::copy(y_.begin(), y_.end(), y0_.begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, tmp_);
+            for (Size j=0; j < n; ++j)
+                tmp_[j] = y_[j] - s*tmp_[j];
+            map_->solve_splitting_into(i, tmp_, -s, y_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt =  y0 + mu_*dt_*map_->apply_mixed(y-a)
-                  +(0.5-mu_)*dt_*map_->apply(y-a);;
-        bcSet_.applyAfterApplying(yt);
+        for (Size j=0; j < n; ++j)
+            rhs_[j] = y_[j] - a[j];
+        const Real m1 = mu_*dt_;
+        const Real m2 = (0.5-mu_)*dt_;
+        map_->apply_mixed_into(rhs_, tmp_);
+        for (Size j=0; j < n; ++j)
+            y0_[j] = y0_[j] + m1*tmp_[j];
+        map_->apply_into(rhs_, tmp_);
+        for (Size j=0; j < n; ++j)
+            y0_[j] += m2*tmp_[j];
+        bcSet_.applyAfterApplying(y0_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, a);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, tmp_);
+            for (Size j=0; j < n; ++j)
+                tmp_[j] = y0_[j] - s*tmp_[j];
+            map_->solve_splitting_into(i, tmp_, -s, y0_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(y0_);
 
-        a = yt;
+        a.swap(y0_);
     }
 
     void ModifiedCraigSneydScheme::setStep(Time dt) {
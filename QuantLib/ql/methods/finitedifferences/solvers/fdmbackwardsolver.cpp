@@ -34,8 +34,23 @@
 
 namespace QuantLib {
     
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+    namespace {
+        ImplicitEulerScheme::SolverType implicitSolverType(
+                                        const FdmSchemeDesc& schemeDesc) {
+            switch (schemeDesc.solverType) {
+              case FdmSchemeDesc::BiCGstabSolver:
+                return ImplicitEulerScheme::BiCGstabSolver;
+              case FdmSchemeDesc::GMRESSolver:
+                return ImplicitEulerScheme::GMRESSolver;
+              default:
+                QL_FAIL("unknown solver type");
+            }
+        }
+    }
+
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 FdmSolverType aSolverType)
+    : type(aType), theta(aTheta), mu(aMu), solverType(aSolverType) { }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { 
         return FdmSchemeDesc(FdmSchemeDesc::DouglasType, 0.5, 0.0);
@@ -68,6 +83,11 @@ namespace QuantLib {
         return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0);
     }
 
+    FdmSchemeDesc FdmSchemeDesc::ImplicitEulerGMRES() {
+        return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0,
+                             FdmSchemeDesc::GMRESSolver);
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const FdmBoundaryConditionSet& bcSet,
@@ -92,7 +112,8 @@ namespace QuantLib {
                     
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
+            ImplicitEulerScheme implicitEvolver(
+                map_, bcSet_, 1e-8, implicitSolverType(schemeDesc_));
             FiniteDifferenceModel<ImplicitEulerScheme> 
                     dampingModel(implicitEvolver, condition_->stoppingTimes());
             dampingModel.rollback(rhs, from, dampingTo, 
@@ -138,7 +159,8 @@ namespace QuantLib {
             break;
           case FdmSchemeDesc::ImplicitEulerType:
             {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                ImplicitEulerScheme implicitEvolver(
+                    map_, bcSet_, 1e-8, implicitSolverType(schemeDesc_));
                 FiniteDifferenceModel<ImplicitEulerScheme> 
                    implicitModel(implicitEvolver, condition_->stoppingTimes());
                 implicitModel.rollback(rhs, from, to, allSteps, *condition_);
@@ -36,15 +36,20 @@ namespace QuantLib {
         enum FdmSchemeType { HundsdorferType, DouglasType, 
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType };
+        //! linear solver used by the implicit Euler (damping) steps
+        enum FdmSolverType { BiCGstabSolver, GMRESSolver };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      FdmSolverType solverType = BiCGstabSolver);
 
         const FdmSchemeType type;
         const Real theta, mu;
+        const FdmSolverType solverType;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas();
         static FdmSchemeDesc ImplicitEuler();
+        static FdmSchemeDesc ImplicitEulerGMRES();
         static FdmSchemeDesc ExplicitEuler();
         static FdmSchemeDesc CraigSneyd();
         static FdmSchemeDesc ModifiedCraigSneyd(); 
@@ -70,6 +70,14 @@ namespace QuantLib {
         void initialize(DiscretizedAsset&, Time t) const;
         void rollback(DiscretizedAsset&, Time to) const;
         void partialRollback(DiscretizedAsset&, Time to) const;
+        using Lattice::rollback;
+        /*! All the assets are stepped back on a level before moving
+            to the next, so that the data of each level are reused
+            while they're still in cache.
+        */
+        void partialRollback(
+                const std::vector<boost::shared_ptr<DiscretizedAsset> >&,
+                Time to) const;
         //! Computes the present value of an asset using Arrow-Debrew prices
         Real presentValue(DiscretizedAsset&) const;
         //@}
@@ -152,17 +160,62 @@ namespace QuantLib {
         Integer iFrom = Integer(t_.index(from));
         Integer iTo = Integer(t_.index(to));
 
+        // the buffers are swapped at each step and only reallocated
+        // when the size of the level changes
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
+            Size size = this->impl().size(i);
+            if (newValues.size() != size)
+                Array(size).swap(newValues);
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
         }
     }
 
+    template <class Impl>
+    void TreeLattice<Impl>::partialRollback(
+              const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets,
+              Time to) const {
+
+        Integer iTo = Integer(t_.index(to));
+        Integer iFrom = iTo;
+        std::vector<Integer> indexes(assets.size(), iTo);
+        for (Size k=0; k<assets.size(); ++k) {
+            Time from = assets[k]->time();
+            if (close(from,to))
+                continue;
+            QL_REQUIRE(from > to,
+                       "cannot roll the asset back to" << to
+                       << " (it is already at t = " << from << ")");
+            indexes[k] = Integer(t_.index(from));
+            iFrom = std::max(iFrom, indexes[k]);
+        }
+
+        std::vector<Array> newValues(assets.size());
+        for (Integer i=iFrom-1; i>=iTo; --i) {
+            Size size = this->impl().size(i);
+            for (Size k=0; k<assets.size(); ++k) {
+                // assets starting at earlier times join the
+                // rollback when it reaches them
+                if (indexes[k] <= i)
+                    continue;
+                DiscretizedAsset& asset = *assets[k];
+                if (newValues[k].size() != size)
+                    Array(size).swap(newValues[k]);
+                this->impl().stepback(i, asset.values(), newValues[k]);
+                asset.time() = t_[i];
+                asset.values().swap(newValues[k]);
+                // skip the very last adjustment
+                if (i != iTo)
+                    asset.adjustValues();
+            }
+        }
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
@@ -10,10 +10,12 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/multipathblock.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/methods/montecarlo/nodedata.hpp>
 #include <ql/methods/montecarlo/parametricexercise.hpp>
 #include <ql/methods/montecarlo/path.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
@@ -109,5 +109,53 @@ namespace QuantLib {
         }
     }
 
+
+    void BrownianBridge::transform(const Matrix& input,
+                                   Matrix& output) const {
+        QL_REQUIRE(input.rows() == size_, "incompatible sequence size");
+        QL_REQUIRE(output.rows() == size_ &&
+                   output.columns() == input.columns(),
+                   "incompatible output size");
+        QL_REQUIRE(&input != &output, "in-place transform not supported");
+
+        const Size n = input.columns();
+        // We use output to store the paths...
+        Matrix::row_iterator out = output.row_begin(size_-1);
+        Matrix::const_row_iterator in = input.row_begin(0);
+        for (Size m=0; m<n; ++m)
+            out[m] = stdDev_[0] * in[m];
+        for (Size i=1; i<size_; ++i) {
+            Size j = leftIndex_[i];
+            Size k = rightIndex_[i];
+            Size l = bridgeIndex_[i];
+            const Real wl = leftWeight_[i], wr = rightWeight_[i],
+                       sd = stdDev_[i];
+            out = output.row_begin(l);
+            in = input.row_begin(i);
+            Matrix::const_row_iterator right = output.row_begin(k);
+            if (j != 0) {
+                Matrix::const_row_iterator left = output.row_begin(j-1);
+                for (Size m=0; m<n; ++m)
+                    out[m] = wl * left[m] + wr * right[m] + sd * in[m];
+            } else {
+                for (Size m=0; m<n; ++m)
+                    out[m] = wr * right[m] + sd * in[m];
+            }
+        }
+        // ...after which, we calculate the variations and
+        // normalize to unit times
+        for (Size i=size_-1; i>=1; --i) {
+            out = output.row_begin(i);
+            Matrix::const_row_iterator previous = output.row_begin(i-1);
+            for (Size m=0; m<n; ++m) {
+                out[m] -= previous[m];
+                out[m] /= sqrtdt_[i];
+            }
+        }
+        out = output.row_begin(0);
+        for (Size m=0; m<n; ++m)
+            out[m] /= sqrtdt_[0];
+    }
+
 }
 
@@ -38,6 +38,7 @@
 
 #include <ql/methods/montecarlo/path.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -135,6 +136,18 @@ namespace QuantLib {
             }
             output[0] /= sqrtdt_[0];
         }
+        //! Brownian-bridge generator function for a block of sequences
+        /*! Transforms each column of the input matrix as the method
+            above would do, and writes the result into the
+            corresponding column of the output matrix.  The
+            calculations are carried out one row at a time, so that
+            they can be vectorized across the sequences.
+
+            \pre input and output must be distinct matrices with the
+                 same dimensions and as many rows as the number of
+                 steps.
+        */
+        void transform(const Matrix& input, Matrix& output) const;
       private:
         void initialize();
         Size size_;
@@ -24,7 +24,7 @@
 #ifndef quantlib_early_exercise_path_pricer_hpp
 #define quantlib_early_exercise_path_pricer_hpp
 
-#include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/methods/montecarlo/path.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <boost/function.hpp>
@@ -73,6 +73,22 @@ namespace QuantLib {
             state(const PathType& path, TimeType t) const = 0;
         virtual std::vector<boost::function1<ValueType, StateType> >
             basisSystem() const = 0;
+
+        //! basis-system values at the given states, one row per state
+        /*! The default implementation evaluates basisSystem() one
+            state at a time; path pricers built on a standard basis
+            can override it with a batched evaluation.
+        */
+        virtual Disposable<Matrix>
+            basisValues(const std::vector<StateType>& states) const {
+            const std::vector<boost::function1<ValueType, StateType> > v
+                = basisSystem();
+            Matrix values(states.size(), v.size());
+            for (Size l=0; l<v.size(); ++l)
+                for (Size k=0; k<states.size(); ++k)
+                    values[k][l] = v[l](states[k]);
+            return values;
+        }
     };
 }
 
@@ -18,11 +18,40 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/math/statistics/statistics.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
+    namespace {
+
+        // rows accumulated by a single task; fixed, so that the order
+        // of the floating-point sums doesn't depend on the threads
+        const Size regressionBlockSize = 1024;
+
+        Size regressionBlocks(Size n) {
+            return (n + regressionBlockSize - 1)/regressionBlockSize;
+        }
+
+        // adds the lower triangle of the partial normal equations of
+        // every block, in block order, and fills the upper triangle
+        void mergeBlocks(const std::vector<Matrix>& blockC,
+                         const std::vector<Array>& blockB,
+                         Matrix& C, Array& b) {
+            const Size m = b.size();
+            for (Size i=0; i<blockC.size(); ++i) {
+                C += blockC[i];
+                b += blockB[i];
+            }
+            for (Size k=0; k<m; ++k)
+                for (Size l=0; l<k; ++l)
+                    C[l][k] = C[k][l];
+        }
+
+    }
+
     Real genericLongstaffSchwartzRegression(
                 std::vector<std::vector<NodeData> >& simulationData,
                 std::vector<std::vector<Real> >& basisCoefficients) {
@@ -34,45 +63,48 @@ namespace QuantLib {
 
             std::vector<NodeData>& exerciseData = simulationData[i];
 
-            // 1) find the covariance matrix of basis function values and
-            //    deflated cash-flows
-            Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
-
-            Size j;
-            for (j=0; j<exerciseData.size(); ++j) {
-                if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
-
-                    stats.add(temp);
+            // 1) accumulate the normal equations of the basis function
+            //    values and deflated cash-flows
+            const Size N = exerciseData.front().values.size();
+            const Size nBlocks = regressionBlocks(exerciseData.size());
+            std::vector<Matrix> blockC(nBlocks, Matrix(N, N, 0.0));
+            std::vector<Array> blockB(nBlocks, Array(N, 0.0));
+
+            #pragma omp parallel for
+            for (Size b=0; b<nBlocks; ++b) {
+                Matrix& C = blockC[b];
+                Array& target = blockB[b];
+                const Size end = std::min((b+1)*regressionBlockSize,
+                                          exerciseData.size());
+                for (Size j=b*regressionBlockSize; j<end; ++j) {
+                    const NodeData& data = exerciseData[j];
+                    if (data.isValid) {
+                        const Real y =
+                            data.cumulatedCashFlows - data.controlValue;
+                        for (Size k=0; k<N; ++k) {
+                            const Real xk = data.values[k];
+                            target[k] += xk*y;
+                            for (Size l=0; l<=k; ++l)
+                                C[k][l] += xk*data.values[l];
+                        }
+                    }
                 }
             }
 
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
-
-            Matrix C(N,N);
-            Array target(N);
-            for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
-                for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
-            }
+            Matrix C(N, N, 0.0);
+            Array target(N, 0.0);
+            mergeBlocks(blockC, blockB, C, target);
 
             // 2) solve for least squares regression
-            Array alphas = SVD(C).solveFor(target);
+            Array alphas = normalEquationsSolve(C, target);
             basisCoefficients[i-1].resize(N);
             std::copy(alphas.begin(), alphas.end(),
                       basisCoefficients[i-1].begin());
 
             // 3) use exercise strategy to divide paths into exercise and
             //    non-exercise domains
-            for (j=0; j<exerciseData.size(); ++j) {
+            #pragma omp parallel for
+            for (Size j=0; j<exerciseData.size(); ++j) {
                 if (exerciseData[j].isValid) {
                     Real exerciseValue = exerciseData[j].exerciseValue;
                     Real continuationValue =
@@ -107,5 +139,86 @@ namespace QuantLib {
         return estimate.mean();
     }
 
+
+    Disposable<Array> normalEquationsSolve(const Matrix& C, const Array& b) {
+        const Size m = b.size();
+        QL_REQUIRE(C.rows() == m && C.columns() == m,
+                   "normal equations matrix (" << C.rows() << "x"
+                   << C.columns() << ") doesn't match the target size ("
+                   << m << ")");
+
+        // the normal equations square the condition number, so a basis
+        // function is considered collinear with the previous ones as
+        // soon as it keeps less than sqrt(eps) of its squared norm
+        const Real relThreshold = std::sqrt(QL_EPSILON);
+
+        Matrix L(m, m, 0.0);
+        for (Size j=0; j<m; ++j) {
+            Real sum = C[j][j];
+            for (Size k=0; k<j; ++k)
+                sum -= L[j][k]*L[j][k];
+            if (sum <= relThreshold*C[j][j])
+                return SVD(C).solveFor(b);
+
+            L[j][j] = std::sqrt(sum);
+            for (Size i=j+1; i<m; ++i) {
+                Real s = C[i][j];
+                for (Size k=0; k<j; ++k)
+                    s -= L[i][k]*L[j][k];
+                L[i][j] = s/L[j][j];
+            }
+        }
+
+        // forward and backward substitution
+        Array a(m);
+        for (Size i=0; i<m; ++i) {
+            Real s = b[i];
+            for (Size k=0; k<i; ++k)
+                s -= L[i][k]*a[k];
+            a[i] = s/L[i][i];
+        }
+        for (Size i=m; i>0; --i) {
+            Real s = a[i-1];
+            for (Size k=i; k<m; ++k)
+                s -= L[k][i-1]*a[k];
+            a[i-1] = s/L[i-1][i-1];
+        }
+
+        return a;
+    }
+
+    Disposable<Array> leastSquaresRegression(const Matrix& A,
+                                             const Array& y) {
+        const Size n = A.rows(), m = A.columns();
+        QL_REQUIRE(y.size() == n,
+                   "design matrix rows (" << n << ") and sample size ("
+                   << y.size() << ") differ");
+
+        const Size nBlocks = regressionBlocks(n);
+        std::vector<Matrix> blockC(nBlocks, Matrix(m, m, 0.0));
+        std::vector<Array> blockB(nBlocks, Array(m, 0.0));
+
+        #pragma omp parallel for
+        for (Size b=0; b<nBlocks; ++b) {
+            Matrix& C = blockC[b];
+            Array& target = blockB[b];
+            const Size end = std::min((b+1)*regressionBlockSize, n);
+            for (Size j=b*regressionBlockSize; j<end; ++j) {
+                const Real* x = A.row_begin(j);
+                for (Size k=0; k<m; ++k) {
+                    target[k] += x[k]*y[j];
+                    for (Size l=0; l<=k; ++l)
+                        C[k][l] += x[k]*x[l];
+                }
+            }
+        }
+
+        Matrix C(m, m, 0.0);
+        Array target(m, 0.0);
+        mergeBlocks(blockC, blockB, C, target);
+
+        return normalEquationsSolve(C, target);
+    }
+
 }
 
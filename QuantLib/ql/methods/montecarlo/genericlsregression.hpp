@@ -22,6 +22,7 @@
 #define quantlib_generic_longstaff_schwartz_hpp
 
 #include <ql/methods/montecarlo/nodedata.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -39,6 +40,23 @@ namespace QuantLib {
         std::vector<std::vector<NodeData> >& simulationData,
         std::vector<std::vector<Real> >& basisCoefficients);
 
+    //! solves the normal equations \f$ C a = b \f$ of a regression
+    /*! C must be symmetric and positive semi-definite. The system is
+        solved by Cholesky decomposition; if a pivot turns out to be
+        too small, i.e., the basis functions are (nearly) collinear on
+        the sample, the SVD of C is used instead.
+    */
+    Disposable<Array> normalEquationsSolve(const Matrix& C, const Array& b);
+
+    //! least-squares coefficients of y regressed on the columns of A
+    /*! The normal equations are accumulated in parallel over blocks
+        of rows of the design matrix A when OpenMP is enabled; the
+        block partition doesn't depend on the number of threads, so
+        that the result is reproducible.
+    */
+    Disposable<Array> leastSquaresRegression(const Matrix& A,
+                                             const Array& y);
+
 }
 
 
@@ -27,6 +27,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/methods/montecarlo/genericlsregression.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 
@@ -158,8 +159,12 @@ namespace QuantLib {
                 }
             }
 
+            // design matrix, also used for the continuation values below
+            const Matrix A = pathPricer_->basisValues(x);
+
             if (v_.size() <=  x.size()) {
-                coeff_[i] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+                coeff_[i] = leastSquaresRegression(
+                                A, Array(y.begin(), y.end()));
             }
             else {
             // if number of itm paths is smaller then the number of
@@ -170,10 +175,9 @@ namespace QuantLib {
             for (Size j=0, k=0; j<n; ++j) {
                 prices[j]*=dF_[i];
                 if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i][l] * v_[l](x[k]);
-                    }
+                    const Real continuationValue =
+                        std::inner_product(A.row_begin(k), A.row_end(k),
+                                           coeff_[i].begin(), 0.0);
                     if (continuationValue < exercise[j]) {
                         prices[j] = exercise[j];
                     }
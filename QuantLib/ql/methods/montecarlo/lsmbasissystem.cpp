@@ -151,6 +151,78 @@ namespace QuantLib {
         return ret;
     }
 
+    Disposable<Matrix> LsmBasisSystem::pathBasisValues(
+                                            Size order, PolynomType polyType,
+                                            const std::vector<Real>& x) {
+        const Size n = x.size();
+        Matrix ret(n, order+1);
+
+        if (polyType == Monomial) {
+            for (Size k=0; k<n; ++k) {
+                ret[k][0] = 1.0;
+                for (Size i=1; i<=order; ++i)
+                    ret[k][i] = ret[k][i-1]*x[k];
+            }
+            return ret;
+        }
+
+        boost::shared_ptr<GaussianOrthogonalPolynomial> p;
+        switch (polyType) {
+          case Laguerre:
+            p = boost::shared_ptr<GaussianOrthogonalPolynomial>(
+                                               new GaussLaguerrePolynomial);
+            break;
+          case Hermite:
+            p = boost::shared_ptr<GaussianOrthogonalPolynomial>(
+                                               new GaussHermitePolynomial);
+            break;
+          case Hyperbolic:
+            p = boost::shared_ptr<GaussianOrthogonalPolynomial>(
+                                               new GaussHyperbolicPolynomial);
+            break;
+          case Legendre:
+            p = boost::shared_ptr<GaussianOrthogonalPolynomial>(
+                                               new GaussLegendrePolynomial);
+            break;
+          case Chebyshev:
+            p = boost::shared_ptr<GaussianOrthogonalPolynomial>(
+                                               new GaussChebyshevPolynomial);
+            break;
+          case Chebyshev2nd:
+            p = boost::shared_ptr<GaussianOrthogonalPolynomial>(
+                                            new GaussChebyshev2ndPolynomial);
+            break;
+          default:
+            QL_FAIL("unknown regression type");
+        }
+
+        // the recurrence coefficients don't depend on the point;
+        // beta(0) doesn't enter the recurrence
+        std::vector<Real> alpha(order), beta(order, 0.0);
+        for (Size i=0; i<order; ++i) {
+            alpha[i] = p->alpha(i);
+            if (i > 0)
+                beta[i] = p->beta(i);
+        }
+
+        for (Size k=0; k<n; ++k) {
+            const Real xk = x[k];
+            Real* row = ret.row_begin(k);
+
+            row[0] = 1.0;
+            if (order > 0)
+                row[1] = xk-alpha[0];
+            for (Size i=2; i<=order; ++i)
+                row[i] = (xk-alpha[i-1])*row[i-1] - beta[i-1]*row[i-2];
+
+            const Real sqrtW = std::sqrt(p->w(xk));
+            for (Size i=0; i<=order; ++i)
+                row[i] *= sqrtW;
+        }
+
+        return ret;
+    }
+
     VF_A LsmBasisSystem::multiPathBasisSystem(Size dim, Size order,
                                               PolynomType polyType) {
         QL_REQUIRE(dim>0, "zero dimension");
@@ -28,7 +28,7 @@
 #define quantlib_lsm_basis_system_hpp
 
 #include <ql/qldefines.hpp>
-#include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 #include <boost/function.hpp>
 #include <vector>
 
@@ -42,6 +42,17 @@ namespace QuantLib {
         static std::vector<boost::function1<Real, Real> >
             pathBasisSystem(Size order, PolynomType polyType);
 
+        //! values of the path basis system at the given points
+        /*! Returns the design matrix with one row per point and
+            order+1 columns; it equals the result of evaluating
+            pathBasisSystem(order, polyType) point by point, but all
+            orders are obtained from a single pass of the three-term
+            recurrence.
+        */
+        static Disposable<Matrix>
+            pathBasisValues(Size order, PolynomType polyType,
+                            const std::vector<Real>& x);
+
         static std::vector<boost::function1<Real, Array> >
             multiPathBasisSystem(Size dim, Size order, PolynomType polyType);
     };
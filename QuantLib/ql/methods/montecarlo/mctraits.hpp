@@ -40,6 +40,8 @@ namespace QuantLib {
         typedef RNG rng_traits;
         typedef Path path_type;
         typedef PathPricer<path_type> path_pricer_type;
+        typedef PathBlock block_type;
+        typedef BlockPathPricer<block_type> block_pricer_type;
         typedef typename RNG::rsg_type rsg_type;
         typedef PathGenerator<rsg_type> path_generator_type;
         enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
@@ -51,6 +53,8 @@ namespace QuantLib {
         typedef RNG rng_traits;
         typedef MultiPath path_type;
         typedef PathPricer<path_type> path_pricer_type;
+        typedef MultiPathBlock block_type;
+        typedef BlockPathPricer<block_type> block_pricer_type;
         typedef typename RNG::rsg_type rsg_type;
         typedef MultiPathGenerator<rsg_type> path_generator_type;
         enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
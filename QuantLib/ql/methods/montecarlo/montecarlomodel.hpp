@@ -28,6 +28,8 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <string>
 
 namespace QuantLib {
 
@@ -45,6 +47,23 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Samples can be drawn from independent streams, each using its
+        own path pricer, by passing the latter to useStreams().  The
+        streams are run in parallel if OpenMP is enabled.  Each stream
+        accumulates its samples in its own instance of the statistics
+        class, which are then merged into the model accumulator in a
+        fixed order, so that the results are reproducible for a given
+        number of streams; with low-discrepancy sequences and
+        statistics storing the samples, they are also the same as the
+        ones obtained from a single stream.  The statistics class
+        must provide a merge() method for this to compile.
+
+        If a block path pricer is passed to useBlocks(), the samples
+        drawn serially are generated and priced in blocks of paths
+        (see PathGenerator::nextBlock()), which gives the same results
+        as drawing them one at a time.  Blocks are not used together
+        with a control variate or with streams.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -56,6 +75,7 @@ namespace QuantLib {
         typedef typename MC<RNG>::path_pricer_type path_pricer_type;
         typedef typename path_generator_type::sample_type sample_type;
         typedef typename path_pricer_type::result_type result_type;
+        typedef typename MC<RNG>::block_pricer_type block_pricer_type;
         typedef S stats_type;
         // constructor
         MonteCarloModel(
@@ -72,7 +92,7 @@ namespace QuantLib {
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator), blockSize_(0) {
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
@@ -80,7 +100,48 @@ namespace QuantLib {
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        /*! Sets the path pricers (and, if a control variate is used,
+            the control path pricers) for each of the streams.  The
+            streams are used only if the sequence generator can be
+            split (see SplittingTraits); otherwise, samples are drawn
+            serially as usual.
+
+            Each stream works on its own copy of the path generator,
+            including its random-number generator, Brownian bridge and
+            path buffers; the path pricers are used by their stream
+            only.
+
+            \warning the stochastic process and the term structures
+                     it uses are not copied, since they can't be
+                     cloned in general; they are shared by the
+                     streams and must be safe to read concurrently
+                     once they have been used.  Any lazy calculation
+                     they need is triggered by drawing the first
+                     sample of each stream serially.
+        */
+        void useStreams(
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                                                                pathPricers,
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                cvPathPricers
+                  = std::vector<boost::shared_ptr<path_pricer_type> >());
+        /*! Sets the path pricer used to price blocks of the given
+            number of paths at once.  The path pricer passed to the
+            constructor must return the same values on each path.
+        */
+        void useBlocks(const boost::shared_ptr<block_pricer_type>& pricer,
+                       Size blockSize = 256);
       private:
+        void addSamples(Size samples, boost::false_type);
+        void addSamples(Size samples, boost::true_type);
+        void addBlockSamples(Size samples);
+        result_type nextSample(
+                    const path_generator_type& pathGenerator,
+                    const path_pricer_type& pathPricer,
+                    const boost::shared_ptr<path_pricer_type>& cvPathPricer,
+                    const boost::shared_ptr<path_generator_type>&
+                                                           cvPathGenerator,
+                    Real& weight) const;
         boost::shared_ptr<path_generator_type> pathGenerator_;
         boost::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -89,43 +150,191 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         boost::shared_ptr<path_generator_type> cvPathGenerator_;
+        std::vector<boost::shared_ptr<path_pricer_type> > streamPricers_;
+        std::vector<boost::shared_ptr<path_pricer_type> > streamCvPricers_;
+        boost::shared_ptr<block_pricer_type> blockPricer_;
+        Size blockSize_;
+        Array blockValues_, antitheticValues_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
-        for(Size j = 1; j <= samples; j++) {
+        typedef typename RNG::rsg_type rsg_type;
+        addSamples(samples,
+                   boost::integral_constant<bool,
+                       SplittingTraits<rsg_type>::allowsSplitting != 0>());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::useStreams(
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                                                                pathPricers,
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                                                             cvPathPricers) {
+        QL_REQUIRE(!isControlVariate_ ||
+                   cvPathPricers.size() == pathPricers.size(),
+                   "control-variate path pricers (" << cvPathPricers.size()
+                   << ") needed for each stream (" << pathPricers.size()
+                   << ")");
+        streamPricers_ = pathPricers;
+        streamCvPricers_ = cvPathPricers;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::useBlocks(
+                      const boost::shared_ptr<block_pricer_type>& pricer,
+                      Size blockSize) {
+        QL_REQUIRE(blockSize > 0, "null block size given");
+        blockPricer_ = pricer;
+        blockSize_ = blockSize;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MonteCarloModel<MC,RNG,S>::result_type
+    MonteCarloModel<MC,RNG,S>::nextSample(
+                    const path_generator_type& pathGenerator,
+                    const path_pricer_type& pathPricer,
+                    const boost::shared_ptr<path_pricer_type>& cvPathPricer,
+                    const boost::shared_ptr<path_generator_type>&
+                                                           cvPathGenerator,
+                    Real& weight) const {
 
-            sample_type path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        sample_type path = pathGenerator.next();
+        result_type price = pathPricer(path.value);
 
+        if (isControlVariate_) {
+            if (!cvPathGenerator) {
+                price += cvOptionValue_-(*cvPathPricer)(path.value);
+            }
+            else {
+                sample_type cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer)(cvPath.value);
+            }
+        }
+
+        if (isAntitheticVariate_) {
+            path = pathGenerator.antithetic();
+            result_type price2 = pathPricer(path.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (!cvPathGenerator)
+                    price2 += cvOptionValue_-(*cvPathPricer)(path.value);
                 else {
-                    sample_type cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    sample_type cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer)(cvPath.value);
                 }
             }
+            price = (price+price2)/2.0;
+        }
+
+        weight = path.weight;
+        return price;
+    }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples,
+                                                      boost::false_type) {
+        if (blockPricer_ && !isControlVariate_) {
+            addBlockSamples(samples);
+            return;
+        }
+        for(Size j = 1; j <= samples; j++) {
+            Real weight;
+            result_type price = nextSample(*pathGenerator_, *pathPricer_,
+                                           cvPathPricer_, cvPathGenerator_,
+                                           weight);
+            sampleAccumulator_.add(price, weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    void MonteCarloModel<MC,RNG,S>::addBlockSamples(Size samples) {
+        // the last, partial block is drawn separately so that the
+        // full ones keep using the same buffers
+        Size full = samples/blockSize_, rest = samples%blockSize_;
+        for (Size b=0; b<=full; b++) {
+            Size n = (b < full ? blockSize_ : rest);
+            if (n == 0)
+                break;
+            const typename MC<RNG>::block_type& block =
+                pathGenerator_->nextBlock(n);
+            (*blockPricer_)(block, blockValues_);
             if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(path.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
+                (*blockPricer_)(pathGenerator_->antitheticBlock(),
+                                antitheticValues_);
+                for (Size k=0; k<n; k++)
+                    blockValues_[k] =
+                        (blockValues_[k]+antitheticValues_[k])/2.0;
+            }
+            for (Size k=0; k<n; k++)
+                sampleAccumulator_.add(blockValues_[k], block.weight(k));
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+    template <template <class> class MC, class RNG, class S>
+    void MonteCarloModel<MC,RNG,S>::addSamples(Size samples,
+                                               boost::true_type) {
+        Size nStreams = std::min(streamPricers_.size(), samples);
+        if (nStreams <= 1) {
+            addSamples(samples, boost::false_type());
+            return;
+        }
+
+        // the generators are split serially, so that each stream
+        // is given the same random numbers regardless of scheduling
+        std::vector<Size> sizes(nStreams);
+        std::vector<stats_type> accumulators(nStreams);
+        std::vector<boost::shared_ptr<path_generator_type> >
+            generators(nStreams), cvGenerators(nStreams);
+        for (Size i=0; i<nStreams; i++) {
+            sizes[i] = samples/nStreams + (i < samples%nStreams ? 1 : 0);
+            generators[i] = boost::shared_ptr<path_generator_type>(
+                      new path_generator_type(pathGenerator_->split(sizes[i])));
+            if (cvPathGenerator_)
+                cvGenerators[i] = boost::shared_ptr<path_generator_type>(
+                    new path_generator_type(cvPathGenerator_->split(sizes[i])));
+        }
+
+        std::vector<std::string> errors(nStreams);
+        boost::shared_ptr<path_pricer_type> noPricer;
+
+        // the first sample of each stream is drawn serially, so that
+        // any lazy calculation is performed before the streams are
+        // started
+        for (Size i=0; i<nStreams; i++) {
+            Real weight;
+            result_type price =
+                nextSample(*generators[i], *streamPricers_[i],
+                           isControlVariate_ ? streamCvPricers_[i] : noPricer,
+                           cvGenerators[i], weight);
+            accumulators[i].add(price, weight);
+        }
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for
+        #endif
+        for (Size i=0; i<nStreams; i++) {
+            try {
+                for (Size j=1; j<sizes[i]; j++) {
+                    Real weight;
+                    result_type price =
+                        nextSample(*generators[i], *streamPricers_[i],
+                                   isControlVariate_ ? streamCvPricers_[i]
+                                                     : noPricer,
+                                   cvGenerators[i], weight);
+                    accumulators[i].add(price, weight);
+                }
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
             }
         }
+
+        for (Size i=0; i<nStreams; i++) {
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+            sampleAccumulator_.merge(accumulators[i]);
+        }
     }
 
     template <template <class> class MC, class RNG, class S>
@@ -0,0 +1,86 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathblock.hpp
+    \brief Block of correlated multiple asset paths
+*/
+
+#ifndef quantlib_montecarlo_multi_path_block_hpp
+#define quantlib_montecarlo_multi_path_block_hpp
+
+#include <ql/methods/montecarlo/pathblock.hpp>
+#include <ql/methods/montecarlo/multipath.hpp>
+
+namespace QuantLib {
+
+    //! Block of correlated multiple asset paths
+    /*! MultiPathBlock contains a block of paths for each asset, i.e.,
+        block[j] holds the paths followed by the j-th asset; the k-th
+        path of each of them belongs to the same scenario.
+
+        \ingroup mcarlo
+    */
+    class MultiPathBlock {
+      public:
+        MultiPathBlock() {}
+        MultiPathBlock(Size nAsset,
+                       const TimeGrid& timeGrid,
+                       Size paths);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return blocks_.size(); }
+        Size pathSize() const { return blocks_[0].length(); }
+        //! number of paths for each asset
+        Size size() const { return blocks_.empty() ? 0 : blocks_[0].size(); }
+        //! weight of the \f$ k \f$-th multi-path
+        Real weight(Size k) const { return blocks_[0].weight(k); }
+        //! copy of the \f$ k \f$-th multi-path
+        MultiPath path(Size k) const;
+        //@}
+        //! \name read/write access to components
+        //@{
+        const PathBlock& operator[](Size j) const { return blocks_[j]; }
+        const PathBlock& at(Size j) const { return blocks_.at(j); }
+        PathBlock& operator[](Size j) { return blocks_[j]; }
+        PathBlock& at(Size j) { return blocks_.at(j); }
+        //@}
+      private:
+        std::vector<PathBlock> blocks_;
+    };
+
+
+    // inline definitions
+
+    inline MultiPathBlock::MultiPathBlock(Size nAsset,
+                                          const TimeGrid& timeGrid,
+                                          Size paths)
+    : blocks_(nAsset, PathBlock(timeGrid, paths)) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+    }
+
+    inline MultiPath MultiPathBlock::path(Size k) const {
+        std::vector<Path> paths;
+        paths.reserve(blocks_.size());
+        for (Size j=0; j<blocks_.size(); ++j)
+            paths.push_back(blocks_[j].path(k));
+        return MultiPath(paths);
+    }
+
+}
+
+
+#endif
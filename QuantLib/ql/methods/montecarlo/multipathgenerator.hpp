@@ -28,6 +28,7 @@
 #define quantlib_multi_path_generator_hpp
 
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/multipathblock.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/stochasticprocess.hpp>
 
@@ -44,7 +45,10 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
-        \test the generated paths are checked against cached results
+        \test
+        - the generated paths are checked against cached results
+        - blocks of paths are checked against the corresponding
+          single paths
     */
     template <class GSG>
     class MultiPathGenerator {
@@ -56,12 +60,33 @@ namespace QuantLib {
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        /*! returns a block of \f$ n \f$ multi-paths, the \f$ k \f$-th
+            of which is the one that would have been returned by the
+            \f$ k \f$-th of \f$ n \f$ successive calls to next().
+            The process is evolved for the whole block at once.
+
+            \warning as for next(), the Brownian bridge is not
+                     supported; an exception is thrown if the
+                     generator was built with it.
+        */
+        const MultiPathBlock& nextBlock(Size n) const;
+        //! returns the antithetic multi-paths of the last block
+        const MultiPathBlock& antitheticBlock() const;
+        /*! returns a generator for the next \f$ n \f$ paths, using
+            an independent stream of random numbers.
+
+            \pre GSG must provide a <tt>split(Size)</tt> method.
+        */
+        MultiPathGenerator split(Size n);
       private:
         const sample_type& next(bool antithetic) const;
+        const MultiPathBlock& block(bool antithetic) const;
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        mutable MultiPathBlock nextBlock_;
+        mutable Matrix draws_, asset_, temp_, evolved_;
     };
 
 
@@ -87,6 +112,13 @@ namespace QuantLib {
                    "no times given");
     }
 
+    template <class GSG>
+    MultiPathGenerator<GSG> MultiPathGenerator<GSG>::split(Size n) {
+        MultiPathGenerator<GSG> g(*this);
+        g.generator_ = generator_.split(n);
+        return g;
+    }
+
     template <class GSG>
     inline const typename MultiPathGenerator<GSG>::sample_type&
     MultiPathGenerator<GSG>::next() const {
@@ -150,6 +182,81 @@ namespace QuantLib {
         }
     }
 
+    template <class GSG>
+    const MultiPathBlock& MultiPathGenerator<GSG>::nextBlock(Size n) const {
+
+        QL_REQUIRE(!brownianBridge_, "Brownian bridge not supported");
+
+        Size m = process_->size();
+        if (nextBlock_.size() != n) {
+            nextBlock_ = MultiPathBlock(m, next_.value[0].timeGrid(), n);
+            draws_ = Matrix(generator_.dimension(), n);
+            asset_ = Matrix(m, n);
+            temp_ = Matrix(process_->factors(), n);
+            evolved_ = Matrix(m, n);
+        }
+
+        // the sequences are stored as columns, so that the rows hold
+        // the variations of all the paths over a given step
+        typedef typename GSG::sample_type sequence_type;
+        for (Size k=0; k<n; ++k) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            std::copy(sequence_.value.begin(),
+                      sequence_.value.end(),
+                      draws_.column_begin(k));
+            for (Size j=0; j<m; j++)
+                nextBlock_[j].weight(k) = sequence_.weight;
+        }
+
+        return block(false);
+    }
+
+    template <class GSG>
+    const MultiPathBlock& MultiPathGenerator<GSG>::antitheticBlock() const {
+        return block(true);
+    }
+
+    template <class GSG>
+    const MultiPathBlock&
+    MultiPathGenerator<GSG>::block(bool antithetic) const {
+
+        Size m = process_->size();
+        Size n = process_->factors();
+        Size paths = nextBlock_.size();
+
+        MultiPathBlock& block = nextBlock_;
+
+        Array x0 = process_->initialValues();
+        for (Size j=0; j<m; j++) {
+            std::fill(asset_.row_begin(j), asset_.row_end(j), x0[j]);
+            std::fill(block[j].begin(0), block[j].end(0), x0[j]);
+        }
+
+        const TimeGrid& timeGrid = block[0].timeGrid();
+        Time t, dt;
+        for (Size i = 1; i < block.pathSize(); i++) {
+            Size offset = (i-1)*n;
+            t = timeGrid[i-1];
+            dt = timeGrid.dt(i-1);
+            if (antithetic)
+                std::transform(draws_.row_begin(offset),
+                               draws_.row_begin(offset) + n*paths,
+                               temp_.begin(),
+                               std::negate<Real>());
+            else
+                std::copy(draws_.row_begin(offset),
+                          draws_.row_begin(offset) + n*paths,
+                          temp_.begin());
+
+            process_->evolveBlock(t, asset_, dt, temp_, evolved_);
+            for (Size j=0; j<m; j++)
+                std::copy(evolved_.row_begin(j), evolved_.row_end(j),
+                          block[j].begin(i));
+            asset_.swap(evolved_);
+        }
+        return block;
+    }
+
 }
 
 #endif
@@ -0,0 +1,156 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathblock.hpp
+    \brief block of single factor random walks
+*/
+
+#ifndef quantlib_montecarlo_path_block_hpp
+#define quantlib_montecarlo_path_block_hpp
+
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! block of single-factor random walks on the same time grid
+    /*! The values are stored in a single matrix whose rows correspond
+        to the points of the time grid and whose columns correspond to
+        the paths.  This way, the values of all the paths at a given
+        time are contiguous and can be processed together.
+
+        \ingroup mcarlo
+        \note the paths include the initial asset value as their first
+              point.
+    */
+    class PathBlock {
+      public:
+        PathBlock(const TimeGrid& timeGrid, Size paths);
+        //! \name inspectors
+        //@{
+        bool empty() const;
+        //! number of points in each path
+        Size length() const;
+        //! number of paths
+        Size size() const;
+        //! value of the \f$ k \f$-th path at the \f$ i \f$-th point
+        Real operator()(Size i, Size k) const;
+        Real& operator()(Size i, Size k);
+        //! time at the \f$ i \f$-th point
+        Time time(Size i) const;
+        //! time grid
+        const TimeGrid& timeGrid() const;
+        //! weight of the \f$ k \f$-th path
+        Real weight(Size k) const;
+        Real& weight(Size k);
+        //! copy of the \f$ k \f$-th path
+        Path path(Size k) const;
+        //@}
+        //! \name iterators
+        //@{
+        //! values of the paths at the \f$ i \f$-th point
+        Matrix::const_row_iterator begin(Size i) const;
+        Matrix::const_row_iterator end(Size i) const;
+        Matrix::row_iterator begin(Size i);
+        Matrix::row_iterator end(Size i);
+        //! initial values of the paths
+        Matrix::const_row_iterator front() const;
+        //! final values of the paths
+        Matrix::const_row_iterator back() const;
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        Matrix values_;
+        Array weights_;
+    };
+
+
+    // inline definitions
+
+    inline PathBlock::PathBlock(const TimeGrid& timeGrid, Size paths)
+    : timeGrid_(timeGrid), values_(timeGrid_.size(), paths),
+      weights_(paths, 1.0) {}
+
+    inline bool PathBlock::empty() const {
+        return timeGrid_.empty();
+    }
+
+    inline Size PathBlock::length() const {
+        return timeGrid_.size();
+    }
+
+    inline Size PathBlock::size() const {
+        return weights_.size();
+    }
+
+    inline Real PathBlock::operator()(Size i, Size k) const {
+        return values_[i][k];
+    }
+
+    inline Real& PathBlock::operator()(Size i, Size k) {
+        return values_[i][k];
+    }
+
+    inline Time PathBlock::time(Size i) const {
+        return timeGrid_[i];
+    }
+
+    inline const TimeGrid& PathBlock::timeGrid() const {
+        return timeGrid_;
+    }
+
+    inline Real PathBlock::weight(Size k) const {
+        return weights_[k];
+    }
+
+    inline Real& PathBlock::weight(Size k) {
+        return weights_[k];
+    }
+
+    inline Path PathBlock::path(Size k) const {
+        return Path(timeGrid_,
+                    Array(values_.column_begin(k), values_.column_end(k)));
+    }
+
+    inline Matrix::const_row_iterator PathBlock::begin(Size i) const {
+        return values_.row_begin(i);
+    }
+
+    inline Matrix::const_row_iterator PathBlock::end(Size i) const {
+        return values_.row_end(i);
+    }
+
+    inline Matrix::row_iterator PathBlock::begin(Size i) {
+        return values_.row_begin(i);
+    }
+
+    inline Matrix::row_iterator PathBlock::end(Size i) {
+        return values_.row_end(i);
+    }
+
+    inline Matrix::const_row_iterator PathBlock::front() const {
+        return values_.row_begin(0);
+    }
+
+    inline Matrix::const_row_iterator PathBlock::back() const {
+        return values_.row_begin(values_.rows()-1);
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,7 @@
 #define quantlib_montecarlo_path_generator_hpp
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/stochasticprocess.hpp>
 
 namespace QuantLib {
@@ -38,7 +39,10 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
-        \test the generated paths are checked against cached results
+        \test
+        - the generated paths are checked against cached results
+        - blocks of paths are checked against the corresponding
+          single paths
     */
     template <class GSG>
     class PathGenerator {
@@ -61,8 +65,26 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! \name block generation
+        //@{
+        /*! returns a block of \f$ n \f$ paths, the \f$ k \f$-th of
+            which is the one that would have been returned by the
+            \f$ k \f$-th of \f$ n \f$ successive calls to next().
+            The process is evolved for the whole block at once.
+        */
+        const PathBlock& nextBlock(Size n) const;
+        //! returns the antithetic paths of the last block
+        const PathBlock& antitheticBlock() const;
+        //@}
+        /*! returns a generator for the next \f$ n \f$ paths, using
+            an independent stream of random numbers.
+
+            \pre GSG must provide a <tt>split(Size)</tt> method.
+        */
+        PathGenerator split(Size n);
       private:
         const sample_type& next(bool antithetic) const;
+        const PathBlock& block(bool antithetic) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -71,6 +93,9 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        mutable PathBlock nextBlock_;
+        mutable Matrix draws_, variates_;
+        mutable Array asset_, increments_, evolved_;
     };
 
 
@@ -86,7 +111,8 @@ namespace QuantLib {
     : brownianBridge_(brownianBridge), generator_(generator),
       dimension_(generator_.dimension()), timeGrid_(length, timeSteps),
       process_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)),
-      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_) {
+      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_),
+      nextBlock_(timeGrid_, 0) {
         QL_REQUIRE(dimension_==timeSteps,
                    "sequence generator dimensionality (" << dimension_
                    << ") != timeSteps (" << timeSteps << ")");
@@ -101,12 +127,20 @@ namespace QuantLib {
     : brownianBridge_(brownianBridge), generator_(generator),
       dimension_(generator_.dimension()), timeGrid_(timeGrid),
       process_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)),
-      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_) {
+      next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_),
+      nextBlock_(timeGrid_, 0) {
         QL_REQUIRE(dimension_==timeGrid_.size()-1,
                    "sequence generator dimensionality (" << dimension_
                    << ") != timeSteps (" << timeGrid_.size()-1 << ")");
     }
 
+    template <class GSG>
+    PathGenerator<GSG> PathGenerator<GSG>::split(Size n) {
+        PathGenerator<GSG> g(*this);
+        g.generator_ = generator_.split(n);
+        return g;
+    }
+
     template <class GSG>
     const typename PathGenerator<GSG>::sample_type&
     PathGenerator<GSG>::next() const {
@@ -154,6 +188,68 @@ namespace QuantLib {
         return next_;
     }
 
+    template <class GSG>
+    const PathBlock& PathGenerator<GSG>::nextBlock(Size n) const {
+
+        if (nextBlock_.size() != n) {
+            nextBlock_ = PathBlock(timeGrid_, n);
+            draws_ = Matrix(dimension_, n);
+            variates_ = Matrix(dimension_, n);
+            asset_ = Array(n);
+            increments_ = Array(n);
+            evolved_ = Array(n);
+        }
+
+        // the sequences are stored as columns, so that the rows hold
+        // the variations of all the paths over a given step
+        typedef typename GSG::sample_type sequence_type;
+        for (Size k=0; k<n; ++k) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            std::copy(sequence_.value.begin(),
+                      sequence_.value.end(),
+                      draws_.column_begin(k));
+            nextBlock_.weight(k) = sequence_.weight;
+        }
+
+        if (brownianBridge_)
+            bb_.transform(draws_, variates_);
+        else
+            std::copy(draws_.begin(), draws_.end(), variates_.begin());
+
+        return block(false);
+    }
+
+    template <class GSG>
+    const PathBlock& PathGenerator<GSG>::antitheticBlock() const {
+        return block(true);
+    }
+
+    template <class GSG>
+    const PathBlock& PathGenerator<GSG>::block(bool antithetic) const {
+
+        std::fill(asset_.begin(), asset_.end(), process_->x0());
+        std::copy(asset_.begin(), asset_.end(), nextBlock_.begin(0));
+
+        for (Size i=1; i<nextBlock_.length(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            if (antithetic)
+                std::transform(variates_.row_begin(i-1),
+                               variates_.row_end(i-1),
+                               increments_.begin(),
+                               std::negate<Real>());
+            else
+                std::copy(variates_.row_begin(i-1),
+                          variates_.row_end(i-1),
+                          increments_.begin());
+            process_->evolveBlock(t, asset_, dt, increments_, evolved_);
+            std::copy(evolved_.begin(), evolved_.end(), nextBlock_.begin(i));
+            asset_.swap(evolved_);
+        }
+
+        return nextBlock_;
+    }
+
 }
 
 
@@ -27,6 +27,7 @@
 
 #include <ql/option.hpp>
 #include <ql/types.hpp>
+#include <ql/math/array.hpp>
 #include <functional>
 
 namespace QuantLib {
@@ -43,6 +44,20 @@ namespace QuantLib {
         virtual ValueType operator()(const PathType& path) const=0;
     };
 
+    //! base class for path pricers working on blocks of paths
+    /*! Writes into the passed array the value of the option on each
+        path of the given block.
+
+        \ingroup mcarlo
+    */
+    template<class BlockType>
+    class BlockPathPricer {
+      public:
+        virtual ~BlockPathPricer() {}
+        virtual void operator()(const BlockType& paths,
+                                Array& values) const=0;
+    };
+
 }
 
 
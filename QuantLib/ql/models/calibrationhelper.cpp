@@ -49,20 +49,23 @@ namespace QuantLib {
     }
 
     Real CalibrationHelper::calibrationError() {
+        return calibrationError(modelValue());
+    }
+
+    Real CalibrationHelper::calibrationError(Real modelPrice) const {
         Real error;
         
         switch (calibrationErrorType_) {
           case RelativePriceError:
-            error = std::fabs(marketValue() - modelValue())/marketValue();
+            error = std::fabs(marketValue() - modelPrice)/marketValue();
             break;
           case PriceError:
-            error = marketValue() - modelValue();
+            error = marketValue() - modelPrice;
             break;
           case ImpliedVolError: 
             {
               const Real lowerPrice = blackPrice(0.001);
               const Real upperPrice = blackPrice(10);
-              const Real modelPrice = modelValue();
 
               Volatility implied;
               if (modelPrice <= lowerPrice)
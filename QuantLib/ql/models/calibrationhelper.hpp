@@ -66,6 +66,12 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         virtual Real calibrationError();
 
+        //! returns the error resulting from the given model value
+        /*! This is used by CalibratedModel::calibrate when the model
+            values of several helpers are computed concurrently.
+        */
+        Real calibrationError(Real modelValue) const;
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -82,6 +88,10 @@ namespace QuantLib {
             engine_ = engine;
         }
 
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
+
       protected:
         mutable Real marketValue_;
         Handle<Quote> volatility_;
@@ -29,13 +29,30 @@ namespace QuantLib {
     AccountingEngine::AccountingEngine(
                          const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
-                         Real initialNumeraireValue)
+                         Real initialNumeraireValue,
+                         Size workers)
     : evolver_(evolver), product_(product),
       initialNumeraireValue_(initialNumeraireValue),
       numberProducts_(product->numberOfProducts()),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
-      cashFlowsGenerated_(product->numberOfProducts()) {
+      cashFlowsGenerated_(product->numberOfProducts()),
+      pathsSimulated_(0) {
+        QL_REQUIRE(workers > 0, "at least one worker required");
+        initialize();
+
+        // the workers' evolvers are replaced by positioned clones
+        // before each simulation
+        if (workers > 1) {
+            workers_.reserve(workers);
+            for (Size i=0; i<workers; ++i)
+                workers_.push_back(boost::shared_ptr<AccountingEngine>(
+                    new AccountingEngine(evolver_->clone(0), product,
+                                         initialNumeraireValue)));
+        }
+    }
+
+    void AccountingEngine::initialize() {
         for (Size i=0; i<numberProducts_; ++i)
             cashFlowsGenerated_[i].resize(
                        product_->maxNumberOfCashFlowsPerProductPerStep());
@@ -47,7 +64,6 @@ namespace QuantLib {
         for (Size j=0; j<cashFlowTimes.size(); ++j)
             discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
                                                          rateTimes));
-
     }
 
     Real AccountingEngine::singlePathValues(std::vector<Real>& values) {
@@ -112,8 +128,8 @@ namespace QuantLib {
         return weight;
     }
 
-    void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
-                                              Size numberOfPaths)
+    void AccountingEngine::serialPathValues(SequenceStatisticsInc& stats,
+                                            Size numberOfPaths)
     {
         std::vector<Real> values(product_->numberOfProducts());
         for (Size i=0; i<numberOfPaths; ++i) {
@@ -122,4 +138,136 @@ namespace QuantLib {
         }
     }
 
+    void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
+                                              Size numberOfPaths)
+    {
+        if (workers_.empty()) {
+            serialPathValues(stats, numberOfPaths);
+            pathsSimulated_ += numberOfPaths;
+            return;
+        }
+
+        Size nBlocks = std::min(workers_.size(), numberOfPaths);
+        std::vector<Size> paths(nBlocks);
+        for (Size i=0; i<nBlocks; ++i) {
+            paths[i] = numberOfPaths/nBlocks
+                     + (i < numberOfPaths%nBlocks ? 1 : 0);
+            workers_[i]->evolver_ = evolver_->clone(pathsSimulated_);
+            pathsSimulated_ += paths[i];
+        }
+
+        std::vector<SequenceStatisticsInc> blockStats(nBlocks);
+        std::vector<std::string> errors(nBlocks);
+
+        #pragma omp parallel for
+        for (Size i=0; i<nBlocks; ++i) {
+            try {
+                workers_[i]->serialPathValues(blockStats[i], paths[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<nBlocks; ++i) {
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+            stats.merge(blockStats[i]);
+        }
+    }
+
+
+    BatchAccountingEngine::BatchAccountingEngine(
+                     const boost::shared_ptr<MarketModelBatchEvolver>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue)
+    : evolver_(evolver), products_(evolver->batchSize(), product),
+      initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      principalsInNumerairePortfolio_(evolver->batchSize()),
+      numerairesHeld_(evolver->batchSize(),
+                      std::vector<Real>(product->numberOfProducts())),
+      done_(evolver->batchSize()),
+      numberCashFlowsThisStep_(product->numberOfProducts()),
+      cashFlowsGenerated_(product->numberOfProducts()) {
+        for (Size i=0; i<numberProducts_; ++i)
+            cashFlowsGenerated_[i].resize(
+                       product->maxNumberOfCashFlowsPerProductPerStep());
+
+        const std::vector<Time>& cashFlowTimes =
+            product->possibleCashFlowTimes();
+        const std::vector<Rate>& rateTimes = product->evolution().rateTimes();
+        discounters_.reserve(cashFlowTimes.size());
+        for (Size j=0; j<cashFlowTimes.size(); ++j)
+            discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
+                                                         rateTimes));
+    }
+
+    void BatchAccountingEngine::batchPathValues(Size paths) {
+        evolver_->startNewPaths(paths, weights_);
+        for (Size p=0; p<paths; ++p) {
+            std::fill(numerairesHeld_[p].begin(), numerairesHeld_[p].end(),
+                      0.0);
+            products_[p]->reset();
+            principalsInNumerairePortfolio_[p] = 1.0;
+            done_[p] = false;
+        }
+
+        Size pathsAlive = paths;
+        do {
+            Size thisStep = evolver_->currentStep();
+            evolver_->advanceStep();
+            Size numeraire = evolver_->numeraires()[thisStep];
+
+            for (Size p=0; p<paths; ++p) {
+                if (done_[p])
+                    continue;
+
+                const CurveState& curveState = evolver_->currentState(p);
+                done_[p] = products_[p]->nextTimeStep(curveState,
+                                                      numberCashFlowsThisStep_,
+                                                      cashFlowsGenerated_);
+
+                // see AccountingEngine::singlePathValues
+                std::vector<Real>& numerairesHeld = numerairesHeld_[p];
+                Real& principal = principalsInNumerairePortfolio_[p];
+                for (Size i=0; i<numberProducts_; ++i) {
+                    const std::vector<MarketModelMultiProduct::CashFlow>&
+                        cashflows = cashFlowsGenerated_[i];
+                    for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
+                        const MarketModelDiscounter& discounter =
+                            discounters_[cashflows[j].timeIndex];
+                        Real bonds = cashflows[j].amount *
+                            discounter.numeraireBonds(curveState, numeraire);
+                        numerairesHeld[i] += bonds/principal;
+                    }
+                }
+
+                if (done_[p]) {
+                    --pathsAlive;
+                } else {
+                    Size nextNumeraire = evolver_->numeraires()[thisStep+1];
+                    principal *= curveState.discountRatio(numeraire,
+                                                          nextNumeraire);
+                }
+            }
+        } while (pathsAlive > 0);
+
+        for (Size p=0; p<paths; ++p)
+            for (Size i=0; i<numberProducts_; ++i)
+                numerairesHeld_[p][i] *= initialNumeraireValue_;
+    }
+
+    void BatchAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        const Size batchSize = evolver_->batchSize();
+        for (Size i=0; i<numberOfPaths; i+=batchSize) {
+            const Size paths = std::min(batchSize, numberOfPaths-i);
+            batchPathValues(paths);
+            for (Size p=0; p<paths; ++p)
+                stats.add(numerairesHeld_[p], weights_[p]);
+        }
+    }
+
 }
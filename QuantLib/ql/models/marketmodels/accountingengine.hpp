@@ -34,6 +34,7 @@
 namespace QuantLib {
 
     class MarketModelEvolver;
+    class MarketModelBatchEvolver;
 
     //class MarketModelDiscounter;
     //class SequenceStatistics;
@@ -41,14 +42,39 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! When more than one worker is requested, the engine divides
+        the paths into contiguous blocks, one per worker, and
+        simulates them in parallel (if OpenMP is enabled) on clones of
+        the evolver and of the product. The evolver is never advanced
+        itself; each clone starts at the first path of its block,
+        counting all the paths simulated by the engine so far, so that
+        successive calls don't overlap. The statistics of the blocks
+        are merged in order, so that the results only depend on the
+        number of workers.
+
+        Out of \f$ N \f$ paths, the \f$ i \f$-th of \f$ n \f$
+        blocks contains \f$ N/n \f$ paths, plus one if
+        \f$ i < N \bmod n \f$. If the Brownian generator of the
+        evolver can skip ahead (as, e.g., the Sobol generator) the
+        paths are the same as for a single worker; otherwise, they
+        depend on the layout of the blocks (see
+        BrownianGenerator::clone).
+
+        \pre the evolver must support cloning if more than one
+             worker is requested.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
-                         Real initialNumeraireValue);
+                         Real initialNumeraireValue,
+                         Size workers = 1);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
+        void initialize();
+        void serialPathValues(SequenceStatisticsInc& stats,
+                              Size numberOfPaths);
         Real singlePathValues(std::vector<Real>& values);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
@@ -64,6 +90,41 @@ namespace QuantLib {
                                                          cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
 
+        // engines simulating the blocks of paths
+        std::vector<boost::shared_ptr<AccountingEngine> > workers_;
+        Size pathsSimulated_;
+    };
+
+    //! Engine collecting cash flows along batches of simulated paths
+    /*! Same accounting as AccountingEngine; the evolver advances a
+        whole batch of paths at each step, while each path keeps its
+        own copy of the product.
+    */
+    class BatchAccountingEngine {
+      public:
+        BatchAccountingEngine(
+                     const boost::shared_ptr<MarketModelBatchEvolver>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        void batchPathValues(Size paths);
+
+        boost::shared_ptr<MarketModelBatchEvolver> evolver_;
+        std::vector<Clone<MarketModelMultiProduct> > products_;
+
+        Real initialNumeraireValue_;
+        Size numberProducts_;
+
+        // workspace
+        std::vector<Real> weights_, principalsInNumerairePortfolio_;
+        std::vector<std::vector<Real> > numerairesHeld_;
+        std::vector<bool> done_;
+        std::vector<Size> numberCashFlowsThisStep_;
+        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
+                                                         cashFlowsGenerated_;
+        std::vector<MarketModelDiscounter> discounters_;
     };
 
 }
@@ -22,6 +22,8 @@
 #define quantlib_brownian_generator_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <ql/math/matrix.hpp>
 #include <boost/shared_ptr.hpp>
 #include <vector>
 
@@ -37,6 +39,31 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+
+        /*! draws the given number of paths at once. The i-th matrix
+            in \a variates receives the variates for the i-th step,
+            with one row per factor and one column per path; the
+            weights of the paths are returned in \a weights.
+
+            The default implementation draws the paths one after the
+            other by means of nextPath() and nextStep(); generators
+            can override it to write their variates into the blocks
+            directly.
+        */
+        virtual void nextPaths(Size paths,
+                               std::vector<Matrix>& variates,
+                               std::vector<Real>& weights);
+
+        /*! returns a new generator of the same kind whose first path
+            is the given one in the sequence of this generator,
+            counting from its own first path regardless of the paths
+            drawn so far. Generators that can't skip ahead can return
+            an independent sequence instead, provided that different
+            paths give different sequences.
+        */
+        virtual boost::shared_ptr<BrownianGenerator> clone(Size) const {
+            QL_FAIL("Brownian generator can't be cloned");
+        }
     };
 
     class BrownianGeneratorFactory {
@@ -47,6 +74,30 @@ namespace QuantLib {
                                                             Size steps) const = 0;
     };
 
+
+    // inline definitions
+
+    inline void BrownianGenerator::nextPaths(Size paths,
+                                             std::vector<Matrix>& variates,
+                                             std::vector<Real>& weights) {
+        const Size factors = numberOfFactors(), steps = numberOfSteps();
+        QL_REQUIRE(variates.size() == steps,
+                   "wrong number of blocks (" << variates.size()
+                   << "), " << steps << " required");
+        weights.resize(paths);
+        std::vector<Real> step(factors);
+        for (Size j=0; j<paths; ++j) {
+            Real weight = nextPath();
+            for (Size i=0; i<steps; ++i) {
+                weight *= nextStep(step);
+                Matrix& block = variates[i];
+                for (Size k=0; k<factors; ++k)
+                    block[k][j] = step[k];
+            }
+            weights[j] = weight;
+        }
+    }
+
 }
 
 #endif
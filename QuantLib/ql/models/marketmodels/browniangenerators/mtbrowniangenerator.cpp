@@ -21,12 +21,35 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        MersenneTwisterUniformRng streamRng(unsigned long seed,
+                                            Size firstPath) {
+            if (firstPath == 0)
+                return MersenneTwisterUniformRng(seed);
+            std::vector<unsigned long> seeds(2);
+            seeds[0] = seed;
+            seeds[1] = static_cast<unsigned long>(firstPath);
+            return MersenneTwisterUniformRng(seeds);
+        }
+
+    }
+
     MTBrownianGenerator::MTBrownianGenerator(Size factors,
                                              Size steps,
                                              unsigned long seed)
-    : factors_(factors), steps_(steps), lastStep_(0),
+    : factors_(factors), steps_(steps), seed_(seed), firstPath_(0),
+      lastStep_(0),
       generator_(factors*steps, MersenneTwisterUniformRng(seed)) {}
 
+    MTBrownianGenerator::MTBrownianGenerator(Size factors,
+                                             Size steps,
+                                             unsigned long seed,
+                                             Size firstPath)
+    : factors_(factors), steps_(steps), seed_(seed), firstPath_(firstPath),
+      lastStep_(0),
+      generator_(factors*steps, streamRng(seed, firstPath)) {}
+
     Real MTBrownianGenerator::nextStep(std::vector<Real>& output) {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(output.size() == factors_, "size mismatch");
@@ -52,10 +75,40 @@ namespace QuantLib {
         return sample.weight;
     }
 
+    void MTBrownianGenerator::nextPaths(Size paths,
+                                        std::vector<Matrix>& variates,
+                                        std::vector<Real>& weights) {
+        typedef RandomSequenceGenerator<MersenneTwisterUniformRng>::sample_type
+            sample_type;
+
+        QL_REQUIRE(variates.size() == steps_,
+                   "wrong number of blocks (" << variates.size()
+                   << "), " << steps_ << " required");
+        weights.resize(paths);
+        for (Size j=0; j<paths; ++j) {
+            const sample_type& sample = generator_.nextSequence();
+            const std::vector<Real>& sequence = sample.value;
+            for (Size i=0; i<steps_; ++i) {
+                Matrix& block = variates[i];
+                for (Size k=0; k<factors_; ++k)
+                    block[k][j] = inverseCumulative_(sequence[i*factors_+k]);
+            }
+            weights[j] = sample.weight;
+        }
+        lastStep_ = steps_;
+    }
+
     Size MTBrownianGenerator::numberOfFactors() const { return factors_; }
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    boost::shared_ptr<BrownianGenerator>
+    MTBrownianGenerator::clone(Size firstPath) const {
+        return boost::shared_ptr<BrownianGenerator>(
+                      new MTBrownianGenerator(factors_, steps_, seed_,
+                                              firstPath_ + firstPath));
+    }
+
 
     MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
     : seed_(seed) {}
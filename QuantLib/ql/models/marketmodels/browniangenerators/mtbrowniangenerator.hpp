@@ -48,11 +48,28 @@ namespace QuantLib {
 
         Real nextStep(std::vector<Real>&);
         Real nextPath();
+        void nextPaths(Size paths,
+                       std::vector<Matrix>& variates,
+                       std::vector<Real>& weights);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+
+        /*! The Mersenne twister can't skip ahead cheaply; therefore,
+            the clone draws the independent sequence initialized by
+            both the seed and the index of its first path, except for
+            the first path itself which gives back the sequence of
+            this generator.
+        */
+        boost::shared_ptr<BrownianGenerator> clone(Size firstPath) const;
       private:
+        MTBrownianGenerator(Size factors,
+                            Size steps,
+                            unsigned long seed,
+                            Size firstPath);
         Size factors_, steps_;
+        unsigned long seed_;
+        Size firstPath_;
         Size lastStep_;
         RandomSequenceGenerator<MersenneTwisterUniformRng> generator_;
         InverseCumulativeNormal inverseCumulative_;
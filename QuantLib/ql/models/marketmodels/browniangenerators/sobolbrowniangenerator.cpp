@@ -24,6 +24,16 @@ namespace QuantLib {
 
     namespace {
 
+        SobolRsg skippedSobolRsg(Size dimensionality,
+                                 unsigned long seed,
+                                 SobolRsg::DirectionIntegers integers,
+                                 Size firstPath) {
+            SobolRsg rsg(dimensionality, seed, integers);
+            if (firstPath > 0)
+                rsg.skipTo(firstPath);
+            return rsg;
+        }
+
         void fillByFactor(std::vector<std::vector<Size> >& M,
                           Size factors, Size steps) {
             Size counter = 0;
@@ -112,9 +122,11 @@ namespace QuantLib {
                                         Size steps,
                                         Ordering ordering,
                                         unsigned long seed,
-                                        SobolRsg::DirectionIntegers integers)
+                                        SobolRsg::DirectionIntegers integers,
+                                        Size firstPath)
     : factors_(factors), steps_(steps), ordering_(ordering),
-      generator_(SobolRsg(factors*steps, seed, integers),
+      seed_(seed), integers_(integers), firstPath_(firstPath),
+      generator_(skippedSobolRsg(factors*steps, seed, integers, firstPath),
                  InverseCumulativeNormal()),
       bridge_(steps), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
@@ -204,10 +216,36 @@ namespace QuantLib {
         return 1.0;
     }
 
+    void SobolBrownianGenerator::nextPaths(Size paths,
+                                           std::vector<Matrix>& variates,
+                                           std::vector<Real>& weights) {
+        QL_REQUIRE(variates.size() == steps_,
+                   "wrong number of blocks (" << variates.size()
+                   << "), " << steps_ << " required");
+        weights.resize(paths);
+        for (Size j=0; j<paths; ++j) {
+            weights[j] = nextPath();
+            for (Size i=0; i<steps_; ++i) {
+                Matrix& block = variates[i];
+                for (Size k=0; k<factors_; ++k)
+                    block[k][j] = bridgedVariates_[k][i];
+            }
+        }
+        lastStep_ = steps_;
+    }
+
     Size SobolBrownianGenerator::numberOfFactors() const { return factors_; }
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    boost::shared_ptr<BrownianGenerator>
+    SobolBrownianGenerator::clone(Size firstPath) const {
+        return boost::shared_ptr<BrownianGenerator>(
+                     new SobolBrownianGenerator(factors_, steps_, ordering_,
+                                                seed_, integers_,
+                                                firstPath_ + firstPath));
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
@@ -46,20 +46,30 @@ namespace QuantLib {
                            most important factors and the largest
                            steps. */
         };
+        /*! The generator skips the first \a firstPath points of the
+            Sobol sequence, so that generators starting at consecutive
+            blocks of paths reproduce the sequence of a single one.
+        */
         SobolBrownianGenerator(
                            Size factors,
                            Size steps,
                            Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                        = SobolRsg::Jaeckel);
+                                                        = SobolRsg::Jaeckel,
+                           Size firstPath = 0);
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
+        void nextPaths(Size paths,
+                       std::vector<Matrix>& variates,
+                       std::vector<Real>& weights);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
-        
+
+        boost::shared_ptr<BrownianGenerator> clone(Size firstPath) const;
+
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
         std::vector<std::vector<Real> > transform(
@@ -68,6 +78,9 @@ namespace QuantLib {
       private:
         Size factors_, steps_;
         Ordering ordering_;
+        unsigned long seed_;
+        SobolRsg::DirectionIntegers integers_;
+        Size firstPath_;
         InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator_;
         BrownianBridge bridge_;
         // work variables
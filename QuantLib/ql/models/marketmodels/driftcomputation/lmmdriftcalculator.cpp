@@ -181,4 +181,117 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& fwds,
+                                     Matrix& drifts) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(fwds.rows()==numberOfRates_, "numberOfRates <> dim");
+            QL_REQUIRE(drifts.rows()==numberOfRates_,
+                       "drifts.rows() <> dim");
+            QL_REQUIRE(drifts.columns()==fwds.columns(),
+                       "drifts.columns() <> fwds.columns()");
+        #endif
+
+        if (isFullFactor_)
+            computePlain(fwds, drifts);
+        else
+            computeReduced(fwds, drifts);
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& forwards,
+                                          Matrix& drifts) const {
+
+        // Same as above, with the innermost loops running over paths
+        const Size paths = forwards.columns();
+        if (tmpBatch_.rows() != numberOfRates_ || tmpBatch_.columns() != paths)
+            tmpBatch_ = Matrix(numberOfRates_, paths);
+
+        Size i, p;
+        for (i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards.row_begin(i);
+            Real* t = tmpBatch_.row_begin(i);
+            const Real d = displacements_[i], o = oneOverTaus_[i];
+            #pragma omp simd
+            for (p=0; p<paths; ++p)
+                t[p] = (f[p]+d)/(o+f[p]);
+        }
+
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Real* mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            for (Size k=downs_[i]; k<ups_[i]; ++k) {
+                const Real c = C_[i][k];
+                const Real* t = tmpBatch_.row_begin(k);
+                #pragma omp simd
+                for (p=0; p<paths; ++p)
+                    mu[p] += c*t[p];
+            }
+            if (numeraire_>i+1) {
+                for (p=0; p<paths; ++p)
+                    mu[p] = -mu[p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& forwards,
+                                            Matrix& drifts) const {
+
+        // Same as above; the running sums e_[r][i] only depend on
+        // e_[r][i+1] (or e_[r][i-1]), so one row per factor is kept.
+        const Size paths = forwards.columns();
+        if (tmpBatch_.rows() != numberOfRates_ || tmpBatch_.columns() != paths)
+            tmpBatch_ = Matrix(numberOfRates_, paths);
+        if (eBatch_.rows() != numberOfFactors_ || eBatch_.columns() != paths)
+            eBatch_ = Matrix(numberOfFactors_, paths);
+
+        Size p, r;
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards.row_begin(i);
+            Real* t = tmpBatch_.row_begin(i);
+            const Real d = displacements_[i], o = oneOverTaus_[i];
+            #pragma omp simd
+            for (p=0; p<paths; ++p)
+                t[p] = (f[p]+d)/(o+f[p]);
+        }
+
+        // 1st step
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step: backward from N-2 to alive
+        std::fill(eBatch_.begin(), eBatch_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Real* mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            const Real* t = tmpBatch_.row_begin(i+1);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Real* e = eBatch_.row_begin(r);
+                const Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                #pragma omp simd
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    mu[p] -= e[p]*b;
+                }
+            }
+        }
+
+        // 3rd step: forward from N up to n
+        std::fill(eBatch_.begin(), eBatch_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Real* mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            const Real* t = tmpBatch_.row_begin(i);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Real* e = eBatch_.row_begin(r);
+                const Real a = pseudo_[i][r];
+                #pragma omp simd
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    mu[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
@@ -64,6 +64,13 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! Computes the drifts of a batch of paths at once. Rows of
+            the matrices correspond to rates, columns to paths; rows
+            of dead rates are not touched. */
+        void compute(const Matrix& fwds, Matrix& drifts) const;
+        void computePlain(const Matrix& fwds, Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds, Matrix& drifts) const;
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -74,6 +81,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix tmpBatch_, eBatch_;
         std::vector<Size> downs_, ups_;
     };
 
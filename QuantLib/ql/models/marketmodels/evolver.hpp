@@ -22,6 +22,8 @@
 #define quantlib_market_model_evolver_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <boost/shared_ptr.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -42,6 +44,36 @@ namespace QuantLib {
         virtual Size currentStep() const = 0;
         virtual const CurveState& currentState() const = 0;
         virtual void setInitialState(const CurveState&) = 0;
+        /*! returns a new evolver of the same kind on the same model,
+            whose paths start at the given one; see
+            BrownianGenerator::clone.
+        */
+        virtual boost::shared_ptr<MarketModelEvolver> clone(Size) const {
+            QL_FAIL("market-model evolver can't be cloned");
+        }
+    };
+
+    //! Market-model evolver working on batches of paths
+    /*! Abstract base class. Same as MarketModelEvolver, except that a
+        number of paths (up to batchSize()) are evolved together so
+        that the work for a single step can be organized as
+        matrix-matrix products across paths.
+    */
+    class MarketModelBatchEvolver {
+      public:
+        virtual ~MarketModelBatchEvolver() {}
+
+        virtual const std::vector<Size>& numeraires() const = 0;
+        virtual Size batchSize() const = 0;
+        /*! starts the given number of new paths (not larger than
+            batchSize()) and returns their weights in the passed vector.
+        */
+        virtual void startNewPaths(Size paths,
+                                   std::vector<Real>& weights) = 0;
+        virtual void advanceStep() = 0;
+        virtual Size currentStep() const = 0;
+        virtual const CurveState& currentState(Size path) const = 0;
+        virtual void setInitialState(const CurveState&) = 0;
     };
 
 }
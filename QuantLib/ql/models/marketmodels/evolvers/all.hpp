@@ -1,6 +1,9 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/models/marketmodels/evolvers/batchlognormalcmswapratepc.hpp>
+#include <ql/models/marketmodels/evolvers/batchlognormalcotswapratepc.hpp>
+#include <ql/models/marketmodels/evolvers/batchlognormalfwdratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalcmswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalcotswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
@@ -0,0 +1,235 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/batchlognormalcotswapratepc.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    BatchLogNormalCotSwapRatePc::BatchLogNormalCotSwapRatePc(
+                           const boost::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size batchSize,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      batchSize_(batchSize), initialStep_(initialStep),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel->numberOfFactors()),
+      paths_(0),
+      curveStates_(batchSize, CoterminalSwapCurveState(
+                                   marketModel->evolution().rateTimes())),
+      displacements_(marketModel->displacements()),
+      initialLogSwapRates_(numberOfRates_), initialDrifts_(numberOfRates_),
+      pathSwapRates_(numberOfRates_), pathDrifts_(numberOfRates_),
+      correlated_(batchSize),
+      swapRates_(numberOfRates_, batchSize, 0.0),
+      logSwapRates_(numberOfRates_, batchSize, 0.0),
+      drifts1_(numberOfRates_, batchSize, 0.0),
+      drifts2_(numberOfRates_, batchSize, 0.0),
+      alive_(marketModel->evolution().firstAliveRate())
+    {
+        QL_REQUIRE(batchSize_ > 0, "batch size must be positive");
+        checkCompatibility(marketModel->evolution(), numeraires);
+
+        Size steps = marketModel->evolution().numberOfSteps();
+
+        generator_ = factory.create(numberOfFactors_, steps-initialStep_);
+        pathBrownians_ = std::vector<Matrix>(
+            steps-initialStep_, Matrix(numberOfFactors_, batchSize_, 0.0));
+
+        currentStep_ = initialStep_;
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                SMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        setCoterminalSwapRates(marketModel_->initialRates());
+    }
+
+    const std::vector<Size>& BatchLogNormalCotSwapRatePc::numeraires() const {
+        return numeraires_;
+    }
+
+    Size BatchLogNormalCotSwapRatePc::batchSize() const {
+        return batchSize_;
+    }
+
+    void BatchLogNormalCotSwapRatePc::setCoterminalSwapRates(
+                                        const std::vector<Real>& swapRates) {
+        QL_REQUIRE(swapRates.size()==numberOfRates_,
+                   "mismatch between swapRates and rateTimes");
+        for (Size i=0; i<numberOfRates_; ++i) {
+            initialLogSwapRates_[i] = std::log(swapRates[i] +
+                                               displacements_[i]);
+            std::fill(swapRates_.row_begin(i), swapRates_.row_end(i),
+                      swapRates[i]);
+        }
+        CoterminalSwapCurveState& curveState = curveStates_.front();
+        curveState.setOnCoterminalSwapRates(swapRates);
+        calculators_[initialStep_].compute(curveState, initialDrifts_);
+    }
+
+    void BatchLogNormalCotSwapRatePc::setInitialState(const CurveState& cs) {
+        const CoterminalSwapCurveState* cotcs =
+            dynamic_cast<const CoterminalSwapCurveState*>(&cs);
+        QL_REQUIRE(cotcs != 0, "coterminal swap curve state required");
+        setCoterminalSwapRates(cotcs->coterminalSwapRates());
+    }
+
+    void BatchLogNormalCotSwapRatePc::startNewPaths(
+                                                Size paths,
+                                                std::vector<Real>& weights) {
+        QL_REQUIRE(paths > 0 && paths <= batchSize_,
+                   "number of paths (" << paths << ") out of range [1, "
+                   << batchSize_ << "]");
+
+        paths_ = paths;
+        currentStep_ = initialStep_;
+        generator_->nextPaths(paths_, pathBrownians_, weights);
+
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(logSwapRates_.row_begin(i), logSwapRates_.row_end(i),
+                      initialLogSwapRates_[i]);
+    }
+
+    void BatchLogNormalCotSwapRatePc::updateCurveStates() {
+        for (Size p=0; p<paths_; ++p) {
+            for (Size i=0; i<numberOfRates_; ++i)
+                pathSwapRates_[i] = swapRates_[i][p];
+            curveStates_[p].setOnCoterminalSwapRates(pathSwapRates_);
+        }
+    }
+
+    void BatchLogNormalCotSwapRatePc::computeDrifts(Matrix& drifts) {
+        const SMMDriftCalculator& calculator = calculators_[currentStep_];
+        for (Size p=0; p<paths_; ++p) {
+            calculator.compute(curveStates_[p], pathDrifts_);
+            for (Size i=alive_[currentStep_]; i<numberOfRates_; ++i)
+                drifts[i][p] = pathDrifts_[i];
+        }
+    }
+
+    void BatchLogNormalCotSwapRatePc::advanceStep()
+    {
+        // we're going from T1 to T2; all loops over paths run on
+        // the whole batch, unused columns being harmless.
+        Size i, f, p;
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            computeDrifts(drifts1_);
+        } else {
+            for (i=0; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                          initialDrifts_[i]);
+        }
+
+        // b) evolve swap rates up to T2 using D1;
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const Matrix& Z = pathBrownians_[currentStep_-initialStep_];
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+
+        Size alive = alive_[currentStep_];
+        for (i=alive; i<numberOfRates_; ++i) {
+            Real* x = logSwapRates_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            const Real c = fixedDrift[i];
+            #pragma omp simd
+            for (p=0; p<batchSize_; ++p)
+                x[p] += d1[p] + c;
+
+            // row i of the pseudo-root times the Brownian block,
+            // summed in the same order as LogNormalCotSwapRatePc
+            Real* w = &correlated_[0];
+            std::fill(w, w+batchSize_, 0.0);
+            for (f=0; f<numberOfFactors_; ++f) {
+                const Real a = A[i][f];
+                const Real* z = Z.row_begin(f);
+                #pragma omp simd
+                for (p=0; p<batchSize_; ++p)
+                    w[p] += a*z[p];
+            }
+            #pragma omp simd
+            for (p=0; p<batchSize_; ++p)
+                x[p] += w[p];
+
+            Real* y = swapRates_.row_begin(i);
+            const Real d = displacements_[i];
+            #pragma omp simd
+            for (p=0; p<batchSize_; ++p)
+                y[p] = std::exp(x[p]) - d;
+        }
+
+        // intermediate curve state update
+        updateCurveStates();
+
+        // c) recompute drifts D2 using the predicted swap rates;
+        computeDrifts(drifts2_);
+
+        // d) correct swap rates using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Real* x = logSwapRates_.row_begin(i);
+            Real* y = swapRates_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            const Real* d2 = drifts2_.row_begin(i);
+            const Real d = displacements_[i];
+            #pragma omp simd
+            for (p=0; p<batchSize_; ++p) {
+                x[p] += (d2[p]-d1[p])/2.0;
+                y[p] = std::exp(x[p]) - d;
+            }
+        }
+
+        // e) update curve states
+        updateCurveStates();
+
+        ++currentStep_;
+    }
+
+    Size BatchLogNormalCotSwapRatePc::currentStep() const {
+        return currentStep_;
+    }
+
+    const CurveState&
+    BatchLogNormalCotSwapRatePc::currentState(Size path) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(path < paths_, "path index out of range");
+        #endif
+        return curveStates_[path];
+    }
+
+}
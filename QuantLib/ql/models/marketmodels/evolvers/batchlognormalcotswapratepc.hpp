@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchlognormalcotswapratepc.hpp
+    \brief coterminal swap-rate predictor-corrector on batches of paths
+*/
+
+#ifndef quantlib_batch_coterminalswap_rate_pc_evolver_hpp
+#define quantlib_batch_coterminalswap_rate_pc_evolver_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/curvestates/coterminalswapcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/smmdriftcalculator.hpp>
+#include <ql/math/matrix.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Coterminal swap-rate predictor-corrector on batches of paths
+    /*! Same discretization as LogNormalCotSwapRatePc, with the
+        batch layout of BatchLogNormalFwdRatePc: the pseudo-root
+        times Brownian-block product and the exponentials run over
+        all the paths of the batch, while the drifts are still
+        computed path by path from the curve states.
+
+        \note The drift calculation and the curve-state updates take
+              most of the time of a step in this model; since they
+              are not batched, the evolver is not much faster than
+              LogNormalCotSwapRatePc.
+    */
+    class BatchLogNormalCotSwapRatePc : public MarketModelBatchEvolver {
+      public:
+        BatchLogNormalCotSwapRatePc(const boost::shared_ptr<MarketModel>&,
+                                    const BrownianGeneratorFactory&,
+                                    const std::vector<Size>& numeraires,
+                                    Size batchSize,
+                                    Size initialStep = 0);
+        //! \name MarketModelBatchEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Size batchSize() const;
+        void startNewPaths(Size paths, std::vector<Real>& weights);
+        void advanceStep();
+        Size currentStep() const;
+        const CurveState& currentState(Size path) const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setCoterminalSwapRates(const std::vector<Real>& swapRates);
+        void updateCurveStates();
+        void computeDrifts(Matrix& drifts);
+        // inputs
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size batchSize_, initialStep_;
+        boost::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_, paths_;
+        std::vector<CoterminalSwapCurveState> curveStates_;
+        Size currentStep_;
+        std::vector<Rate> displacements_, initialLogSwapRates_;
+        std::vector<Real> initialDrifts_, pathSwapRates_, pathDrifts_;
+        std::vector<Real> correlated_;
+        Matrix swapRates_, logSwapRates_, drifts1_, drifts2_;
+        std::vector<Matrix> pathBrownians_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<SMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
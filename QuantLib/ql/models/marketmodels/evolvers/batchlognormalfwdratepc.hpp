@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchlognormalfwdratepc.hpp
+    \brief predictor-corrector evolver working on batches of paths
+*/
+
+#ifndef quantlib_batch_forward_rate_pc_evolver_hpp
+#define quantlib_batch_forward_rate_pc_evolver_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/math/matrix.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Predictor-Corrector on batches of paths
+    /*! Same discretization as LogNormalFwdRatePc; forwards, drifts
+        and Brownian increments are stored with one row per rate (or
+        factor) and one column per path, so that each step is a
+        pseudo-root times Brownian-block product followed by
+        element-wise updates over contiguous rows.
+
+        The Brownian increments of the whole batch are drawn from the
+        generator when the batch is started. Therefore, the results
+        match those of LogNormalFwdRatePc with the same generator
+        factory unless products terminate early with a generator
+        drawing its numbers step by step.
+    */
+    class BatchLogNormalFwdRatePc : public MarketModelBatchEvolver {
+      public:
+        BatchLogNormalFwdRatePc(const boost::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size batchSize,
+                                Size initialStep = 0);
+        //! \name MarketModelBatchEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Size batchSize() const;
+        void startNewPaths(Size paths, std::vector<Real>& weights);
+        void advanceStep();
+        Size currentStep() const;
+        const CurveState& currentState(Size path) const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        // inputs
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size batchSize_, initialStep_;
+        boost::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_, paths_;
+        std::vector<LMMCurveState> curveStates_;
+        Size currentStep_;
+        std::vector<Rate> displacements_, initialLogForwards_;
+        std::vector<Real> initialDrifts_, pathForwards_, correlated_;
+        Matrix forwards_, logForwards_, drifts1_, drifts2_;
+        std::vector<Matrix> pathBrownians_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
@@ -93,6 +93,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(curveState_, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalCmSwapRatePc::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalCmSwapRatePc> evolver(
+                                             new LogNormalCmSwapRatePc(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalCmSwapRatePc::setInitialState(const CurveState& cs) {
         const CMSwapCurveState* cotcs = dynamic_cast<const CMSwapCurveState*>(&cs);
         const std::vector<Real>& swapRates = cotcs->cmSwapRates(spanningForwards_);
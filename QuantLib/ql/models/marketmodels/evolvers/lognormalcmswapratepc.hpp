@@ -48,6 +48,7 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        boost::shared_ptr<MarketModelEvolver> clone(Size firstPath) const;
         //@}
       private:
         void setCMSwapRates(const std::vector<Real>& swapRates);
@@ -90,6 +90,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(curveState_, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalCotSwapRatePc::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalCotSwapRatePc> evolver(
+                                            new LogNormalCotSwapRatePc(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalCotSwapRatePc::setInitialState(const CurveState& cs) {
         // why??
         const CoterminalSwapCurveState* cotcs = dynamic_cast<const CoterminalSwapCurveState*>(&cs);
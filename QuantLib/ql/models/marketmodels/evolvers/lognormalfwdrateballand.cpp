@@ -88,6 +88,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(forwards, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateBalland::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalFwdRateBalland> evolver(
+                                           new LogNormalFwdRateBalland(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalFwdRateBalland::setInitialState(const CurveState& cs) {
         setForwards(cs.forwardRates());
     }
@@ -88,6 +88,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(forwards, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateEuler::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalFwdRateEuler> evolver(
+                                             new LogNormalFwdRateEuler(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalFwdRateEuler::setInitialState(const CurveState& cs) {
         setForwards(cs.forwardRates());
     }
@@ -93,6 +93,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(forwards, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateEulerConstrained::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalFwdRateEulerConstrained> evolver(
+                                  new LogNormalFwdRateEulerConstrained(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalFwdRateEulerConstrained::setInitialState(const CurveState& cs) {
         setForwards(cs.forwardRates());
     }
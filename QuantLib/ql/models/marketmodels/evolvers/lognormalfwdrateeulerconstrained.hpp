@@ -58,6 +58,7 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        boost::shared_ptr<MarketModelEvolver> clone(Size firstPath) const;
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
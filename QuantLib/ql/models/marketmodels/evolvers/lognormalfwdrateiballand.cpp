@@ -89,6 +89,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(forwards, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateiBalland::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalFwdRateiBalland> evolver(
+                                          new LogNormalFwdRateiBalland(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalFwdRateiBalland::setInitialState(const CurveState& cs) {
         setForwards(cs.forwardRates());
     }
@@ -91,6 +91,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(forwards, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateIpc::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalFwdRateIpc> evolver(
+                                               new LogNormalFwdRateIpc(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalFwdRateIpc::setInitialState(const CurveState& cs) {
         setForwards(cs.forwardRates());
     }
@@ -90,6 +90,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(forwards, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRatePc::clone(Size firstPath) const {
+        boost::shared_ptr<LogNormalFwdRatePc> evolver(
+                                                new LogNormalFwdRatePc(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void LogNormalFwdRatePc::setInitialState(const CurveState& cs) {
         setForwards(cs.forwardRates());
     }
@@ -84,6 +84,14 @@ namespace QuantLib {
         calculators_[initialStep_].compute(forwards, initialDrifts_);
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    NormalFwdRatePc::clone(Size firstPath) const {
+        boost::shared_ptr<NormalFwdRatePc> evolver(
+                                                   new NormalFwdRatePc(*this));
+        evolver->generator_ = generator_->clone(firstPath);
+        return evolver;
+    }
+
     void NormalFwdRatePc::setInitialState(const CurveState& cs) {
         setForwards(cs.forwardRates());
     }
@@ -719,7 +719,8 @@ namespace QuantLib {
         const Clone<MarketModelPathwiseMultiProduct>& product,
         const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
         const std::vector<std::vector<Matrix> >& vegaBumps,
-        Real initialNumeraireValue)
+        Real initialNumeraireValue,
+        Size workers)
         : evolver_(evolver), 
         product_(product),
         pseudoRootStructure_(pseudoRootStructure),
@@ -732,7 +733,35 @@ namespace QuantLib {
         cashFlowsGenerated_(product->numberOfProducts()),
         stepsDiscounts_(pseudoRootStructure_->numberOfRates()+1),
         elementary_vegas_ThisPath_(product->numberOfProducts()),
-        deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
+        deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1),
+        pathsSimulated_(0)
+    {
+        QL_REQUIRE(workers > 0, "at least one worker required");
+        initialize();
+
+        // the workers' evolvers are replaced by positioned clones
+        // before each simulation
+        if (workers > 1) {
+            workers_.reserve(workers);
+            for (Size i=0; i<workers; ++i)
+                workers_.push_back(
+                    boost::shared_ptr<PathwiseVegasOuterAccountingEngine>(
+                        new PathwiseVegasOuterAccountingEngine(
+                            cloneEvolver(0), product, pseudoRootStructure,
+                            vegaBumps, initialNumeraireValue)));
+        }
+    }
+
+    boost::shared_ptr<LogNormalFwdRateEuler>
+    PathwiseVegasOuterAccountingEngine::cloneEvolver(Size firstPath) const {
+        boost::shared_ptr<LogNormalFwdRateEuler> evolver =
+            boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                                                 evolver_->clone(firstPath));
+        QL_ENSURE(evolver, "wrong evolver type returned by clone");
+        return evolver;
+    }
+
+    void PathwiseVegasOuterAccountingEngine::initialize()
     {
 
         stepsDiscounts_[0]=1.0;
@@ -747,9 +776,9 @@ namespace QuantLib {
         numeraires_ =  moneyMarketMeasure(evolution);
 
 
-        QL_REQUIRE(vegaBumps.size() == numberSteps_, "we need precisely one vector of vega bumps for each step.");
+        QL_REQUIRE(vegaBumps_.size() == numberSteps_, "we need precisely one vector of vega bumps for each step.");
 
-        numberBumps_ = vegaBumps[0].size();
+        numberBumps_ = vegaBumps_[0].size();
 
        std::vector<Matrix> jacobiansThisPathsModel;
        for (Size i =0; i < numberRates_; ++i)
@@ -1118,18 +1147,11 @@ namespace QuantLib {
     
 }
 
-    void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
-        Size numberOfPaths)
+    void PathwiseVegasOuterAccountingEngine::accumulatePathValues(std::vector<Real>& sums,
+                                                                  std::vector<Real>& sumsqs,
+                                                                  Size numberOfPaths)
     {
-        Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
-
-        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
-
-
+        std::vector<Real> values(sums.size());
 
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -1142,8 +1164,61 @@ namespace QuantLib {
 
             }
         }
+    }
 
-        for (Size j=0; j < values.size(); ++j)
+    void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
+        Size numberOfPaths)
+    {
+        Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
+
+        Size numberOfValues = product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas);
+        means.resize(numberOfValues);
+        errors.resize(numberOfValues);
+        std::vector<Real> sums(numberOfValues,0.0);
+        std::vector<Real> sumsqs(numberOfValues,0.0);
+
+        if (workers_.empty()) {
+            accumulatePathValues(sums, sumsqs, numberOfPaths);
+            pathsSimulated_ += numberOfPaths;
+        } else {
+            // same block layout as AccountingEngine; the block sums
+            // are added in order for reproducibility
+            Size nBlocks = std::min(workers_.size(), numberOfPaths);
+            std::vector<Size> paths(nBlocks);
+            for (Size i=0; i<nBlocks; ++i) {
+                paths[i] = numberOfPaths/nBlocks
+                         + (i < numberOfPaths%nBlocks ? 1 : 0);
+                workers_[i]->evolver_ = cloneEvolver(pathsSimulated_);
+                pathsSimulated_ += paths[i];
+            }
+            std::vector<std::vector<Real> > blockSums(nBlocks,
+                                                      std::vector<Real>(numberOfValues,0.0));
+            std::vector<std::vector<Real> > blockSumsqs = blockSums;
+            std::vector<std::string> blockErrors(nBlocks);
+
+            #pragma omp parallel for
+            for (Size i=0; i<nBlocks; ++i) {
+                try {
+                    workers_[i]->accumulatePathValues(blockSums[i],
+                                                      blockSumsqs[i],
+                                                      paths[i]);
+                } catch (std::exception& e) {
+                    blockErrors[i] = e.what();
+                } catch (...) {
+                    blockErrors[i] = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<nBlocks; ++i) {
+                QL_REQUIRE(blockErrors[i].empty(), blockErrors[i]);
+                for (Size j=0; j < numberOfValues; ++j) {
+                    sums[j] += blockSums[i][j];
+                    sumsqs[j] += blockSumsqs[i][j];
+                }
+            }
+        }
+
+        for (Size j=0; j < numberOfValues; ++j)
             {
                 means[j] = sums[j]/numberOfPaths;
                 Real meanSq = sumsqs[j]/numberOfPaths;
@@ -188,6 +188,8 @@ namespace QuantLib {
     // This implementation is different in that all the linear combinations by the bumps are done as late as possible,
     // whereas PathwiseVegasAccountingEngine does them as early as possible. 
     // This is tested in MarketModelTest::testPathwiseVegas
+    // When more than one worker is requested, the paths are divided into blocks which are simulated
+    // in parallel on clones of the evolver; see AccountingEngine for the layout of the blocks.
 
     class PathwiseVegasOuterAccountingEngine 
     {
@@ -196,7 +198,8 @@ namespace QuantLib {
                          const Clone<MarketModelPathwiseMultiProduct>& product,
                          const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
                          const std::vector<std::vector<Matrix> >& VegaBumps, 
-                         Real initialNumeraireValue);
+                         Real initialNumeraireValue,
+                         Size workers = 1);
 
         //! Use to get vegas with respect to VegaBumps
         void multiplePathValues(std::vector<Real>& means,
@@ -209,6 +212,11 @@ namespace QuantLib {
                                 Size numberOfPaths);
 
       private:
+          void initialize();
+          boost::shared_ptr<LogNormalFwdRateEuler> cloneEvolver(Size firstPath) const;
+          void accumulatePathValues(std::vector<Real>& sums,
+                                    std::vector<Real>& sumsqs,
+                                    Size numberOfPaths);
           Real singlePathValues(std::vector<Real>& values);
 
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
@@ -261,6 +269,10 @@ namespace QuantLib {
         std::vector<Matrix> totalCashFlowsThisIndex_; // need product cross times cross which sensitivity
 
         std::vector<std::vector<Size> > cashFlowIndicesThisStep_;
+
+        // engines simulating the blocks of paths
+        std::vector<boost::shared_ptr<PathwiseVegasOuterAccountingEngine> > workers_;
+        Size pathsSimulated_;
 /*
         // experimental
 
@@ -22,6 +22,8 @@
 #include <ql/math/optimization/problem.hpp>
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
+#include <ql/pricingengine.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -41,39 +43,87 @@ namespace QuantLib {
                   const std::vector<boost::shared_ptr<CalibrationHelper> >&
                                                                   instruments,
                   const std::vector<Real>& weights,
-                  const Projection& projection)
+                  const Projection& projection,
+                  bool concurrent = false)
         : model_(model, no_deletion), instruments_(instruments),
-          weights_(weights), projection_(projection) { }
+          weights_(weights), projection_(projection),
+          concurrent_(concurrent) {
+            // helpers sharing a pricing engine would share its arguments
+            // and results, so they can only be repriced one at a time
+            std::vector<PricingEngine*> engines(instruments_.size());
+            for (Size i=0; i<instruments_.size(); i++)
+                engines[i] = instruments_[i]->pricingEngine().get();
+            std::sort(engines.begin(), engines.end());
+            if (std::find(engines.begin(), engines.end(),
+                          (PricingEngine*)0) != engines.end() ||
+                std::adjacent_find(engines.begin(), engines.end())
+                                                            != engines.end())
+                concurrent_ = false;
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
-            model_->setParams(projection_.include(params));
+            const Array errors = calibrationErrors(params);
             Real value = 0.0;
-            for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
-            }
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
             return std::sqrt(value);
         }
 
         virtual Disposable<Array> values(const Array& params) const {
-            model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
-            for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
-            }
+            Array values = calibrationErrors(params);
+            for (Size i=0; i<instruments_.size(); i++)
+                values[i] *= std::sqrt(weights_[i]);
             return values;
         }
 
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        /* The model values are the expensive part and are computed
+           concurrently when each helper has its own engine; the
+           helpers are set up beforehand, and the errors (which might
+           reprice the instruments with a Black engine) are then
+           computed serially. */
+        Disposable<Array> calibrationErrors(const Array& params) const {
+            model_->setParams(projection_.include(params));
+            Array errors(instruments_.size());
+            if (!concurrent_) {
+                for (Size i=0; i<instruments_.size(); i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                return errors;
+            }
+
+            for (Size i=0; i<instruments_.size(); i++)
+                instruments_[i]->marketValue();
+
+            std::vector<Real> modelValues(instruments_.size());
+            std::vector<std::string> failures(instruments_.size());
+
+            #pragma omp parallel for schedule(dynamic)
+            for (Size i=0; i<instruments_.size(); i++) {
+                try {
+                    modelValues[i] = instruments_[i]->modelValue();
+                } catch (std::exception& e) {
+                    failures[i] = e.what();
+                } catch (...) {
+                    failures[i] = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<instruments_.size(); i++) {
+                QL_REQUIRE(failures[i].empty(), failures[i]);
+                errors[i] = instruments_[i]->calibrationError(modelValues[i]);
+            }
+            return errors;
+        }
+
         boost::shared_ptr<CalibratedModel> model_;
         const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments_;
         std::vector<Real> weights_;
         const Projection projection_;
+        bool concurrent_;
     };
 
     void CalibratedModel::calibrate(
@@ -82,7 +132,8 @@ namespace QuantLib {
         const EndCriteria& endCriteria,
         const Constraint& additionalConstraint,
         const std::vector<Real>& weights,
-        const std::vector<bool>& fixParameters) {
+        const std::vector<bool>& fixParameters,
+        bool concurrent) {
 
         QL_REQUIRE(weights.empty() ||
                    weights.size() == instruments.size(),
@@ -100,7 +151,7 @@ namespace QuantLib {
         Array prms = params();
         std::vector<bool> all(prms.size(), false);
         Projection proj(prms,fixParameters.size()>0 ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        CalibrationFunction f(this,instruments,w,proj,concurrent);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -97,6 +97,22 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If concurrent calibration is requested and each
+            instrument has its own pricing engine, the model values
+            are computed concurrently at each step of the
+            optimization (including the finite-difference bumps of
+            the Jacobian); otherwise, they are computed serially.
+
+            \warning concurrent calibration is only safe if the
+                     engines can run at the same time on the shared
+                     model, i.e., if they don't modify it and if the
+                     model's term structures are fully built before
+                     the calibration starts (the market values are
+                     computed serially beforehand, which usually
+                     takes care of the latter.) The analytic and
+                     tree engines for the short-rate models satisfy
+                     this requirement.
         */
         virtual void calibrate(
                    const std::vector<boost::shared_ptr<CalibrationHelper> >&,
@@ -104,7 +120,8 @@ namespace QuantLib {
                    const EndCriteria& endCriteria,
                    const Constraint& constraint = Constraint(),
                    const std::vector<Real>& weights = std::vector<Real>(),
-                   const std::vector<bool>& fixParameters = std::vector<bool>());
+                   const std::vector<bool>& fixParameters = std::vector<bool>(),
+                   bool concurrent = false);
 
         Real value(const Array& params,
                    const std::vector<boost::shared_ptr<CalibrationHelper> >&);
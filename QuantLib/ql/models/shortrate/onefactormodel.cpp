@@ -89,6 +89,51 @@ namespace QuantLib {
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
       tree_(tree), dynamics_(dynamics) {}
 
+    void OneFactorModel::ShortRateTree::computeRollbackTables() const {
+        Size levels = timeGrid().size() - 1;
+        descendants_.resize(levels);
+        probabilities_.resize(levels);
+        discounts_.resize(levels);
+        for (Size i=0; i<levels; i++) {
+            Size n = size(i);
+            descendants_[i].resize(n);
+            probabilities_[i].resize(3*n);
+            Array(n).swap(discounts_[i]);
+            for (Size j=0; j<n; j++) {
+                descendants_[i][j] = descendant(i,j,0);
+                for (Size l=0; l<3; l++)
+                    probabilities_[i][3*j+l] = probability(i,j,l);
+                discounts_[i][j] = discount(i,j);
+            }
+        }
+    }
+
+    void OneFactorModel::ShortRateTree::stepback(Size i, const Array& values,
+                                                 Array& newValues) const {
+        // the fitting parameter of the dynamics might still be
+        // calibrated after the tree is built, so the tables are only
+        // computed when they are first needed
+        if (discounts_.empty())
+            computeRollbackTables();
+        Size n = size(i);
+        const Size* k = &descendants_[i][0];
+        const Real* p = &probabilities_[i][0];
+        const Real* d = discounts_[i].begin();
+        const Real* v = values.begin();
+        Real* result = newValues.begin();
+        // narrow levels are not worth the threading overhead
+        #pragma omp parallel for if(n > 1024)
+        for (Size j=0; j<n; j++) {
+            const Real* vj = v + k[j];
+            const Real* pj = p + 3*j;
+            Real value = 0.0;
+            value += pj[0]*vj[0];
+            value += pj[1]*vj[1];
+            value += pj[2]*vj[2];
+            result[j] = value*d[j];
+        }
+    }
+
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
 
@@ -72,6 +72,11 @@ namespace QuantLib {
     };
 
     //! Recombining trinomial tree discretizing the state variable
+    /*! The descendants, probabilities and discount factors of the
+        nodes are stored level by level in contiguous tables when the
+        first asset is rolled back; the short-rate dynamics must not
+        change afterwards.
+    */
     class OneFactorModel::ShortRateTree
         : public TreeLattice1D<OneFactorModel::ShortRateTree> {
       public:
@@ -103,9 +108,17 @@ namespace QuantLib {
         Real probability(Size i, Size index, Size branch) const {
             return tree_->probability(i, index, branch);
         }
+        void stepback(Size i, const Array& values, Array& newValues) const;
       private:
+        void computeRollbackTables() const;
         boost::shared_ptr<TrinomialTree> tree_;
         boost::shared_ptr<ShortRateDynamics> dynamics_;
+        // for each level: the lowest descendant of each node (the
+        // other two follow it), the three branching probabilities of
+        // each node stored contiguously, and the discount factors
+        mutable std::vector<std::vector<Size> > descendants_;
+        mutable std::vector<std::vector<Real> > probabilities_;
+        mutable std::vector<Array> discounts_;
         class Helper;
     };
 
@@ -83,6 +83,23 @@ namespace QuantLib {
         virtual void partialRollback(DiscretizedAsset&,
                                      Time to) const = 0;
 
+        /*! Roll back a set of assets until the given time, performing
+            any needed adjustment.  The assets can start from
+            different times and must be distinct.
+        */
+        virtual void rollback(
+                const std::vector<boost::shared_ptr<DiscretizedAsset> >&,
+                Time to) const;
+
+        /*! Roll back a set of assets until the given time, but do not
+            perform the final adjustment.  The default implementation
+            rolls back the assets one at a time; derived classes can
+            roll them back together.
+        */
+        virtual void partialRollback(
+                const std::vector<boost::shared_ptr<DiscretizedAsset> >&,
+                Time to) const;
+
         //! computes the present value of an asset.
         virtual Real presentValue(DiscretizedAsset&) const = 0;
 
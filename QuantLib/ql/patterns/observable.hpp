@@ -28,15 +28,90 @@
 
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
+#include <ql/patterns/singleton.hpp>
 
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
+#include <vector>
+
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/atomic.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#else
 #include <set>
+#endif
 
 namespace QuantLib {
 
     class Observer;
 
+    namespace detail {
+        class ObserverProxy;
+    }
+
+    //! global settings for the observer pattern
+    /*! While updates are deferred, notifications sent by observables
+        are not forwarded to their observers; instead, the latter are
+        collected (each of them only once, however many notifications
+        it should have received) and updated when enableUpdates() is
+        called. Notifications triggered by those updates are collected
+        in turn, so that each observer reachable from the original
+        ones receives exactly one update() call.
+
+        The NotificationBatch class in ql/settings.hpp provides a
+        safer way to defer updates within a given scope.
+
+        \warning results obtained from lazy objects while updates are
+                 deferred might not reflect changes in their inputs.
+
+        \ingroup patterns
+    */
+    class ObservableSettings : public Singleton<ObservableSettings> {
+        friend class Singleton<ObservableSettings>;
+        friend class Observable;
+        friend class Observer;
+        friend class detail::ObserverProxy;
+      private:
+        ObservableSettings() : updatesDeferred_(false) {}
+      public:
+        //! start collecting notifications
+        void deferUpdates();
+        //! update the collected observers and stop collecting
+        /*! \note if any observer throws during its update, the others
+                  are still updated and an exception is raised at the
+                  end.
+        */
+        void enableUpdates();
+        bool updatesDeferred() const;
+      private:
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        typedef boost::shared_ptr<detail::ObserverProxy> deferred_observer;
+        #else
+        typedef Observer* deferred_observer;
+        #endif
+        enum DeferState { Idle, Pending, Notified };
+        template <class Iterator>
+        void defer(Iterator begin, Iterator end);
+        void unregisterDeferredObserver(deferred_observer);
+        std::vector<deferred_observer> deferred_, notified_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::atomic<bool> updatesDeferred_;
+        boost::mutex mutex_;
+        #else
+        bool updatesDeferred_;
+        #endif
+    };
+
+}
+
+#if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+
+namespace QuantLib {
+
     //! Object that notifies its changes to a set of observers
     /*! \ingroup patterns */
     class Observable {
@@ -62,13 +137,15 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class Observer {
       public:
+        typedef std::set<boost::shared_ptr<Observable> > set_type;
+        typedef set_type::iterator iterator;
         // constructors, assignment, destructor
-        Observer() {}
+        Observer() : deferState_(ObservableSettings::Idle) {}
         Observer(const Observer&);
         Observer& operator=(const Observer&);
         virtual ~Observer();
         // observer interface
-        std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
+        std::pair<iterator, bool>
         registerWith(const boost::shared_ptr<Observable>&);
         /*! register with all observables of a given observer. Note
             that this does not include registering with the observer
@@ -83,8 +160,9 @@ namespace QuantLib {
         */
         virtual void update() = 0;
       private:
-        std::set<boost::shared_ptr<Observable> > observables_;
-        typedef std::set<boost::shared_ptr<Observable> >::iterator iterator;
+        friend class ObservableSettings;
+        set_type observables_;
+        ObservableSettings::DeferState deferState_;
     };
 
 
@@ -121,6 +199,13 @@ namespace QuantLib {
     }
 
     inline void Observable::notifyObservers() {
+        if (observers_.empty())
+            return;
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (settings.updatesDeferred()) {
+            settings.defer(observers_.begin(), observers_.end());
+            return;
+        }
         bool successful = true;
         std::string errMsg;
         for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
@@ -146,7 +231,7 @@ namespace QuantLib {
 
 
     inline Observer::Observer(const Observer& o)
-    : observables_(o.observables_) {
+    : observables_(o.observables_), deferState_(ObservableSettings::Idle) {
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->registerObserver(this);
     }
@@ -162,11 +247,13 @@ namespace QuantLib {
     }
 
     inline Observer::~Observer() {
+        if (deferState_ != ObservableSettings::Idle)
+            ObservableSettings::instance().unregisterDeferredObserver(this);
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->unregisterObserver(this);
     }
 
-    inline std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
+    inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const boost::shared_ptr<Observable>& h) {
         if (h) {
             h->registerObserver(this);
@@ -199,4 +286,442 @@ namespace QuantLib {
 
 }
 
+#else
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! handle through which observables reach their observers
+        /*! Observables hold shared pointers to proxies rather than
+            raw pointers to observers; an observer deactivates its
+            proxy upon destruction, so that notifications already
+            under way on other threads (or further down the current
+            call stack) skip it instead of calling a dead object.
+        */
+        class ObserverProxy {
+          public:
+            explicit ObserverProxy(Observer* observer)
+            : active_(true), observer_(observer),
+              deferState_(ObservableSettings::Idle) {}
+            void update() const;
+            bool active() const { return active_; }
+            /*! No further updates are forwarded once this method
+                returns. Updates already forwarded to an observer
+                owned by a shared pointer keep it alive.
+            */
+            void deactivate() {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                active_ = false;
+            }
+          private:
+            boost::atomic<bool> active_;
+            Observer* const observer_;
+            // only held while checking that the observer is alive,
+            // never while it's being updated
+            mutable boost::mutex mutex_;
+            // guarded by the ObservableSettings mutex
+            friend class QuantLib::ObservableSettings;
+            ObservableSettings::DeferState deferState_;
+        };
+
+        /* sorted vector used as a flat set. Elements are shifted
+           by swapping them rather than by assignment, which for
+           shared pointers would cost a pair of atomic operations
+           each. */
+        template <class T>
+        inline bool insertSorted(std::vector<T>& v, const T& x) {
+            Size i = std::lower_bound(v.begin(), v.end(), x) - v.begin();
+            if (i != v.size() && !(x < v[i]))
+                return false;
+            v.push_back(x);
+            for (Size j=v.size()-1; j>i; --j)
+                v[j].swap(v[j-1]);
+            return true;
+        }
+
+        template <class T>
+        inline Size eraseSorted(std::vector<T>& v, const T& x) {
+            Size i = std::lower_bound(v.begin(), v.end(), x) - v.begin();
+            if (i == v.size() || x < v[i])
+                return 0;
+            for (Size j=i+1; j<v.size(); ++j)
+                v[j-1].swap(v[j]);
+            v.pop_back();
+            return 1;
+        }
+
+    }
+
+    //! Object that notifies its changes to a set of observers
+    /*! This version is enabled by defining
+        QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN. Registration,
+        unregistration and notification can be performed
+        concurrently from different threads.
+
+        Observers are kept in a sorted vector which is shared
+        copy-on-write with running notifications: notifyObservers()
+        only locks the observable long enough to take a reference
+        to the current list, and registrations only copy it when a
+        notification is actually iterating over it.
+
+        \ingroup patterns
+    */
+    class Observable {
+        friend class Observer;
+      public:
+        // constructors, assignment, destructor
+        Observable() : observers_(new observer_list), released_(0) {}
+        Observable(const Observable&);
+        Observable& operator=(const Observable&);
+        virtual ~Observable() {}
+        /*! This method should be called at the end of non-const methods
+            or when the programmer desires to notify any changes.
+        */
+        void notifyObservers();
+      private:
+        typedef boost::shared_ptr<detail::ObserverProxy> proxy;
+        typedef std::vector<proxy> observer_list;
+        bool registerObserver(const proxy&);
+        Size unregisterObserver(const proxy&);
+        // called by observers being destroyed
+        void releaseObserver();
+        // to be called with mutex_ locked
+        observer_list& writableObservers();
+        boost::shared_ptr<observer_list> observers_;
+        // proxies of destroyed observers still in the list
+        Size released_;
+        boost::mutex mutex_;
+    };
+
+    //! Object that gets notified when a given observable changes
+    /*! This version is enabled by defining
+        QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN.
+
+        Observers owned by a shared pointer are kept alive for the
+        duration of each update() call, and are no longer notified
+        once their reference count dropped to zero.
+
+        \warning observers not owned by a shared pointer are only
+                 guaranteed not to receive new notifications once
+                 the %Observer destructor has run; an update() call
+                 already under way is not waited for. Such an
+                 observer must not be destroyed on one thread while
+                 it might be notified on another.
+
+        \ingroup patterns
+    */
+    class Observer : public boost::enable_shared_from_this<Observer> {
+      public:
+        typedef std::vector<boost::shared_ptr<Observable> > set_type;
+        typedef set_type::iterator iterator;
+        // constructors, assignment, destructor
+        Observer() : proxy_(new detail::ObserverProxy(this)) {}
+        Observer(const Observer&);
+        Observer& operator=(const Observer&);
+        virtual ~Observer();
+        // observer interface
+        std::pair<iterator, bool>
+        registerWith(const boost::shared_ptr<Observable>&);
+        /*! register with all observables of a given observer. Note
+            that this does not include registering with the observer
+            itself. */
+        void registerWithObservables(const boost::shared_ptr<Observer>&);
+        Size unregisterWith(const boost::shared_ptr<Observable>&);
+        void unregisterWithAll();
+        /*! This method must be implemented in derived classes. An
+            instance of %Observer does not call this method directly:
+            instead, it will be called by the observables the instance
+            registered with when they need to notify any changes.
+        */
+        virtual void update() = 0;
+      private:
+        set_type observables() const;
+        boost::shared_ptr<detail::ObserverProxy> proxy_;
+        set_type observables_;
+        mutable boost::mutex mutex_;
+    };
+
+
+    // inline definitions
+
+    inline void detail::ObserverProxy::update() const {
+        boost::shared_ptr<Observer> o;
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            if (!active_)
+                return;
+            const boost::weak_ptr<Observer> owner =
+                observer_->weak_from_this();
+            o = owner.lock();
+            if (!o) {
+                // a weak pointer equivalent to an empty one was
+                // never owned; otherwise, the destruction of the
+                // observer is already under way.
+                const boost::weak_ptr<Observer> none;
+                if (owner.owner_before(none) || none.owner_before(owner))
+                    return;
+                // not managed by a shared pointer; see the warning
+                // in the Observer documentation.
+                lock.unlock();
+                observer_->update();
+                return;
+            }
+        }
+        // the observer can't be destroyed while being notified
+        o->update();
+    }
+
+    inline Observable::Observable(const Observable&)
+    : observers_(new observer_list), released_(0) {
+        // the observer set is not copied; no observer asked to
+        // register with this object
+    }
+
+    /*! \warning notification is sent before the copy constructor has
+                 a chance of actually change the data
+                 members. Therefore, observers whose update() method
+                 tries to use their observables will not see the
+                 updated values. It is suggested that the update()
+                 method just raise a flag in order to trigger
+                 a later recalculation.
+    */
+    inline Observable& Observable::operator=(const Observable& o) {
+        // as above, the observer set is not copied. Moreover,
+        // observers of this object must be notified of the change
+        if (&o != this)
+            notifyObservers();
+        return *this;
+    }
+
+    inline Observable::observer_list& Observable::writableObservers() {
+        // a notification holding the current list would see it
+        // change under its feet; give it a copy to keep instead.
+        if (!observers_.unique())
+            observers_.reset(new observer_list(*observers_));
+        return *observers_;
+    }
+
+    inline bool Observable::registerObserver(const proxy& o) {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return detail::insertSorted(writableObservers(), o);
+    }
+
+    inline Size Observable::unregisterObserver(const proxy& o) {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return detail::eraseSorted(writableObservers(), o);
+    }
+
+    inline void Observable::releaseObserver() {
+        // Deactivated proxies are skipped by notifications, so they
+        // can be removed lazily; doing it in a single pass when
+        // they're half of the list avoids shifting it over and over
+        // when many observers are destroyed.
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        if (2*(++released_) < observers_->size())
+            return;
+        observer_list& observers = writableObservers();
+        Size j = 0;
+        for (Size i=0; i<observers.size(); ++i) {
+            if (observers[i]->active())
+                observers[j++].swap(observers[i]);
+        }
+        observers.resize(j);
+        released_ = 0;
+    }
+
+    inline void Observable::notifyObservers() {
+        boost::shared_ptr<observer_list> observers;
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            observers = observers_;
+        }
+        // observers_ might be replaced (or this object destroyed)
+        // during the loop; the local copy keeps the list alive.
+        if (observers->empty())
+            return;
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (settings.updatesDeferred()) {
+            settings.defer(observers->begin(), observers->end());
+            return;
+        }
+        bool successful = true;
+        std::string errMsg;
+        for (observer_list::const_iterator i=observers->begin();
+             i!=observers->end(); ++i) {
+            try {
+                (*i)->update();
+            } catch (std::exception& e) {
+                // see the comments in the single-threaded version
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+
+    inline Observer::Observer(const Observer& o)
+    : proxy_(new detail::ObserverProxy(this)), observables_(o.observables()) {
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->registerObserver(proxy_);
+    }
+
+    inline Observer& Observer::operator=(const Observer& o) {
+        if (&o == this)
+            return *this;
+        set_type observables = o.observables();
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        iterator i;
+        for (i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->unregisterObserver(proxy_);
+        observables_.swap(observables);
+        for (i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->registerObserver(proxy_);
+        return *this;
+    }
+
+    inline Observer::~Observer() {
+        proxy_->deactivate();
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->releaseObserver();
+    }
+
+    inline Observer::set_type Observer::observables() const {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return observables_;
+    }
+
+    inline std::pair<Observer::iterator, bool>
+    Observer::registerWith(const boost::shared_ptr<Observable>& h) {
+        if (h) {
+            h->registerObserver(proxy_);
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            iterator i = std::lower_bound(observables_.begin(),
+                                          observables_.end(), h);
+            if (i != observables_.end() && !(h < *i))
+                return std::make_pair(i, false);
+            return std::make_pair(observables_.insert(i, h), true);
+        }
+        return std::make_pair(observables_.end(), false);
+    }
+
+    inline void
+    Observer::registerWithObservables(const boost::shared_ptr<Observer> &o) {
+        if (o) {
+            set_type observables = o->observables();
+            for (iterator i = observables.begin();
+                 i != observables.end(); ++i)
+                registerWith(*i);
+        }
+    }
+
+    inline
+    Size Observer::unregisterWith(const boost::shared_ptr<Observable>& h) {
+        if (h)
+            h->unregisterObserver(proxy_);
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return detail::eraseSorted(observables_, h);
+    }
+
+    inline void Observer::unregisterWithAll() {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->unregisterObserver(proxy_);
+        observables_.clear();
+    }
+
+}
+
+#endif
+
+namespace QuantLib {
+
+    // ObservableSettings inline definitions
+
+    inline bool ObservableSettings::updatesDeferred() const {
+        return updatesDeferred_;
+    }
+
+    inline void ObservableSettings::deferUpdates() {
+        updatesDeferred_ = true;
+    }
+
+    template <class Iterator>
+    inline void ObservableSettings::defer(Iterator begin, Iterator end) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        #endif
+        for (; begin != end; ++begin) {
+            if ((*begin)->deferState_ == Idle) {
+                (*begin)->deferState_ = Pending;
+                deferred_.push_back(*begin);
+            }
+        }
+    }
+
+    inline void
+    ObservableSettings::unregisterDeferredObserver(deferred_observer o) {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        #endif
+        // the observer is being destroyed; null its entries so
+        // that they are skipped.
+        std::replace(deferred_.begin(), deferred_.end(),
+                     o, deferred_observer());
+        std::replace(notified_.begin(), notified_.end(),
+                     o, deferred_observer());
+        o->deferState_ = Idle;
+    }
+
+    inline void ObservableSettings::enableUpdates() {
+        bool successful = true;
+        std::string errMsg;
+        // updates stay deferred until we're done, so that observers
+        // notified by the ones we update end up in the queue (unless
+        // they already received their update.)
+        for (;;) {
+            deferred_observer o;
+            {
+                #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                #endif
+                if (deferred_.empty())
+                    break;
+                o = deferred_.back();
+                deferred_.pop_back();
+                if (!o)
+                    continue;
+                o->deferState_ = Notified;
+                notified_.push_back(o);
+            }
+            try {
+                o->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        {
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            #endif
+            for (Size i=0; i<notified_.size(); ++i) {
+                if (notified_[i])
+                    notified_[i]->deferState_ = Idle;
+            }
+            notified_.clear();
+            updatesDeferred_ = false;
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+}
+
 #endif
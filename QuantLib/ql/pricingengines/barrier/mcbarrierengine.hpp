@@ -98,7 +98,16 @@ namespace QuantLib {
                          new path_generator_type(process_,
                                                  grid, gen, brownianBridge_));
         }
-        boost::shared_ptr<path_pricer_type> pathPricer() const;
+        boost::shared_ptr<path_pricer_type> pathPricer() const {
+            return pathPricer(5);
+        }
+        // a different bridge seed for each stream
+        boost::shared_ptr<path_pricer_type> streamPathPricer(
+                                                     Size stream) const {
+            return pathPricer(5 + stream);
+        }
+        boost::shared_ptr<path_pricer_type> pathPricer(
+                                               BigNatural bridgeSeed) const;
         // data members
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -233,7 +242,7 @@ namespace QuantLib {
     template <class RNG, class S>
     inline
     boost::shared_ptr<typename MCBarrierEngine<RNG,S>::path_pricer_type>
-    MCBarrierEngine<RNG,S>::pathPricer() const {
+    MCBarrierEngine<RNG,S>::pathPricer(BigNatural bridgeSeed) const {
         boost::shared_ptr<PlainVanillaPayoff> payoff =
             boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non-plain payoff given");
@@ -256,7 +265,7 @@ namespace QuantLib {
                        discounts));
         } else {
             PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                                PseudoRandom::urng_type(5));
+                                         PseudoRandom::urng_type(bridgeSeed));
             return boost::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BarrierPathPricer(
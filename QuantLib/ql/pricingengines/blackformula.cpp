@@ -449,6 +449,238 @@ namespace QuantLib {
                                      stdDev, discount, displacement);
     }
 
+    namespace {
+
+        Size checkBatch(const Array& strikes, const Array& forwards,
+                        const Array& values, const Array& discounts,
+                        Real displacement) {
+            Size n = strikes.size();
+            QL_REQUIRE(forwards.size() == n && values.size() == n &&
+                       discounts.size() == n,
+                       "size mismatch between strikes (" << n <<
+                       "), forwards (" << forwards.size() <<
+                       "), values (" << values.size() <<
+                       ") and discounts (" << discounts.size() << ")");
+            for (Size i=0; i<n; ++i) {
+                checkParameters(strikes[i], forwards[i], displacement);
+                QL_REQUIRE(values[i]>=0.0,
+                           "value (" << values[i] << ") at index " << i
+                           << " must be non-negative");
+                QL_REQUIRE(discounts[i]>0.0,
+                           "discount (" << discounts[i] << ") at index " << i
+                           << " must be positive");
+            }
+            return n;
+        }
+
+        // West (2005), double precision. Both branches are evaluated
+        // so that the test can be compiled into a select; the argument
+        // is capped where the result underflows anyway.
+        inline Real normalCdf(Real x) {
+            Real a = std::min(std::fabs(x), 40.0);
+            Real e = std::exp(-0.5*a*a);
+            Real num = (((((( 3.52624965998911e-02*a
+                             + 0.700383064443688)*a
+                             + 6.37396220353165)*a
+                             + 33.912866078383)*a
+                             + 112.079291497871)*a
+                             + 221.213596169931)*a
+                             + 220.206867912376);
+            Real den = ((((((( 8.83883476483184e-02*a
+                              + 1.75566716318264)*a
+                              + 16.064177579207)*a
+                              + 86.7807322029461)*a
+                              + 296.564248779674)*a
+                              + 637.333633378831)*a
+                              + 793.826512519948)*a
+                              + 440.413735824752);
+            Real b = a + 0.65;
+            b = a + 4.0/b;
+            b = a + 3.0/b;
+            b = a + 2.0/b;
+            b = a + 1.0/b;
+            Real tail = (a < 7.07106781186547) ? e*num/den
+                                               : e/(2.506628274631*b);
+            return (x > 0.0) ? 1.0-tail : tail;
+        }
+
+        inline Real normalDensity(Real x) {
+            return M_SQRT_2*M_1_SQRTPI*std::exp(-0.5*x*x);
+        }
+
+        // normalized out-of-the-money price, x = -|ln(F/K)| <= 0
+        inline Real normalizedBlack(Real x, Real s) {
+            s = std::max(s, QL_MIN_POSITIVE_REAL);
+            Real d1 = x/s + 0.5*s, ex = std::exp(0.5*x);
+            return ex*normalCdf(d1) - normalCdf(d1-s)/ex;
+        }
+
+        // beta >= 0 is checked by the caller; a null result is
+        // returned when the iteration doesn't converge
+        Real normalizedImpliedStdDev(Real x, Real beta, Real guess,
+                                     Real accuracy, Size maxIterations) {
+            if (beta == 0.0)
+                return 0.0;
+            Real ex = std::exp(0.5*x);
+            // above the normalized forward, there's no solution
+            if (beta >= ex)
+                return Null<Real>();
+
+            // below the inflection point, the price is convex in the
+            // standard deviation and it is better to iterate on its
+            // logarithm
+            Real sc = std::sqrt(2.0*std::fabs(x));
+            bool lower = (beta < normalizedBlack(x, sc));
+            Real lnBeta = std::log(beta);
+
+            // given or Corrado-Miller guess, kept in the right region
+            Real s = guess;
+            if (s == Null<Real>() || s <= 0.0) {
+                Real m = ex - 1.0/ex;
+                Real t = beta - 0.5*m;
+                s = M_SQRT2*M_SQRTPI*(t + std::sqrt(std::max(
+                                  t*t - m*m/M_PI, 0.0)))/(ex + 1.0/ex);
+            }
+            if (lower)
+                s = std::min(std::max(s, std::fabs(x)/std::sqrt(-2.0*lnBeta)),
+                             sc);
+            else
+                s = std::max(s, sc);
+
+            Real x2 = x*x;
+            for (Size i=0; i<maxIterations; ++i) {
+                Real d1 = x/s + 0.5*s;
+                Real b = ex*normalCdf(d1) - normalCdf(d1-s)/ex;
+                Real db = ex*normalDensity(d1);
+                Real h2 = x2/(s*s*s) - 0.25*s;
+                Real h3 = h2*h2 - 3.0*x2/(s*s*s*s) - 0.25;
+                Real nu;
+                if (lower) {
+                    Real r = db/b;
+                    nu = (lnBeta - std::log(b))/r;
+                    h3 -= r*(3.0*h2 - 2.0*r);
+                    h2 -= r;
+                } else {
+                    nu = (beta - b)/db;
+                }
+                Real next = s + nu*(1.0 + 0.5*h2*nu)
+                                  /(1.0 + nu*(h2 + h3*nu/6.0));
+                // keep the iterate positive
+                next = std::max(next, 0.5*s);
+                if (std::fabs(next - s) <= accuracy)
+                    return next;
+                s = next;
+            }
+            return Null<Real>();
+        }
+
+    }
+
+    void blackFormula(Option::Type optionType,
+                      const Array& strikes,
+                      const Array& forwards,
+                      const Array& stdDevs,
+                      const Array& discounts,
+                      Array& results,
+                      Real displacement) {
+        Size n = checkBatch(strikes, forwards, stdDevs, discounts,
+                            displacement);
+        if (results.size() != n)
+            results = Array(n);
+
+        const Real w = optionType;
+        for (Size i=0; i<n; ++i) {
+            Real f = forwards[i] + displacement, k = strikes[i] + displacement;
+            Real s = std::max(stdDevs[i], QL_MIN_POSITIVE_REAL);
+            Real d1 = std::log(f/k)/s + 0.5*s, d2 = d1 - s;
+            Real value = discounts[i]*w*(f*normalCdf(w*d1)
+                                         - k*normalCdf(w*d2));
+            results[i] = std::max(value, 0.0);
+        }
+    }
+
+    void blackFormulaGreeks(Option::Type optionType,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& stdDevs,
+                            const Array& discounts,
+                            Array& deltas,
+                            Array& gammas,
+                            Array& vegas,
+                            Real displacement) {
+        Size n = checkBatch(strikes, forwards, stdDevs, discounts,
+                            displacement);
+        if (deltas.size() != n)
+            deltas = Array(n);
+        if (gammas.size() != n)
+            gammas = Array(n);
+        if (vegas.size() != n)
+            vegas = Array(n);
+
+        const Real w = optionType;
+        for (Size i=0; i<n; ++i) {
+            Real f = forwards[i] + displacement, k = strikes[i] + displacement;
+            Real s = std::max(stdDevs[i], QL_MIN_POSITIVE_REAL);
+            Real d1 = std::log(f/k)/s + 0.5*s;
+            Real phi = discounts[i]*normalDensity(d1);
+            deltas[i] = discounts[i]*w*normalCdf(w*d1);
+            gammas[i] = phi/(f*s);
+            vegas[i] = (stdDevs[i] > 0.0) ? phi*f : 0.0;
+        }
+    }
+
+    Size blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const Array& strikes,
+                                   const Array& forwards,
+                                   const Array& blackPrices,
+                                   const Array& discounts,
+                                   Array& results,
+                                   Real displacement,
+                                   const Array& guesses,
+                                   Real accuracy,
+                                   Natural maxIterations) {
+        Size n = checkBatch(strikes, forwards, blackPrices, discounts,
+                            displacement);
+        QL_REQUIRE(guesses.empty() || guesses.size() == n,
+                   "size mismatch between strikes (" << n <<
+                   ") and guesses (" << guesses.size() << ")");
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(strikes[i] + displacement > 0.0,
+                       "strike + displacement (" << strikes[i] << " + "
+                       << displacement << ") at index " << i
+                       << " must be positive");
+        if (results.size() != n)
+            results = Array(n);
+
+        const Real w = optionType;
+        Size failures = 0;
+        for (Size i=0; i<n; ++i) {
+            Real f = forwards[i] + displacement, k = strikes[i] + displacement;
+            Real sqrtFK = std::sqrt(f*k);
+            Real intrinsic = std::max(w*(f-k), 0.0);
+            // by put-call parity, the time value is the price of
+            // the out-of-the-money option
+            Real timeValue = blackPrices[i]/discounts[i] - intrinsic;
+            // prices at the intrinsic value might be slightly below
+            // it because of rounding
+            if (timeValue < 0.0 && timeValue > -1.0e-12*std::max(f, k))
+                timeValue = 0.0;
+            QL_REQUIRE(timeValue >= 0.0,
+                       "option price (" << blackPrices[i] << ") at index "
+                       << i << " is below the discounted intrinsic value ("
+                       << intrinsic*discounts[i] << "). No solution exists for "
+                       << optionType << " strike " << strikes[i]
+                       << ", forward " << forwards[i]);
+            Real x = -std::fabs(std::log(f/k));
+            Real guess = guesses.empty() ? Null<Real>() : guesses[i];
+            results[i] = normalizedImpliedStdDev(x, timeValue/sqrtFK, guess,
+                                                 accuracy, maxIterations);
+            if (results[i] == Null<Real>())
+                ++failures;
+        }
+        return failures;
+    }
+
     Real bachelierBlackFormula(Option::Type optionType,
                                Real strike,
                                Real forward,
@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
 
@@ -230,6 +231,81 @@ namespace QuantLib {
                         Real discount = 1.0,
                         Real displacement = 0.0);
 
+    /*! Black 1976 formula for a batch of options of the same type.
+
+        The i-th result is the price of the option with the i-th
+        strike, forward, standard deviation and discount; the
+        results array is resized if needed. All inputs are checked
+        before any calculation, after which the loop has no
+        data-dependent branches so that it can be vectorized by the
+        compiler; the normal distribution is evaluated by means of
+        the double-precision algorithm in West, "Better
+        approximations to cumulative normal functions", Wilmott
+        Magazine (2005).
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormula(Option::Type optionType,
+                      const Array& strikes,
+                      const Array& forwards,
+                      const Array& stdDevs,
+                      const Array& discounts,
+                      Array& results,
+                      Real displacement = 0.0);
+
+    /*! Black 1976 sensitivities for a batch of options of the same
+        type, i.e., the derivatives of the price with respect to the
+        forward (first and second order) and to the standard
+        deviation. See the batch version of blackFormula for details.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity); the returned
+                 vegas are the derivatives with respect to the
+                 standard deviation.
+    */
+    void blackFormulaGreeks(Option::Type optionType,
+                            const Array& strikes,
+                            const Array& forwards,
+                            const Array& stdDevs,
+                            const Array& discounts,
+                            Array& deltas,
+                            Array& gammas,
+                            Array& vegas,
+                            Real displacement = 0.0);
+
+    /*! Black 1976 implied standard deviation for a batch of options
+        of the same type.
+
+        The price of the out-of-the-money option is normalized as in
+        Jaeckel, "Let's be rational", Wilmott Magazine (2015), and
+        the standard deviation is found by a few third-order
+        Householder iterations starting from the Corrado-Miller
+        approximation; in the region where the normalized price is
+        convex in the standard deviation, the iterations are
+        performed on its logarithm. If guesses are passed, they
+        replace the Corrado-Miller approximation as starting points.
+
+        Options for which the iteration doesn't converge within the
+        given number of steps, or for which no solution exists since
+        the price is above the discounted forward, are set to
+        Null<Real>(); their number is returned so that the caller
+        can handle them, e.g., with the scalar version.
+
+        \pre strikes + displacement must be positive
+        \pre prices must not be below the discounted intrinsic value
+    */
+    Size blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const Array& strikes,
+                                   const Array& forwards,
+                                   const Array& blackPrices,
+                                   const Array& discounts,
+                                   Array& results,
+                                   Real displacement = 0.0,
+                                   const Array& guesses = Array(),
+                                   Real accuracy = 1.0e-12,
+                                   Natural maxIterations = 32);
+
     /*! Black style formula when forward is normal rather than
         log-normal. This is essentially the model of Bachelier.
 
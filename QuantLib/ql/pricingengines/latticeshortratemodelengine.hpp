@@ -27,12 +27,18 @@
 
 #include <ql/models/model.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
-        method
+        method.
+
+        The presentValues() method can be used to price a book of
+        instruments sharing the same model on a single lattice; the
+        corresponding discretized assets (e.g., DiscretizedSwaption,
+        DiscretizedCapFloor) are built from the instrument arguments.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -48,6 +54,14 @@ namespace QuantLib {
                                const boost::shared_ptr<ShortRateModel>& model,
                                const TimeGrid& timeGrid);
         void update();
+        /*! Initializes each asset at the latest of its mandatory
+            times, rolls all of them back together to the present and
+            returns their present values.  The lattice passed to the
+            constructor is used if available; otherwise, a lattice is
+            built on the mandatory times of all the assets.
+        */
+        std::vector<Real> presentValues(
+            const std::vector<boost::shared_ptr<DiscretizedAsset> >&) const;
       protected:
         TimeGrid timeGrid_;
         Size timeSteps_;
@@ -93,6 +107,44 @@ namespace QuantLib {
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
 
+    template <class Arguments, class Results>
+    std::vector<Real>
+    LatticeShortRateModelEngine<Arguments, Results>::presentValues(
+        const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets) const {
+
+        QL_REQUIRE(!this->model_.empty(), "no model specified");
+
+        std::vector<Real> values(assets.size());
+        if (assets.empty())
+            return values;
+
+        std::vector<Time> times, lastTimes(assets.size());
+        for (Size k=0; k<assets.size(); ++k) {
+            std::vector<Time> assetTimes = assets[k]->mandatoryTimes();
+            QL_REQUIRE(!assetTimes.empty(),
+                       "no mandatory times given for asset #" << k+1);
+            lastTimes[k] = *std::max_element(assetTimes.begin(),
+                                             assetTimes.end());
+            times.insert(times.end(), assetTimes.begin(), assetTimes.end());
+        }
+
+        boost::shared_ptr<Lattice> lattice;
+        if (lattice_) {
+            lattice = lattice_;
+        } else {
+            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
+            lattice = this->model_->tree(timeGrid);
+        }
+
+        for (Size k=0; k<assets.size(); ++k)
+            assets[k]->initialize(lattice, lastTimes[k]);
+        lattice->rollback(assets, 0.0);
+
+        for (Size k=0; k<assets.size(); ++k)
+            values[k] = assets[k]->presentValue();
+        return values;
+    }
+
 }
 
 
@@ -28,6 +28,9 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace QuantLib {
 
@@ -37,6 +40,16 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        When OpenMP is enabled, the calculate() method draws the
+        samples from one stream per available thread, each one with
+        its own path pricer as returned by streamPathPricer() (and
+        controlPathPricer() if needed); see MonteCarloModel for
+        details.
+
+        Engines whose path pricers can also price blocks of paths can
+        return them from blockPathPricer(); the samples drawn serially
+        are then priced in blocks.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -49,6 +62,8 @@ namespace QuantLib {
         typedef typename MonteCarloModel<MC,RNG,S>::stats_type
             stats_type;
         typedef typename MonteCarloModel<MC,RNG,S>::result_type result_type;
+        typedef typename MonteCarloModel<MC,RNG,S>::block_pricer_type
+            block_pricer_type;
 
         virtual ~McSimulation() {}
         //! add samples until the required absolute tolerance is reached
@@ -74,6 +89,20 @@ namespace QuantLib {
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
         virtual TimeGrid timeGrid() const = 0;
+        /*! path pricer for the given stream. Engines whose path
+            pricers draw random numbers of their own should override
+            this so that the streams don't share them.
+        */
+        virtual boost::shared_ptr<path_pricer_type>
+        streamPathPricer(Size) const {
+            return pathPricer();
+        }
+        /*! path pricer for blocks of paths; it must return the same
+            values as the one returned by pathPricer().
+        */
+        virtual boost::shared_ptr<block_pricer_type> blockPathPricer() const {
+            return boost::shared_ptr<block_pricer_type>();
+        }
         virtual boost::shared_ptr<path_pricer_type> controlPathPricer() const {
             return boost::shared_ptr<path_pricer_type>();
         }
@@ -195,6 +224,29 @@ namespace QuantLib {
                            this->antitheticVariate_));
         }
 
+        boost::shared_ptr<block_pricer_type> blockPricer =
+            this->blockPathPricer();
+        if (blockPricer)
+            this->mcModel_->useBlocks(blockPricer);
+
+        #ifdef _OPENMP
+        if (SplittingTraits<typename RNG::rsg_type>::allowsSplitting) {
+            Size nStreams = omp_get_max_threads();
+            if (nStreams > 1) {
+                std::vector<boost::shared_ptr<path_pricer_type> >
+                    pricers(nStreams), controlPricers;
+                for (Size i=0; i<nStreams; ++i)
+                    pricers[i] = this->streamPathPricer(i);
+                if (this->controlVariate_) {
+                    controlPricers.resize(nStreams);
+                    for (Size i=0; i<nStreams; ++i)
+                        controlPricers[i] = this->controlPathPricer();
+                }
+                this->mcModel_->useStreams(pricers, controlPricers);
+            }
+        }
+        #endif
+
         if (requiredTolerance != Null<Real>()) {
             if (maxSamples != Null<Size>())
                 this->value(requiredTolerance, maxSamples);
@@ -26,11 +26,25 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        // the results for the other strikes are obtained by
+        // homogeneity, which doesn't hold in the presence of a smile
+        bool strikeIndependent(const Handle<BlackVolTermStructure>& vol) {
+            return boost::dynamic_pointer_cast<BlackConstantVol>(*vol)
+                || boost::dynamic_pointer_cast<BlackVarianceCurve>(*vol);
+        }
+
+    }
+
     FdBlackScholesVanillaEngine::FdBlackScholesVanillaEngine(
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
             Size tGrid, Size xGrid, Size dampingSteps, 
@@ -47,17 +61,59 @@ namespace QuantLib {
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        // 0. Cache lookup for precalculated results
+        for (Size i=0; i < cachedArgs2results_.size(); ++i) {
+            if (   cachedArgs2results_[i].first.exercise->type()
+                        == arguments_.exercise->type()
+                && cachedArgs2results_[i].first.exercise->dates()
+                        == arguments_.exercise->dates()) {
+                boost::shared_ptr<PlainVanillaPayoff> p1 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                boost::shared_ptr<PlainVanillaPayoff> p2 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                          cachedArgs2results_[i].first.payoff);
+
+                if (p1 && p1->strike()     == p2->strike()
+                       && p1->optionType() == p2->optionType()) {
+                    QL_REQUIRE(arguments_.cashFlow.empty(),
+                               "multiple strikes engine does "
+                               "not work with discrete dividends");
+                    results_ = cachedArgs2results_[i].second;
+                    return;
+                }
+            }
+        }
+
         // 1. Mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
         const Time maturity = process_->time(arguments_.exercise->lastDate());
-        const boost::shared_ptr<Fdm1dMesher> equityMesher(
-            new FdmBlackScholesMesher(
-                    xGrid_, process_, maturity, payoff->strike(), 
-                    Null<Real>(), Null<Real>(), 0.0001, 1.5, 
+
+        // the other strikes are only priced along with plain vanillas,
+        // and only when they can be read from the same solution
+        const bool multipleStrikes = !strikes_.empty()
+            && boost::dynamic_pointer_cast<PlainVanillaPayoff>(payoff)
+            && !localVol_ && strikeIndependent(process_->blackVolatility());
+
+        boost::shared_ptr<Fdm1dMesher> equityMesher;
+        if (!multipleStrikes) {
+            equityMesher = boost::shared_ptr<Fdm1dMesher>(
+                new FdmBlackScholesMesher(
+                    xGrid_, process_, maturity, payoff->strike(),
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
                     std::pair<Real, Real>(payoff->strike(), 0.1)));
-        
+        }
+        else {
+            QL_REQUIRE(arguments_.cashFlow.empty(),"multiple strikes engine "
+                       "does not work with discrete dividends");
+            equityMesher = boost::shared_ptr<Fdm1dMesher>(
+                new FdmBlackScholesMultiStrikeMesher(
+                    xGrid_, process_, maturity, strikes_, 0.0001, 1.5,
+                    std::pair<Real, Real>(payoff->strike(), 0.075)));
+        }
+
         const boost::shared_ptr<FdmMesher> mesher (
             new FdmMesherComposite(equityMesher));
         
@@ -91,5 +147,37 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
+
+        // 6. Results for the other strikes; the value is homogeneous
+        //    of degree one in spot and strike
+        if (!multipleStrikes)
+            return;
+
+        cachedArgs2results_.resize(strikes_.size());
+        for (Size i=0; i < strikes_.size(); ++i) {
+            cachedArgs2results_[i].first.exercise = arguments_.exercise;
+            cachedArgs2results_[i].first.payoff =
+                boost::shared_ptr<PlainVanillaPayoff>(
+                    new PlainVanillaPayoff(payoff->optionType(), strikes_[i]));
+            const Real d = payoff->strike()/strikes_[i];
+
+            DividendVanillaOption::results&
+                                results = cachedArgs2results_[i].second;
+            results.value = solver->valueAt(spot*d)/d;
+            results.delta = solver->deltaAt(spot*d);
+            results.gamma = solver->gammaAt(spot*d)*d;
+            results.theta = solver->thetaAt(spot*d)/d;
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        DividendVanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
     }
 }
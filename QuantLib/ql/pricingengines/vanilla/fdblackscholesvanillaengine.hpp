@@ -54,12 +54,38 @@ namespace QuantLib {
 
         void calculate() const;
 
+        // multiple strikes caching engine
+        void update();
+        /*! Prices the given strikes together with the plain-vanilla
+            option being priced. The values of European and American
+            options with the same exercise and option type are then
+            read from the same solution by scaling the spot, and later
+            calculations for these strikes are served from the cache.
+            Other payoffs are priced as usual and don't fill the cache.
+
+            \note the scaling is only exact when the Black volatility
+                  doesn't depend on the strike, i.e., when it is a
+                  BlackConstantVol or a BlackVarianceCurve, and local
+                  volatility is not used. In any other case, the
+                  strikes passed here are ignored: each option is
+                  priced with its own solve, as if caching were not
+                  enabled.
+
+            \pre discrete dividends are not supported.
+        */
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
       private:
         const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+
+        std::vector<Real> strikes_;
+        mutable std::vector<std::pair<DividendVanillaOption::arguments,
+                                      DividendVanillaOption::results> >
+                                                            cachedArgs2results_;
     };
 }
 
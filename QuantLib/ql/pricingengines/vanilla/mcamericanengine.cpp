@@ -37,6 +37,8 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType)
     : scalingValue_(1.0),
       payoff_      (payoff),
+      polynomOrder_(polynomOrder),
+      polynomType_ (polynomType),
       v_           (LsmBasisSystem::pathBasisSystem(polynomOrder,
                                                     polynomType)) {
 
@@ -78,4 +80,20 @@ namespace QuantLib {
         return v_;
     }
 
+    Disposable<Matrix> AmericanPathPricer::basisValues(
+                                    const std::vector<Real>& states) const {
+        const Matrix polynoms =
+            LsmBasisSystem::pathBasisValues(polynomOrder_, polynomType_,
+                                            states);
+
+        // the polynomials plus the payoff as additional basis function
+        Matrix values(states.size(), polynomOrder_+2);
+        for (Size k=0; k<states.size(); ++k) {
+            std::copy(polynoms.row_begin(k), polynoms.row_end(k),
+                      values.row_begin(k));
+            values[k][polynomOrder_+1] = payoff(states[k]);
+        }
+        return values;
+    }
+
 }
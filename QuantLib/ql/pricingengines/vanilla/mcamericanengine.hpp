@@ -88,12 +88,15 @@ namespace QuantLib {
         Real operator()(const Path& path, Size t) const;
 
         std::vector<boost::function1<Real, Real> > basisSystem() const;
+        Disposable<Matrix> basisValues(const std::vector<Real>& states) const;
 
       protected:
         Real payoff(Real state) const;
 
         Real scalingValue_;
         const boost::shared_ptr<Payoff> payoff_;
+        const Size polynomOrder_;
+        const LsmBasisSystem::PolynomType polynomType_;
         std::vector<boost::function1<Real, Real> > v_;
     };
 
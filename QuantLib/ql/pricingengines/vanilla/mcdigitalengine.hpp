@@ -80,7 +80,16 @@ namespace QuantLib {
                     BigNatural seed);
       protected:
         // McSimulation implementation
-        boost::shared_ptr<path_pricer_type> pathPricer() const;
+        boost::shared_ptr<path_pricer_type> pathPricer() const {
+            return pathPricer(76);
+        }
+        // a different bridge seed for each stream
+        boost::shared_ptr<path_pricer_type> streamPathPricer(
+                                                     Size stream) const {
+            return pathPricer(76 + stream);
+        }
+        boost::shared_ptr<path_pricer_type> pathPricer(
+                                               BigNatural bridgeSeed) const;
     };
 
     //! Monte Carlo digital engine factory
@@ -155,7 +164,7 @@ namespace QuantLib {
     template <class RNG, class S>
     inline
     boost::shared_ptr<typename MCDigitalEngine<RNG,S>::path_pricer_type>
-    MCDigitalEngine<RNG,S>::pathPricer() const {
+    MCDigitalEngine<RNG,S>::pathPricer(BigNatural bridgeSeed) const {
 
         boost::shared_ptr<CashOrNothingPayoff> payoff =
             boost::dynamic_pointer_cast<CashOrNothingPayoff>(
@@ -174,7 +183,7 @@ namespace QuantLib {
 
         TimeGrid grid = this->timeGrid();
         PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                            PseudoRandom::urng_type(76));
+                                        PseudoRandom::urng_type(bridgeSeed));
 
         return boost::shared_ptr<
                         typename MCDigitalEngine<RNG,S>::path_pricer_type>(
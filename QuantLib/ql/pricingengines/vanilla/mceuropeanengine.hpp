@@ -28,6 +28,7 @@
 
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
 
@@ -50,6 +51,9 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename MCVanillaEngine<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef
+        typename MCVanillaEngine<SingleVariate,RNG,S>::block_pricer_type
+            block_pricer_type;
         // constructor
         MCEuropeanEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -63,6 +67,7 @@ namespace QuantLib {
              BigNatural seed);
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        boost::shared_ptr<block_pricer_type> blockPathPricer() const;
     };
 
     //! Monte Carlo European engine factory
@@ -91,12 +96,14 @@ namespace QuantLib {
         BigNatural seed_;
     };
 
-    class EuropeanPathPricer : public PathPricer<Path> {
+    class EuropeanPathPricer : public PathPricer<Path>,
+                               public BlockPathPricer<PathBlock> {
       public:
         EuropeanPathPricer(Option::Type type,
                            Real strike,
                            DiscountFactor discount);
         Real operator()(const Path& path) const;
+        void operator()(const PathBlock& paths, Array& values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -152,6 +159,14 @@ namespace QuantLib {
               process->riskFreeRate()->discount(this->timeGrid().back())));
     }
 
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<typename MCEuropeanEngine<RNG,S>::block_pricer_type>
+    MCEuropeanEngine<RNG,S>::blockPathPricer() const {
+        return boost::dynamic_pointer_cast<EuropeanPathPricer>(
+                                                         this->pathPricer());
+    }
+
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>::MakeMCEuropeanEngine(
@@ -258,6 +273,16 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline void EuropeanPathPricer::operator()(const PathBlock& paths,
+                                               Array& values) const {
+        QL_REQUIRE(paths.length() > 0, "the paths cannot be empty");
+        if (values.size() != paths.size())
+            values = Array(paths.size());
+        Matrix::const_row_iterator last = paths.back();
+        for (Size k=0; k<paths.size(); ++k)
+            values[k] = payoff_(last[k]) * discount_;
+    }
+
 }
 
 
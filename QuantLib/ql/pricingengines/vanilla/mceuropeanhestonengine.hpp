@@ -27,6 +27,7 @@
 
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
+#include <ql/methods/montecarlo/multipathblock.hpp>
 
 namespace QuantLib {
 
@@ -42,6 +43,8 @@ namespace QuantLib {
       public:
         typedef typename MCVanillaEngine<MultiVariate,RNG,S>::path_pricer_type
             path_pricer_type;
+        typedef typename MCVanillaEngine<MultiVariate,RNG,S>::block_pricer_type
+            block_pricer_type;
         MCEuropeanHestonEngine(const boost::shared_ptr<HestonProcess>&,
                                Size timeSteps,
                                Size timeStepsPerYear,
@@ -52,6 +55,7 @@ namespace QuantLib {
                                BigNatural seed);
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        boost::shared_ptr<block_pricer_type> blockPathPricer() const;
     };
 
     //! Monte Carlo Heston European engine factory
@@ -78,12 +82,14 @@ namespace QuantLib {
     };
 
 
-    class EuropeanHestonPathPricer : public PathPricer<MultiPath> {
+    class EuropeanHestonPathPricer : public PathPricer<MultiPath>,
+                                     public BlockPathPricer<MultiPathBlock> {
       public:
         EuropeanHestonPathPricer(Option::Type type,
                                  Real strike,
                                  DiscountFactor discount);
         Real operator()(const MultiPath& Multipath) const;
+        void operator()(const MultiPathBlock& paths, Array& values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -127,6 +133,14 @@ namespace QuantLib {
                                                    this->timeGrid().back())));
     }
 
+    template <class RNG, class S>
+    inline boost::shared_ptr<
+        typename MCEuropeanHestonEngine<RNG,S>::block_pricer_type>
+    MCEuropeanHestonEngine<RNG,S>::blockPathPricer() const {
+        return boost::dynamic_pointer_cast<EuropeanHestonPathPricer>(
+                                                         this->pathPricer());
+    }
+
 
 
     template <class RNG, class S>
@@ -233,6 +247,18 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline void EuropeanHestonPathPricer::operator()(
+                                               const MultiPathBlock& paths,
+                                               Array& values) const {
+        const PathBlock& block = paths[0];
+        QL_REQUIRE(block.length() > 0, "the paths cannot be empty");
+        if (values.size() != block.size())
+            values = Array(block.size());
+        Matrix::const_row_iterator last = block.back();
+        for (Size k=0; k<block.size(); ++k)
+            values[k] = payoff_(last[k]) * discount_;
+    }
+
 }
 
 
@@ -55,6 +55,8 @@ namespace QuantLib {
             stats_type;
         typedef typename McSimulation<MC,RNG,S>::result_type
             result_type;
+        typedef typename McSimulation<MC,RNG,S>::block_pricer_type
+            block_pricer_type;
         // constructor
         MCVanillaEngine(const boost::shared_ptr<StochasticProcess>&,
                         Size timeSteps,
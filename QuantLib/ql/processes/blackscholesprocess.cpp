@@ -20,6 +20,8 @@
 */
 
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/eulerdiscretization.hpp>
+#include <ql/processes/endeulerdiscretization.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolcurve.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
@@ -37,7 +39,7 @@ namespace QuantLib {
              const boost::shared_ptr<discretization>& disc)
     : StochasticProcess1D(disc), x0_(x0), riskFreeRate_(riskFreeTS),
       dividendYield_(dividendTS), blackVolatility_(blackVolTS),
-      updated_(false) {
+      updated_(false), isStrikeIndependent_(false) {
         registerWith(x0_);
         registerWith(riskFreeRate_);
         registerWith(dividendYield_);
@@ -78,6 +80,30 @@ namespace QuantLib {
                          stdDeviation(t0,x0,dt)*dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBlock(Time t0,
+                                                     const Array& x0,
+                                                     Time dt,
+                                                     const Array& dw,
+                                                     Array& x) const {
+        QL_REQUIRE(dw.size() == x0.size() && x.size() == x0.size(),
+                   "block sizes do not match");
+        localVolatility(); // trigger update
+        bool euler =
+            boost::dynamic_pointer_cast<EulerDiscretization>(discretization_)
+         || boost::dynamic_pointer_cast<EndEulerDiscretization>(
+                                                             discretization_);
+        if (!isStrikeIndependent_ || !euler || x0.empty()) {
+            StochasticProcess1D::evolveBlock(t0, x0, dt, dw, x);
+            return;
+        }
+
+        // drift and diffusion don't depend on the asset value
+        const Real drift = discretization_->drift(*this,t0,x0[0],dt);
+        const Real stdDev = stdDeviation(t0,x0[0],dt);
+        for (Size k=0; k<x0.size(); ++k)
+            x[k] = x0[k] * std::exp(drift + stdDev*dw[k]);
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
@@ -124,6 +150,7 @@ namespace QuantLib {
                                          constVol->blackVol(0.0, x0_->value()),
                                          constVol->dayCounter())));
                 updated_ = true;
+                isStrikeIndependent_ = true;
                 return localVolatility_;
             }
 
@@ -138,6 +165,7 @@ namespace QuantLib {
                         new LocalVolCurve(
                                       Handle<BlackVarianceCurve>(volCurve))));
                 updated_ = true;
+                isStrikeIndependent_ = true;
                 return localVolatility_;
             }
 
@@ -147,6 +175,7 @@ namespace QuantLib {
                           new LocalVolSurface(blackVolatility_, riskFreeRate_,
                                               dividendYield_, x0_->value())));
             updated_ = true;
+            isStrikeIndependent_ = false;
             return localVolatility_;
 
         } else {
@@ -67,6 +67,12 @@ namespace QuantLib {
         */
         Real expectation(Time t0, Real x0, Time dt) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! if the local volatility doesn't depend on the asset value
+            and an Euler discretization is used, drift and diffusion
+            are calculated once for the whole block.
+        */
+        void evolveBlock(Time t0, const Array& x0,
+                         Time dt, const Array& dw, Array& x) const;
         //@}
         Time time(const Date&) const;
         //! \name Observer interface
@@ -86,7 +92,7 @@ namespace QuantLib {
         Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
         Handle<BlackVolTermStructure> blackVolatility_;
         mutable RelinkableHandle<LocalVolTermStructure> localVolatility_;
-        mutable bool updated_;
+        mutable bool updated_, isStrikeIndependent_;
     };
 
     //! Black-Scholes (1973) stochastic process
@@ -503,6 +503,137 @@ namespace QuantLib {
         return retVal;
     }
 
+    void HestonProcess::evolveBlock(Time t0, const Matrix& x0,
+                                    Time dt, const Matrix& dw,
+                                    Matrix& x) const {
+        switch (discretization_) {
+          case PartialTruncation:
+          case FullTruncation:
+          case Reflection:
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+            break;
+          default:
+            StochasticProcess::evolveBlock(t0, x0, dt, dw, x);
+            return;
+        }
+
+        QL_REQUIRE(x0.rows() == 2 && dw.rows() == 2
+                   && x.rows() == 2, "2-D block required");
+        QL_REQUIRE(dw.columns() == x0.columns()
+                   && x.columns() == x0.columns(),
+                   "block sizes do not match");
+        QL_REQUIRE(&x != &x0, "in-place evolution not supported");
+
+        const Size n = x0.columns();
+        Matrix::const_row_iterator s0 = x0.row_begin(0), v0 = x0.row_begin(1);
+        Matrix::const_row_iterator dw0 = dw.row_begin(0),
+                                   dw1 = dw.row_begin(1);
+        Matrix::row_iterator s = x.row_begin(0), v = x.row_begin(1);
+
+        // the same for all paths
+        const Rate rate =
+              riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+            - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+        const Real sdt = std::sqrt(dt);
+        const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
+
+        switch (discretization_) {
+          case PartialTruncation:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = (v0[k] > 0.0) ? std::sqrt(v0[k]) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rate - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - v0[k]);
+
+                s[k] = s0[k] * std::exp(mu*dt+vol*dw0[k]*sdt);
+                v[k] = v0[k] + nu*dt + vol2*sdt*(rho_*dw0[k] + sqrhov*dw1[k]);
+            }
+            break;
+          case FullTruncation:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = (v0[k] > 0.0) ? std::sqrt(v0[k]) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rate - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+
+                s[k] = s0[k] * std::exp(mu*dt+vol*dw0[k]*sdt);
+                v[k] = v0[k] + nu*dt + vol2*sdt*(rho_*dw0[k] + sqrhov*dw1[k]);
+            }
+            break;
+          case Reflection:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = std::sqrt(std::fabs(v0[k]));
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rate - 0.5 * vol*vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+
+                s[k] = s0[k]*std::exp(mu*dt+vol*dw0[k]*sdt);
+                v[k] = vol*vol
+                       +nu*dt + vol2*sdt*(rho_*dw0[k] + sqrhov*dw1[k]);
+            }
+            break;
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+          {
+            // see HestonProcess::evolve for details
+            const Real ex = std::exp(-kappa_*dt);
+
+            const Real g1 =  0.5;
+            const Real g2 =  0.5;
+            const Real k0 = -rho_*kappa_*theta_*dt/sigma_;
+            const Real k1 =  g1*dt*(kappa_*rho_/sigma_-0.5)-rho_/sigma_;
+            const Real k2 =  g2*dt*(kappa_*rho_/sigma_-0.5)+rho_/sigma_;
+            const Real k3 =  g1*dt*(1-rho_*rho_);
+            const Real k4 =  g2*dt*(1-rho_*rho_);
+            const Real A  =  k2+0.5*k4;
+            const bool martingale =
+                (discretization_ == QuadraticExponentialMartingale);
+            const CumulativeNormalDistribution N;
+
+            for (Size k=0; k<n; ++k) {
+                const Real m  =  theta_+(v0[k]-theta_)*ex;
+                const Real s2 =  v0[k]*sigma_*sigma_*ex/kappa_*(1-ex)
+                               + theta_*sigma_*sigma_/(2*kappa_)*(1-ex)*(1-ex);
+                const Real psi = s2/(m*m);
+
+                Real k0k = k0;
+                if (psi < 1.5) {
+                    const Real b2 = 2/psi-1+std::sqrt(2/psi*(2/psi-1));
+                    const Real b  = std::sqrt(b2);
+                    const Real a  = m/(1+b2);
+
+                    if (martingale) {
+                        QL_REQUIRE(A < 1/(2*a), "illegal value");
+                        k0k = -A*b2*a/(1-2*A*a)+0.5*std::log(1-2*A*a)
+                              -(k1+0.5*k3)*v0[k];
+                    }
+                    v[k] = a*(b+dw1[k])*(b+dw1[k]);
+                }
+                else {
+                    const Real p = (psi-1)/(psi+1);
+                    const Real beta = (1-p)/m;
+
+                    const Real u = N(dw1[k]);
+
+                    if (martingale) {
+                        QL_REQUIRE(A < beta, "illegal value");
+                        k0k = -std::log(p+beta*(1-p)/(beta-A))
+                              -(k1+0.5*k3)*v0[k];
+                    }
+                    v[k] = ((u <= p) ? 0.0 : std::log((1-p)/(1-u))/beta);
+                }
+
+                s[k] = s0[k]*std::exp(rate*dt + k0k + k1*v0[k] + k2*v[k]
+                                      +std::sqrt(k3*v0[k]+k4*v[k])*dw0[k]);
+            }
+          }
+          break;
+          default:
+            QL_FAIL("unknown discretization schema");
+        }
+    }
+
     const Handle<Quote>& HestonProcess::s0() const {
         return s0_;
     }
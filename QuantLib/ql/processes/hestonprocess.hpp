@@ -71,6 +71,12 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        /*! For the truncation, reflection and quadratic-exponential
+            schemes, the rates and the parameter-dependent terms are
+            calculated once for the whole block.
+        */
+        void evolveBlock(Time t0, const Matrix& x0,
+                         Time dt, const Matrix& dw, Matrix& x) const;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -69,4 +69,20 @@ namespace QuantLib {
         }
     }
 
+    NotificationBatch::NotificationBatch()
+    : outermost_(!ObservableSettings::instance().updatesDeferred()) {
+        if (outermost_)
+            ObservableSettings::instance().deferUpdates();
+    }
+
+    NotificationBatch::~NotificationBatch() {
+        if (outermost_) {
+            try {
+                ObservableSettings::instance().enableUpdates();
+            } catch (...) {
+                // nothing we can do except bailing out.
+            }
+        }
+    }
+
 }
@@ -128,6 +128,30 @@ namespace QuantLib {
     };
 
 
+    //! helper class to batch observer notifications within a scope
+    /*! Notifications sent while an instance is alive are collected
+        and forwarded when it goes out of scope, so that each
+        observer receives a single update() regardless of how many
+        of its observables changed in the meantime; for instance,
+        \code
+        {
+            NotificationBatch batch;
+            for (Size i=0; i<quotes.size(); ++i)
+                quotes[i]->setValue(values[i]);
+        } // observers are updated here
+        \endcode
+        Nested batches are merged into the outermost one. See
+        ObservableSettings for details.
+    */
+    class NotificationBatch : private boost::noncopyable {
+      public:
+        NotificationBatch();
+        ~NotificationBatch();
+      private:
+        bool outermost_;
+    };
+
+
     // inline
 
     inline Settings::DateProxy::operator Date() const {
@@ -59,6 +59,21 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess::evolveBlock(Time t0, const Matrix& x0,
+                                        Time dt, const Matrix& dw,
+                                        Matrix& x) const {
+        QL_REQUIRE(dw.columns() == x0.columns() &&
+                   x.rows() == x0.rows() && x.columns() == x0.columns(),
+                   "block sizes do not match");
+        Array x0k(x0.rows()), dwk(dw.rows());
+        for (Size k=0; k<x0.columns(); ++k) {
+            std::copy(x0.column_begin(k), x0.column_end(k), x0k.begin());
+            std::copy(dw.column_begin(k), dw.column_end(k), dwk.begin());
+            const Array xk = evolve(t0, x0k, dt, dwk);
+            std::copy(xk.begin(), xk.end(), x.column_begin(k));
+        }
+    }
+
     Disposable<Array> StochasticProcess::apply(const Array& x0,
                                                const Array& dx) const {
         return x0 + dx;
@@ -98,6 +113,28 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess1D::evolveBlock(Time t0, const Array& x0,
+                                          Time dt, const Array& dw,
+                                          Array& x) const {
+        QL_REQUIRE(dw.size() == x0.size() && x.size() == x0.size(),
+                   "block sizes do not match");
+        for (Size k=0; k<x0.size(); ++k)
+            x[k] = evolve(t0, x0[k], dt, dw[k]);
+    }
+
+    void StochasticProcess1D::evolveBlock(Time t0, const Matrix& x0,
+                                          Time dt, const Matrix& dw,
+                                          Matrix& x) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(x0.rows() == 1, "1-D block required");
+        QL_REQUIRE(dw.rows() == 1, "1-D block required");
+        #endif
+        Array x0k(x0.row_begin(0), x0.row_end(0)),
+              dwk(dw.row_begin(0), dw.row_end(0)), xk(x0.columns());
+        evolveBlock(t0, x0k, dt, dwk, xk);
+        std::copy(xk.begin(), xk.end(), x.row_begin(0));
+    }
+
     Real StochasticProcess1D::apply(Real x0, Real dx) const {
         return x0 + dx;
     }
@@ -123,6 +123,20 @@ namespace QuantLib {
                                          const Array& x0,
                                          Time dt,
                                          const Array& dw) const;
+        /*! evolves a block of asset values at once.  Each column of
+            the \f$ x_0 \f$, \f$ \Delta \mathrm{w} \f$ and
+            \f$ \mathrm{x} \f$ matrices holds a state or a vector of
+            variations, so that their rows have the size of the block;
+            \f$ \mathrm{x} \f$ must be sized before the call.  By
+            default, each column is evolved by means of the evolve()
+            method; derived classes can override this method in order
+            to share calculations between columns.
+        */
+        virtual void evolveBlock(Time t0,
+                                 const Matrix& x0,
+                                 Time dt,
+                                 const Matrix& dw,
+                                 Matrix& x) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ \mathrm{x} + \Delta \mathrm{x} \f$.
         */
@@ -216,6 +230,15 @@ namespace QuantLib {
             standard deviation.
         */
         virtual Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! evolves a block of asset values at once; \f$ x \f$ must
+            have the same size as \f$ x_0 \f$ and \f$ \Delta w \f$.
+            By default, it calls evolve() for each value; derived
+            classes can override this method in order to share
+            calculations between values.
+        */
+        virtual void evolveBlock(Time t0, const Array& x0,
+                                 Time dt, const Array& dw,
+                                 Array& x) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ x + \Delta x \f$.
         */
@@ -239,6 +262,8 @@ namespace QuantLib {
                                       Time dt) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        void evolveBlock(Time t0, const Matrix& x0,
+                         Time dt, const Matrix& dw, Matrix& x) const;
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
     };
 
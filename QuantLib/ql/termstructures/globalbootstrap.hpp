@@ -0,0 +1,375 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file globalbootstrap.hpp
+    \brief global Newton bootstrapper for piecewise term structures
+*/
+
+#ifndef quantlib_global_bootstrap_hpp
+#define quantlib_global_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+namespace QuantLib {
+
+    //! Global bootstrapper for piecewise term structures
+    /*! Unlike IterativeBootstrap, which solves for one pillar at a
+        time and loops until convergence when the interpolation is
+        not local, this class solves for all the pillars at once by
+        means of Newton's method on the vector of quote errors of
+        the helpers.
+
+        The Jacobian of the implied quotes with respect to the curve
+        data is calculated by finite differences at the start of the
+        solve and then kept up to date with Broyden's rank-one
+        formula. When the curve is recalculated, e.g., after a change
+        in the quotes, the previous solution and Jacobian are used as
+        a starting point, so that only a few repricings are needed.
+
+        As in IterativeBootstrap, the value at each pillar is kept
+        between the bounds returned by Traits::minValueAfter and
+        Traits::maxValueAfter; Newton steps leading outside them are
+        shortened.
+
+        After the bootstrap, the Jacobian can be inverted to obtain
+        the sensitivities of the curve data to the quotes, e.g., in
+        order to calculate par-rate deltas without rebuilding the
+        curve.
+
+        \warning The helpers must depend on the curve only through
+                 its data, as is the case for all the helpers in the
+                 library.
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against the original inputs.
+        - the Jacobian is tested against the changes in the curve
+          data resulting from moving each quote.
+    */
+    template <class Curve>
+    class GlobalBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        GlobalBootstrap();
+        void setup(Curve* ts);
+        void calculate() const;
+        /*! Derivatives of the implied quotes of the alive helpers,
+            sorted by maturity (rows), with respect to the curve data
+            at the corresponding pillars (columns).
+
+            \pre the curve must have been bootstrapped.
+        */
+        const Matrix& jacobian() const;
+      private:
+        void initialize() const;
+        void solve() const;
+        void setData(const Array& x) const;
+        bool withinBounds(const Array& x) const;
+        void evaluate(const Array& x, Array& errors) const;
+        void calculateJacobian(const Array& x, const Array& errors) const;
+        Curve* ts_;
+        Size n_;
+        mutable bool initialized_, validCurve_, exactJacobian_;
+        mutable Size firstAliveHelper_, alive_;
+        mutable Matrix jacobian_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::GlobalBootstrap()
+    : ts_(0), initialized_(false), validCurve_(false),
+      exactJacobian_(false) {}
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given");
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::initialize() const {
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->latestDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->latestDate() <= firstDate)
+            ++firstAliveHelper_;
+        alive_ = n_-firstAliveHelper_;
+        QL_REQUIRE(alive_>=Interpolator::requiredPoints-1,
+                   "not enough alive instruments: " << alive_ <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+
+        // calculate dates and times
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            dates[i] = ts_->instruments_[j]->latestDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            // check for duplicated maturity
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with maturity " << dates[i]);
+        }
+
+        // the current curve and Jacobian can be used as a starting
+        // point only if their size didn't change
+        if (ts_->data_.size()!=alive_+1 || jacobian_.rows()!=alive_) {
+            validCurve_ = false;
+            jacobian_ = Matrix();
+        }
+        initialized_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculate() const {
+
+        // see IterativeBootstrap::calculate
+        if (!initialized_ || ts_->moving_)
+            initialize();
+
+        // setup helpers
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            // check for valid quote
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(j+1) << " instrument (maturity: " <<
+                       helper->latestDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+
+        try {
+            solve();
+        } catch (std::exception&) {
+            // the previous curve state could have been a bad guess;
+            // let's restart without using it
+            if (!validCurve_)
+                throw;
+            validCurve_ = false;
+            jacobian_ = Matrix();
+            solve();
+        }
+        validCurve_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::solve() const {
+
+        const std::vector<Time>& times = ts_->times_;
+        std::vector<Real>& data = ts_->data_;
+        Real accuracy = ts_->accuracy_;
+
+        if (!validCurve_) {
+            // build the initial guess a pillar at a time
+            data = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
+            for (Size i=1; i<=alive_; ++i) {
+                Real min = Traits::minValueAfter(i, ts_, false,
+                                                 firstAliveHelper_);
+                Real max = Traits::maxValueAfter(i, ts_, false,
+                                                 firstAliveHelper_);
+                Real guess = Traits::guess(i, ts_, false,
+                                           firstAliveHelper_);
+                // adjust guess if needed
+                if (guess>=max)
+                    guess = max - (max-min)/5.0;
+                else if (guess<=min)
+                    guess = min + (max-min)/5.0;
+                Traits::updateGuess(data, guess, i);
+                try {
+                    ts_->interpolation_ = ts_->interpolator_.interpolate(
+                                 times.begin(), times.begin()+i+1, data.begin());
+                } catch (...) {
+                    if (!Interpolator::global)
+                        throw;
+                    // use Linear while the target interpolation
+                    // is not usable yet
+                    ts_->interpolation_ = Linear().interpolate(
+                                 times.begin(), times.begin()+i+1, data.begin());
+                }
+                ts_->interpolation_.update();
+            }
+        }
+        ts_->interpolation_ = ts_->interpolator_.interpolate(times.begin(),
+                                                             times.end(),
+                                                             data.begin());
+
+        Array x(data.begin()+1, data.end()), errors(alive_);
+        evaluate(x, errors);
+        if (jacobian_.rows() != alive_)
+            calculateJacobian(x, errors);
+        Real norm = std::sqrt(DotProduct(errors, errors));
+
+        Size maxIterations = Traits::maxIterations();
+        Array trial(alive_), trialErrors(alive_);
+        for (Size iteration=0; ; ++iteration) {
+
+            // Newton step; the errors are the quotes minus the
+            // implied quotes, hence the sign
+            Array step = qrSolve(jacobian_, errors);
+            Real change = std::fabs(step[0]);
+            for (Size i=1; i<alive_; ++i)
+                change = std::max(change, std::fabs(step[i]));
+
+            // backtrack until the errors decrease; a step that
+            // increases them is never taken
+            const Real fullChange = change;
+            bool accepted = false;
+            Real trialNorm = norm;
+            for (Size k=0; k<20 && !accepted; ++k) {
+                trial = x + step;
+                try {
+                    if (withinBounds(trial)) {
+                        evaluate(trial, trialErrors);
+                        trialNorm = std::sqrt(DotProduct(trialErrors,
+                                                         trialErrors));
+                        accepted = trialNorm < norm ||
+                                   (trialNorm <= norm && change <= accuracy);
+                    }
+                } catch (...) {}
+                if (!accepted) {
+                    step /= 2.0;
+                    change /= 2.0;
+                }
+            }
+
+            if (!accepted && fullChange <= accuracy) {
+                // the Newton step is already below the required
+                // accuracy; keep the current point
+                setData(x);
+                break;
+            }
+
+            if (!accepted) {
+                // an approximate Jacobian might be to blame
+                QL_REQUIRE(!exactJacobian_,
+                           io::ordinal(iteration+1) << " iteration: "
+                           "failed to reduce the error " << norm <<
+                           ", reference date " << ts_->dates_[0]);
+                setData(x);
+                calculateJacobian(x, errors);
+                continue;
+            }
+
+            // Broyden update
+            Array dq = errors - trialErrors;
+            Array residual = dq - jacobian_*step;
+            jacobian_ += outerProduct(residual, step)/DotProduct(step, step);
+            exactJacobian_ = false;
+
+            std::swap(x, trial);
+            std::swap(errors, trialErrors);
+            norm = trialNorm;
+
+            if (change <= accuracy)  // convergence reached
+                break;
+
+            QL_REQUIRE(iteration<maxIterations,
+                       "convergence not reached after " << iteration <<
+                       " iterations; last improvement " << change <<
+                       ", required accuracy " << accuracy);
+        }
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setData(const Array& x) const {
+        for (Size i=0; i<alive_; ++i)
+            Traits::updateGuess(ts_->data_, x[i], i+1);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    bool GlobalBootstrap<Curve>::withinBounds(const Array& x) const {
+        // the bounds for a pillar depend on the previous ones, so
+        // they're checked on the curve data obtained from x
+        setData(x);
+        const std::vector<Real>& data = ts_->data_;
+        for (Size i=1; i<=alive_; ++i) {
+            Real min = Traits::minValueAfter(i, ts_, false,
+                                             firstAliveHelper_);
+            Real max = Traits::maxValueAfter(i, ts_, false,
+                                             firstAliveHelper_);
+            if (data[i] < min || data[i] > max)
+                return false;
+        }
+        return true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::evaluate(const Array& x,
+                                          Array& errors) const {
+        setData(x);
+        for (Size i=0; i<alive_; ++i)
+            errors[i] = ts_->instruments_[firstAliveHelper_+i]->quoteError();
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculateJacobian(
+                                               const Array& x,
+                                               const Array& errors) const {
+        jacobian_ = Matrix(alive_, alive_);
+        Array bumped(x), bumpedErrors(alive_);
+        for (Size j=0; j<alive_; ++j) {
+            Real h = std::sqrt(QL_EPSILON)*std::max(std::fabs(x[j]), 1.0);
+            bumped[j] = x[j] + h;
+            evaluate(bumped, bumpedErrors);
+            for (Size i=0; i<alive_; ++i)
+                jacobian_[i][j] = (errors[i] - bumpedErrors[i])/h;
+            bumped[j] = x[j];
+        }
+        setData(x);
+        exactJacobian_ = true;
+    }
+
+    template <class Curve>
+    const Matrix& GlobalBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped yet");
+        if (!exactJacobian_) {
+            Array x(ts_->data_.begin()+1, ts_->data_.end()), errors(alive_);
+            evaluate(x, errors);
+            calculateJacobian(x, errors);
+        }
+        return jacobian_;
+    }
+
+}
+
+#endif
@@ -32,14 +32,48 @@
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/settings.hpp>
+#include <set>
 
 namespace QuantLib {
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the interpolation is local, the bootstrapper keeps track
+        of the helpers that notified a change since the last
+        calculation; the pillars before the earliest of them are
+        kept, and the others are bootstrapped again using their
+        previous values as a guess. If anything else the curve
+        observes at the time of setup (e.g., its jumps) notified a
+        change, all the pillars are bootstrapped again.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
         typedef typename Curve::interpolator_type Interpolator;
+        typedef typename Traits::helper helper;
+        typedef std::set<const helper*> helper_set;
+        // records the helpers that notified a change
+        class HelperObserver : public Observer {
+          public:
+            HelperObserver(const helper* h,
+                           const boost::shared_ptr<helper_set>& changed)
+            : helper_(h), changed_(changed) {}
+            void update() { changed_->insert(helper_); }
+          private:
+            const helper* helper_;
+            boost::shared_ptr<helper_set> changed_;
+        };
+        // records whether any other input of the curve changed
+        class InputObserver : public Observer {
+          public:
+            InputObserver() : changed_(false) {}
+            void update() { changed_ = true; }
+            bool changed() const { return changed_; }
+            void reset() { changed_ = false; }
+          private:
+            bool changed_;
+        };
+        static void noDeletion(Observer*) {}
       public:
         IterativeBootstrap();
         void setup(Curve* ts);
@@ -54,6 +88,10 @@ namespace QuantLib {
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        std::vector<boost::shared_ptr<HelperObserver> > observers_;
+        boost::shared_ptr<helper_set> changedHelpers_;
+        boost::shared_ptr<InputObserver> inputObserver_;
+        mutable Date evaluationDate_;
     };
 
 
@@ -68,10 +106,32 @@ namespace QuantLib {
 
         ts_ = ts;
         n_ = ts_->instruments_.size();
-        QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given");
         for (Size j=0; j<n_; ++j)
             ts_->registerWith(ts_->instruments_[j]);
 
+        // with a local interpolation, the helpers that change are
+        // tracked so that only the following pillars are bootstrapped
+        // again; a change in any other input of the curve (e.g., its
+        // jumps) requires bootstrapping all of them
+        observers_.clear();
+        changedHelpers_ = boost::shared_ptr<helper_set>(new helper_set);
+        inputObserver_.reset();
+        if (!Interpolator::global) {
+            for (Size j=0; j<n_; ++j) {
+                observers_.push_back(boost::shared_ptr<HelperObserver>(
+                    new HelperObserver(ts_->instruments_[j].get(),
+                                       changedHelpers_)));
+                observers_.back()->registerWith(ts_->instruments_[j]);
+            }
+            inputObserver_ =
+                boost::shared_ptr<InputObserver>(new InputObserver);
+            inputObserver_->registerWithObservables(
+                boost::shared_ptr<Observer>(ts_, noDeletion));
+            for (Size j=0; j<n_; ++j)
+                inputObserver_->unregisterWith(ts_->instruments_[j]);
+        }
+
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
     }
@@ -136,9 +196,31 @@ namespace QuantLib {
         // with evaluation date change.
         // anyway it makes little sense to use date relative helpers with a
         // non-moving curve if the evaluation date changes
+        std::vector<Date> previousDates = ts_->dates_;
         if (!initialized_ || ts_->moving_)
             initialize();
 
+        // first pillar to be bootstrapped; the previous ones can be
+        // kept if neither their helpers, the other inputs of the
+        // curve nor the curve dates changed
+        Size firstPillar = 1;
+        Date today = Settings::instance().evaluationDate();
+        if (validCurve_ && !changedHelpers_->empty() &&
+            inputObserver_ && !inputObserver_->changed() &&
+            today == evaluationDate_ && ts_->dates_ == previousDates) {
+            firstPillar = alive_+1;
+            for (Size j=firstAliveHelper_; j<n_; ++j) {
+                if (changedHelpers_->count(ts_->instruments_[j].get())) {
+                    firstPillar = j-firstAliveHelper_+1;
+                    break;
+                }
+            }
+        }
+        changedHelpers_->clear();
+        if (inputObserver_)
+            inputObserver_->reset();
+        evaluationDate_ = today;
+
         // setup helpers
         for (Size j=firstAliveHelper_; j<n_; ++j) {
             const boost::shared_ptr<typename Traits::helper>& helper =
@@ -165,7 +247,7 @@ namespace QuantLib {
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // bracket root and calculate guess
                 Real min = Traits::minValueAfter(i, ts_, validData,
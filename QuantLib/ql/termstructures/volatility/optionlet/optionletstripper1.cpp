@@ -23,10 +23,8 @@
 #include <ql/termstructures/volatility/optionlet/optionletstripper1.hpp>
 #include <ql/instruments/makecapfloor.hpp>
 #include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
-#include <ql/pricingengines/capfloor/bacheliercapfloorengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/indexes/iborindex.hpp>
-#include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using boost::shared_ptr;
@@ -43,27 +41,39 @@ namespace QuantLib {
             Model model,
             Real displacement)
     : OptionletStripper(termVolSurface, index, discount, model, displacement),
-      volQuotes_(nOptionletTenors_,
-                 std::vector<shared_ptr<SimpleQuote> >(nStrikes_)),
       floatingSwitchStrike_(switchStrike==Null<Rate>() ? true : false),
-      capFlooMatrixNotInitialized_(true),
+      switchStrikeNotInitialized_(true),
       switchStrike_(switchStrike),
       accuracy_(accuracy), maxIter_(maxIter) {
 
+        QL_REQUIRE(model_ == ShiftedLognormal || model_ == Normal,
+                   "unknown model: " << model_);
+
         capFloorPrices_ = Matrix(nOptionletTenors_, nStrikes_);
         optionletPrices_ = Matrix(nOptionletTenors_, nStrikes_);
         capFloorVols_ = Matrix(nOptionletTenors_, nStrikes_);
         Real firstGuess = 0.14;
         optionletStDevs_ = Matrix(nOptionletTenors_, nStrikes_, firstGuess);
-
-        capFloors_ = CapFloorMatrix(nOptionletTenors_);
     }
 
     void OptionletStripper1::performCalculations() const {
 
-        // update dates
         const Date& referenceDate = termVolSurface_->referenceDate();
         const DayCounter& dc = termVolSurface_->dayCounter();
+        const Handle<YieldTermStructure>& discountCurve =
+            discount_.empty() ?
+                iborIndex_->forwardingTermStructure() :
+                discount_;
+        // as in the cap/floor engines: caplets paid before the
+        // settlement are discarded, while those already fixed are
+        // priced at their intrinsic value
+        Date today = Settings::instance().evaluationDate();
+        Date settlement = discountCurve->referenceDate();
+
+        // update dates and collect the caplets of each cap; the caplets
+        // of the i-th cap are those in [firstCaplet[i], firstCaplet[i+1])
+        std::vector<Size> firstCaplet(nOptionletTenors_+1, 0);
+        std::vector<Real> forwards, discounts, sqrtTimes, gearings, spreads;
         shared_ptr<BlackCapFloorEngine> dummy(new
                     BlackCapFloorEngine(// discounting does not matter here
                                         iborIndex_->forwardingTermStructure(),
@@ -83,105 +93,145 @@ namespace QuantLib {
             optionletTimes_[i] = dc.yearFraction(referenceDate,
                                                  optionletDates_[i]);
             atmOptionletRate_[i] = iborIndex_->fixing(optionletDates_[i]);
+
+            const Leg& leg = temp.floatingLeg();
+            for (Size k=0; k<leg.size(); ++k) {
+                shared_ptr<FloatingRateCoupon> coupon =
+                    boost::dynamic_pointer_cast<FloatingRateCoupon>(leg[k]);
+                QL_REQUIRE(coupon, "non-FloatingRateCoupon given");
+                Date paymentDate = coupon->date();
+                if (paymentDate > settlement) {
+                    Real gearing = coupon->gearing();
+                    forwards.push_back(coupon->adjustedFixing());
+                    discounts.push_back(coupon->nominal() * gearing *
+                                        discountCurve->discount(paymentDate) *
+                                        coupon->accrualPeriod());
+                    Date fixingDate = coupon->fixingDate();
+                    sqrtTimes.push_back(fixingDate > today ?
+                        std::sqrt(dc.yearFraction(today, fixingDate)) : 0.0);
+                    gearings.push_back(gearing);
+                    spreads.push_back(coupon->spread());
+                }
+            }
+            firstCaplet[i+1] = forwards.size();
         }
 
-        if (floatingSwitchStrike_ && capFlooMatrixNotInitialized_) {
+        if (floatingSwitchStrike_ && switchStrikeNotInitialized_) {
             Rate averageAtmOptionletRate = 0.0;
             for (Size i=0; i<nOptionletTenors_; ++i) {
                 averageAtmOptionletRate += atmOptionletRate_[i];
             }
             switchStrike_ = averageAtmOptionletRate / nOptionletTenors_;
         }
+        switchStrikeNotInitialized_ = false;
 
-        const Handle<YieldTermStructure>& discountCurve =
-            discount_.empty() ?
-                iborIndex_->forwardingTermStructure() :
-                discount_;
+        Size nCaplets = forwards.size();
+        Array capletForwards(forwards.begin(), forwards.end());
+        Array capletDiscounts(discounts.begin(), discounts.end());
+        Array capletStrikes(nCaplets), capletStdDevs(nCaplets);
+        Array capletPrices(nCaplets);
 
-        const std::vector<Rate>& strikes = termVolSurface_->strikes();
-        // initialize CapFloorMatrix
-        if (capFlooMatrixNotInitialized_) {
-            for (Size i=0; i<nOptionletTenors_; ++i)
-                capFloors_[i].resize(nStrikes_);
-            // construction might go here
-            for (Size j=0; j<nStrikes_; ++j) {
-                // using out-of-the-money options
-                CapFloor::Type capFloorType = strikes[j] < switchStrike_ ?
-                                       CapFloor::Floor : CapFloor::Cap;
-                for (Size i=0; i<nOptionletTenors_; ++i) {
-                    volQuotes_[i][j] = shared_ptr<SimpleQuote>(new
-                                                                SimpleQuote());
-                    if (model_ == ShiftedLognormal) {
-                      shared_ptr<BlackCapFloorEngine> engine(
-                          new BlackCapFloorEngine(
-                              discountCurve, Handle<Quote>(volQuotes_[i][j]),
-                              dc, displacement_));
-                      capFloors_[i][j] =
-                          MakeCapFloor(capFloorType, capFloorLengths_[i],
-                                       iborIndex_, strikes[j],
-                                       0 * Days).withPricingEngine(engine);
-                    } else if (model_ == Normal) {
-                      shared_ptr<BachelierCapFloorEngine> engine(
-                          new BachelierCapFloorEngine(
-                              discountCurve, Handle<Quote>(volQuotes_[i][j]),
-                              dc));
-                      capFloors_[i][j] =
-                          MakeCapFloor(capFloorType, capFloorLengths_[i],
-                                       iborIndex_, strikes[j],
-                                       0 * Days).withPricingEngine(engine);
-                    } else {
-                      QL_FAIL("unknown model: " << model_);
-                    }
-                }
-            }
-            capFlooMatrixNotInitialized_ = false;
-        }
+        Array optionletStrikes(nOptionletTenors_);
+        Array atmRates(atmOptionletRate_.begin(), atmOptionletRate_.end());
+        Array optionletAnnuities(nOptionletTenors_);
+        Array prices(nOptionletTenors_), stdDevs(nOptionletTenors_);
+        Array guesses(nOptionletTenors_);
+        std::vector<bool> inverted(nOptionletTenors_);
+        for (Size i=0; i<nOptionletTenors_; ++i)
+            optionletAnnuities[i] = optionletAccrualPeriods_[i] *
+                discountCurve->discount(optionletPaymentDates_[i]);
 
+        const std::vector<Rate>& strikes = termVolSurface_->strikes();
         for (Size j=0; j<nStrikes_; ++j) {
 
+            // using out-of-the-money options
             Option::Type optionletType = strikes[j] < switchStrike_ ?
                                    Option::Put : Option::Call;
 
-            Real previousCapFloorPrice = 0.0;
+            // price all the caps (floors) at this strike at once
             for (Size i=0; i<nOptionletTenors_; ++i) {
-
                 capFloorVols_[i][j] = termVolSurface_->volatility(
                     capFloorLengths_[i], strikes[j], true);
-                volQuotes_[i][j]->setValue(capFloorVols_[i][j]);
+                for (Size k=firstCaplet[i]; k<firstCaplet[i+1]; ++k) {
+                    capletStrikes[k] = (strikes[j]-spreads[k])/gearings[k];
+                    capletStdDevs[k] = capFloorVols_[i][j]*sqrtTimes[k];
+                }
+            }
+            if (model_ == ShiftedLognormal) {
+                blackFormula(optionletType, capletStrikes, capletForwards,
+                             capletStdDevs, capletDiscounts, capletPrices,
+                             displacement_);
+            } else {
+                for (Size k=0; k<nCaplets; ++k)
+                    capletPrices[k] = bachelierBlackFormula(
+                        optionletType, capletStrikes[k], capletForwards[k],
+                        capletStdDevs[k], capletDiscounts[k]);
+            }
 
-                capFloorPrices_[i][j] = capFloors_[i][j]->NPV();
+            Real previousCapFloorPrice = 0.0;
+            for (Size i=0; i<nOptionletTenors_; ++i) {
+                capFloorPrices_[i][j] = 0.0;
+                for (Size k=firstCaplet[i]; k<firstCaplet[i+1]; ++k)
+                    capFloorPrices_[i][j] += capletPrices[k];
                 optionletPrices_[i][j] = capFloorPrices_[i][j] -
                                                         previousCapFloorPrice;
                 previousCapFloorPrice = capFloorPrices_[i][j];
-                DiscountFactor d =
-                    discountCurve->discount(optionletPaymentDates_[i]);
-                DiscountFactor optionletAnnuity=optionletAccrualPeriods_[i]*d;
+                optionletStrikes[i] = strikes[j];
+                prices[i] = optionletPrices_[i][j];
+            }
+
+            // invert all the optionlet prices at this strike at once,
+            // starting from the previous results; the optionlets that
+            // can't be inverted are retried one by one below, so that
+            // the failing one is reported
+            std::fill(inverted.begin(), inverted.end(), false);
+            if (model_ == ShiftedLognormal) {
+                for (Size i=0; i<nOptionletTenors_; ++i)
+                    guesses[i] = optionletStDevs_[i][j];
                 try {
-                  if (model_ == ShiftedLognormal) {
-                    optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
-                        optionletType, strikes[j], atmOptionletRate_[i],
-                        optionletPrices_[i][j], optionletAnnuity, displacement_,
-                        optionletStDevs_[i][j], accuracy_, maxIter_);
-                  } else if (model_ == Normal) {
-                    optionletStDevs_[i][j] =
-                        std::sqrt(optionletTimes_[i]) *
-                        bachelierBlackFormulaImpliedVol(
+                    blackFormulaImpliedStdDev(optionletType, optionletStrikes,
+                                              atmRates, prices,
+                                              optionletAnnuities, stdDevs,
+                                              displacement_, guesses,
+                                              accuracy_, maxIter_);
+                    for (Size i=0; i<nOptionletTenors_; ++i) {
+                        if (stdDevs[i] != Null<Real>()) {
+                            optionletStDevs_[i][j] = stdDevs[i];
+                            inverted[i] = true;
+                        }
+                    }
+                } catch (std::exception&) {}
+            }
+
+            for (Size i=0; i<nOptionletTenors_; ++i) {
+                if (!inverted[i]) {
+                    try {
+                      if (model_ == ShiftedLognormal) {
+                        optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
                             optionletType, strikes[j], atmOptionletRate_[i],
-                            optionletTimes_[i], optionletPrices_[i][j],
-                            optionletAnnuity);
-                  } else {
-                    QL_FAIL("Unknown model: " << model_);
-                  }
-                }
-                catch (std::exception &e) {
-                    QL_FAIL("could not bootstrap optionlet:"
-                            "\n type:    " << optionletType <<
-                            "\n strike:  " << io::rate(strikes[j]) <<
-                            "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
-                            "\n price:   " << optionletPrices_[i][j] <<
-                            "\n annuity: " << optionletAnnuity <<
-                            "\n expiry:  " << optionletDates_[i] <<
-                            "\n error:   " << e.what());
+                            optionletPrices_[i][j], optionletAnnuities[i],
+                            displacement_, optionletStDevs_[i][j], accuracy_,
+                            maxIter_);
+                      } else {
+                        optionletStDevs_[i][j] =
+                            std::sqrt(optionletTimes_[i]) *
+                            bachelierBlackFormulaImpliedVol(
+                                optionletType, strikes[j],
+                                atmOptionletRate_[i], optionletTimes_[i],
+                                optionletPrices_[i][j], optionletAnnuities[i]);
+                      }
+                    }
+                    catch (std::exception &e) {
+                        QL_FAIL("could not bootstrap optionlet:"
+                                "\n type:    " << optionletType <<
+                                "\n strike:  " << io::rate(strikes[j]) <<
+                                "\n atm:     " <<
+                                    io::rate(atmOptionletRate_[i]) <<
+                                "\n price:   " << optionletPrices_[i][j] <<
+                                "\n annuity: " << optionletAnnuities[i] <<
+                                "\n expiry:  " << optionletDates_[i] <<
+                                "\n error:   " << e.what());
+                    }
                 }
                 optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
                                                 std::sqrt(optionletTimes_[i]);
@@ -32,13 +32,19 @@
 namespace QuantLib {
 
     class CapFloor;
-    class SimpleQuote;
 
     typedef std::vector<std::vector<boost::shared_ptr<CapFloor> > > CapFloorMatrix;
 
     /*! Helper class to strip optionlet (i.e. caplet/floorlet) volatilities
         (a.k.a. forward-forward volatilities) from the (cap/floor) term
         volatilities of a CapFloorTermVolSurface.
+
+        The caplets of each cap are generated once per calculation;
+        cap prices are then obtained directly from their forwards,
+        fixing times and discounted accruals by means of the batch
+        Black formula (or the Bachelier formula) and the optionlet
+        volatilities of each strike are inverted in a single batch,
+        without building cap/floor instruments or pricing engines.
     */
     class OptionletStripper1 : public OptionletStripper {
       public:
@@ -65,10 +71,8 @@ namespace QuantLib {
         mutable Matrix capFloorVols_;
         mutable Matrix optionletStDevs_;
 
-        mutable CapFloorMatrix capFloors_;
-        mutable std::vector<std::vector<boost::shared_ptr<SimpleQuote> > > volQuotes_;
         bool floatingSwitchStrike_;
-        mutable bool capFlooMatrixNotInitialized_;
+        mutable bool switchStrikeNotInitialized_;
         mutable Rate switchStrike_;
         Real accuracy_;
         Natural maxIter_;
@@ -53,6 +53,16 @@ namespace QuantLib {
     class EndCriteria;
     class OptimizationMethod;
 
+    //! swaption volatility cube, fit-early-interpolate-later approach
+    /*! The smile at each (option tenor, swap tenor) node is fitted
+        separately; the fits run in parallel unless an optimization
+        method is given, since it would be shared among them. Nodes
+        whose market volatilities and guess did not change since the
+        last calculation are not fitted again. If warmStart is true,
+        the other nodes start from their last fitted parameters rather
+        than from the guess; the results then depend on the history of
+        the calibrations.
+    */
     template<class Model>
     class SwaptionVolCube1x : public SwaptionVolatilityCube {
         class Cube {
@@ -108,6 +118,22 @@ namespace QuantLib {
             bool backwardFlat_;
             mutable std::vector< boost::shared_ptr<Interpolation2D> > interpolators_;
          };
+        //! inputs and results of the smile fit at an (option, swap) node
+        struct NodeCalibration {
+            bool hasSameInputs(const NodeCalibration& o) const {
+                return optionTime == o.optionTime && forward == o.forward &&
+                       strikes == o.strikes &&
+                       volatilities == o.volatilities && guess == o.guess;
+            }
+            Time optionTime;
+            Rate forward;
+            std::vector<Real> strikes, volatilities, guess;
+            // starting point of the fit (the guess unless warm-started)
+            std::vector<Real> start;
+            // alpha, beta, nu, rho, rms error, max error, end criteria;
+            //   empty if the node was not calibrated
+            std::vector<Real> result;
+        };
       public:
         SwaptionVolCube1x(
             const Handle<SwaptionVolatilityStructure>& atmVolStructure,
@@ -130,7 +156,8 @@ namespace QuantLib {
             const bool useMaxError = false,
             const Size maxGuesses = 50,
             const bool backwardFlat = false,
-            const Real cutoffStrike = 0.0001);
+            const Real cutoffStrike = 0.0001,
+            const bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const;
@@ -170,6 +197,8 @@ namespace QuantLib {
                                     Time swapLength,
                                     const Cube& sabrParametersCube) const;
         Cube sabrCalibration(const Cube& marketVolCube) const;
+        Cube sabrCalibration(const Cube& marketVolCube,
+                             std::vector<NodeCalibration>& calibrations) const;
         void fillVolatilityCube() const;
         void createSparseSmiles() const;
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
@@ -193,6 +222,10 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        const bool warmStart_;
+        // last node calibrations of the market and ATM-calibrated cubes
+        mutable std::vector<NodeCalibration> sparseCalibrations_;
+        mutable std::vector<NodeCalibration> denseCalibrations_;
 
         class PrivateObserver : public Observer {
           public:
@@ -230,7 +263,8 @@ namespace QuantLib {
         const boost::shared_ptr<OptimizationMethod> &optMethod,
         const Real errorAccept, const bool useMaxError, const Size maxGuesses,
         const bool backwardFlat,
-        const Real cutoffStrike)
+        const Real cutoffStrike,
+        const bool warmStart)
         : SwaptionVolatilityCube(atmVolStructure, optionTenors, swapTenors,
                                  strikeSpreads, volSpreads, swapIndexBase,
                                  shortSwapIndexBase, vegaWeightedSmileFit),
@@ -239,7 +273,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          warmStart_(warmStart) {
 
         if (maxErrorTolerance != Null<Rate>()) {
             maxErrorTolerance_ = maxErrorTolerance;
@@ -305,7 +340,8 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_,
+                                            sparseCalibrations_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -313,7 +349,8 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibrations_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -322,7 +359,8 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibrations_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -330,6 +368,14 @@ namespace QuantLib {
 
     template<class Model> typename SwaptionVolCube1x<Model>::Cube
     SwaptionVolCube1x<Model>::sabrCalibration(const Cube& marketVolCube) const {
+        std::vector<NodeCalibration> calibrations;
+        return sabrCalibration(marketVolCube, calibrations);
+    }
+
+    template<class Model> typename SwaptionVolCube1x<Model>::Cube
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                        const Cube& marketVolCube,
+                        std::vector<NodeCalibration>& calibrations) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -346,32 +392,64 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
+        // the inputs are collected serially, as the atm forwards and the
+        // guess interpolation go through lazy objects
+        const Size nNodes = optionTimes.size()*swapLengths.size();
+        if (calibrations.size() != nNodes)
+            calibrations = std::vector<NodeCalibration>(nNodes);
+        std::vector<NodeCalibration> nodes(nNodes);
 
         for (Size j=0; j<optionTimes.size(); j++) {
             for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                strikes.clear();
-                volatilities.clear();
+                NodeCalibration& node = nodes[j*swapLengths.size()+k];
+                const NodeCalibration& previous =
+                    calibrations[j*swapLengths.size()+k];
+                node.optionTime = optionTimes[j];
+                node.forward = atmStrike(optionDates[j], swapTenors[k]);
                 for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
+                    Real strike = node.forward+strikeSpreads_[i];
                     if(strike>=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
+                        node.strikes.push_back(strike);
+                        node.volatilities.push_back(tmpMarketVolCube[i][j][k]);
                     }
                 }
-
-                const std::vector<Real>& guess = parametersGuess_.operator()(
+                node.guess = parametersGuess_.operator()(
                     optionTimes[j], swapLengths[k]);
 
+                if (!previous.result.empty() && node.hasSameInputs(previous)) {
+                    // nothing changed, the fit would give the same result
+                    node.result = previous.result;
+                } else {
+                    node.start = node.guess;
+                    if (warmStart_ && !previous.result.empty() &&
+                        node.guess == previous.guess) {
+                        for (Size i=0; i<4; i++)
+                            if (!isParameterFixed_[i])
+                                node.start[i] = previous.result[i];
+                    }
+                }
+            }
+        }
+
+        // the nodes are fitted independently; a user-provided optimization
+        // method would be shared among them, so it is only used serially
+        std::vector<std::string> failures(nNodes);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(dynamic) if(!optMethod_)
+        #endif
+        for (Size n=0; n<nNodes; n++) {
+            NodeCalibration& node = nodes[n];
+            if (!node.result.empty())
+                continue;
+            try {
                 const boost::shared_ptr<typename Model::Interpolation> sabrInterpolation =
                     boost::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
+                                          (typename Model::Interpolation)(node.strikes.begin(), node.strikes.end(),
+                                          node.volatilities.begin(),
+                                          node.optionTime, node.forward,
+                                          node.start[0], node.start[1],
+                                          node.start[2], node.start[3],
                                           isParameterFixed_[0],
                                           isParameterFixed_[1],
                                           isParameterFixed_[2],
@@ -384,16 +462,37 @@ namespace QuantLib {
                                           maxGuesses_));
                 sabrInterpolation->update();
 
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
+                node.result.resize(7);
+                node.result[0] = sabrInterpolation->alpha();
+                node.result[1] = sabrInterpolation->beta();
+                node.result[2] = sabrInterpolation->nu();
+                node.result[3] = sabrInterpolation->rho();
+                node.result[4] = sabrInterpolation->rmsError();
+                node.result[5] = sabrInterpolation->maxError();
+                node.result[6] = sabrInterpolation->endCriteria();
+            } catch (std::exception& e) {
+                failures[n] = e.what();
+            } catch (...) {
+                failures[n] = "unknown error";
+            }
+        }
+
+        for (Size j=0; j<optionTimes.size(); j++) {
+            for (Size k=0; k<swapLengths.size(); k++) {
+                const Size n = j*swapLengths.size()+k;
+                QL_REQUIRE(failures[n].empty(), failures[n]);
+                const std::vector<Real>& result = nodes[n].result;
+
+                Real rmsError = result[4];
+                Real maxError = result[5];
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = nodes[n].forward;
                 errors     [j][k] = rmsError;
                 maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                endCriteria[j][k] = result[6];
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -436,6 +535,8 @@ namespace QuantLib {
         sabrParametersCube.setLayer(6, maxErrors);
         sabrParametersCube.setLayer(7, endCriteria);
 
+        calibrations = nodes;
+
         return sabrParametersCube;
 
     }
@@ -28,6 +28,7 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 
@@ -167,6 +168,11 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Other inspectors
+        //@{
+        //! the bootstrapper, after the curve was calculated
+        const Bootstrap<this_curve>& bootstrap() const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -226,6 +232,13 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const B<PiecewiseYieldCurve<C,I,B> >&
+    PiecewiseYieldCurve<C,I,B>::bootstrap() const {
+        calculate();
+        return bootstrap_;
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
@@ -22,9 +22,175 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/thread/locks.hpp>
+#endif
 
 namespace QuantLib {
 
+    namespace {
+
+        inline Size bitCount(boost::uint64_t x) {
+            #if defined(__GNUC__)
+            return __builtin_popcountll(x);
+            #else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL)
+              + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            return Size((x * 0x0101010101010101ULL) >> 56);
+            #endif
+        }
+
+    }
+
+    namespace detail {
+
+        BusinessDayTable::BusinessDayTable(const Date& first,
+                                           const Date& last,
+                                           unsigned long revision)
+        : first_(first.serialNumber()), size_(last-first+1),
+          revision_(revision), bits_(size_/64+1, 0), counts_(size_/64+1) {
+            QL_REQUIRE(last >= first, "invalid date range");
+        }
+
+        BigInteger BusinessDayTable::businessDaysBefore(const Date& d) const {
+            Size i = Size(d.serialNumber() - first_);
+            QL_REQUIRE(i <= size_, "date " << d << " outside table range");
+            boost::uint64_t mask = (boost::uint64_t(1) << (i & 63)) - 1;
+            return counts_[i >> 6] + BigInteger(bitCount(bits_[i >> 6] & mask));
+        }
+
+        void BusinessDayTable::setBusinessDay(const Date& d,
+                                              bool businessDay) {
+            QL_REQUIRE(covers(d), "date " << d << " outside table range");
+            Size i = Size(d.serialNumber() - first_);
+            boost::uint64_t bit = boost::uint64_t(1) << (i & 63);
+            if (businessDay)
+                bits_[i >> 6] |= bit;
+            else
+                bits_[i >> 6] &= ~bit;
+        }
+
+        void BusinessDayTable::joinHolidays(const BusinessDayTable& t) {
+            QL_REQUIRE(t.first_ == first_ && t.size_ == size_,
+                       "tables with different ranges");
+            for (Size i=0; i<bits_.size(); ++i)
+                bits_[i] &= t.bits_[i];
+        }
+
+        void BusinessDayTable::joinBusinessDays(const BusinessDayTable& t) {
+            QL_REQUIRE(t.first_ == first_ && t.size_ == size_,
+                       "tables with different ranges");
+            for (Size i=0; i<bits_.size(); ++i)
+                bits_[i] |= t.bits_[i];
+        }
+
+        void BusinessDayTable::update() {
+            BigInteger count = 0;
+            for (Size i=0; i<bits_.size(); ++i) {
+                counts_[i] = count;
+                count += BigInteger(bitCount(bits_[i]));
+            }
+        }
+
+    }
+
+
+    Year Calendar::firstPrecomputedYear_ = 1950;
+    Year Calendar::lastPrecomputedYear_ = 2100;
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    boost::atomic<unsigned long> Calendar::rangeRevision_(0);
+    #else
+    unsigned long Calendar::rangeRevision_ = 0;
+    #endif
+
+    Calendar::Impl::Impl() {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        current_.store(0);
+        revision_.store(0);
+        #else
+        revision_ = 0;
+        #endif
+    }
+
+    void Calendar::Impl::discardTable() {
+        ++revision_;
+    }
+
+    const detail::BusinessDayTable& Calendar::Impl::updateTable() const {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        // another thread might have done it already
+        if (table_ && table_->revision() == revision())
+            return *table_;
+        #endif
+        boost::shared_ptr<detail::BusinessDayTable> table(
+            new detail::BusinessDayTable(
+                               Date(1, January, firstPrecomputedYear_),
+                               Date(31, December, lastPrecomputedYear_),
+                               revision()));
+        fillTable(*table);
+        std::set<Date>::const_iterator i;
+        for (i=addedHolidays.begin(); i!=addedHolidays.end(); ++i) {
+            if (table->covers(*i))
+                table->setBusinessDay(*i, false);
+        }
+        for (i=removedHolidays.begin(); i!=removedHolidays.end(); ++i) {
+            if (table->covers(*i))
+                table->setBusinessDay(*i, true);
+        }
+        table->update();
+        table_ = table;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        current_.store(table_.get(), boost::memory_order_release);
+        #endif
+        return *table_;
+    }
+
+    void Calendar::Impl::fillTable(detail::BusinessDayTable& table) const {
+        Date d = Date(1, January, firstPrecomputedYear_),
+             last = Date(31, December, lastPrecomputedYear_);
+        for (; d <= last; ++d)
+            table.setBusinessDay(d, isBusinessDay(d));
+    }
+
+    const detail::BusinessDayTable&
+    Calendar::Impl::tableOf(const Calendar& c) {
+        QL_REQUIRE(c.impl_, "no implementation provided");
+        return c.impl_->table();
+    }
+
+    unsigned long Calendar::Impl::revisionOf(const Calendar& c) {
+        QL_REQUIRE(c.impl_, "no implementation provided");
+        return c.impl_->revision();
+    }
+
+    void Calendar::discardBusinessDayTables() {
+        impl_->discardTable();
+    }
+
+    void Calendar::setPrecomputedYears(Year first, Year last) {
+        QL_REQUIRE(first >= 1901 && last <= 2199,
+                   "precomputed years [" << first << ", " << last
+                   << "] outside allowed range [1901, 2199]");
+        QL_REQUIRE(first <= last,
+                   "first year (" << first << ") later than last year ("
+                   << last << ")");
+        firstPrecomputedYear_ = first;
+        lastPrecomputedYear_ = last;
+        ++rangeRevision_;
+    }
+
+    Year Calendar::firstPrecomputedYear() {
+        return firstPrecomputedYear_;
+    }
+
+    Year Calendar::lastPrecomputedYear() {
+        return lastPrecomputedYear_;
+    }
+
     void Calendar::addHoliday(const Date& d) {
         // if d was a genuine holiday previously removed, revert the change
         impl_->removedHolidays.erase(d);
@@ -32,6 +198,9 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        // joint calendars depending on this one will notice the
+        // change through its revision
+        discardBusinessDayTables();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -41,6 +210,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        discardBusinessDayTables();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -141,7 +311,13 @@ namespace QuantLib {
                                              bool includeLast) const {
         BigInteger wd = 0;
         if (from != to) {
-            if (from < to) {
+            const Date& first = std::min(from, to);
+            const Date& last = std::max(from, to);
+            const detail::BusinessDayTable& table = impl_->table();
+            if (table.covers(first) && table.covers(last)) {
+                wd = table.businessDaysBefore(last+1)
+                   - table.businessDaysBefore(first);
+            } else if (from < to) {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
                 for (Date d = from; d < to; ++d) {
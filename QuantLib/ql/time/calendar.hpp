@@ -29,6 +29,11 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#endif
 #include <set>
 #include <vector>
 #include <string>
@@ -37,6 +42,57 @@ namespace QuantLib {
 
     class Period;
 
+    namespace detail {
+
+        //! business days over a range of dates, stored as a bitset
+        /*! Bit \f$ i \f$ is set if the \f$ i \f$-th day of the range
+            is a business day. The number of business days preceding
+            each 64-bit word is also stored, so that business days
+            can be counted in constant time.
+        */
+        class BusinessDayTable {
+          public:
+            BusinessDayTable(const Date& first, const Date& last,
+                             unsigned long revision);
+            //! \name Inspectors
+            //@{
+            Size size() const { return size_; }
+            unsigned long revision() const { return revision_; }
+            bool covers(const Date& d) const {
+                return Size(d.serialNumber() - first_) < size_;
+            }
+            //! \pre the date must be covered by the table
+            bool isBusinessDay(const Date& d) const {
+                Size i = Size(d.serialNumber() - first_);
+                return ((bits_[i >> 6] >> (i & 63)) & 1) != 0;
+            }
+            /*! number of business days from the first date of the
+                table (included) to the given one (excluded).
+
+                \pre the date must be covered by the table or be the
+                     day after its last date.
+            */
+            BigInteger businessDaysBefore(const Date& d) const;
+            //@}
+            //! \name Modifiers
+            //@{
+            void setBusinessDay(const Date& d, bool businessDay);
+            //! combines the business days as in JointCalendar
+            void joinHolidays(const BusinessDayTable&);
+            void joinBusinessDays(const BusinessDayTable&);
+            //! to be called after any modification
+            void update();
+            //@}
+          private:
+            BigInteger first_;
+            Size size_;
+            unsigned long revision_;
+            std::vector<boost::uint64_t> bits_;
+            std::vector<BigInteger> counts_;
+        };
+
+    }
+
     //! %calendar class
     /*! This class provides methods for determining whether a date is a
         business day or a holiday for a given market, and for
@@ -49,24 +105,74 @@ namespace QuantLib {
         or for general country holiday schedule. Legacy city holiday schedule
         calendars will be moved to the exchange/country convention.
 
+        Business days within a range of years (by default, from 1950
+        to 2100) are precomputed by each calendar upon its first use
+        and stored in a bitset, so that checking a date or counting
+        the business days between two dates doesn't require to apply
+        the calendar rules; the table is rebuilt when holidays are
+        added or removed, both for the modified calendar and for the
+        joint calendars depending on it. Dates outside the range are
+        checked by applying the rules.
+
+        \warning The table is built lazily. Unless
+                 QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN is defined,
+                 calendars should be used for the first time from a
+                 single thread. As before, adding or removing holidays
+                 while other threads use the calendar is not safe.
+
         \ingroup datetime
 
-        \test the methods for adding and removing holidays are tested
-              by inspecting the calendar before and after their
-              invocation.
+        \test
+        - the methods for adding and removing holidays are tested
+          by inspecting the calendar before and after their
+          invocation.
+        - the precomputed business days are checked against the
+          calendar rules.
     */
     class Calendar {
       protected:
         //! abstract base class for calendar implementations
         class Impl {
           public:
+            Impl();
             virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            //! precomputed business days, including modifications
+            const detail::BusinessDayTable& table() const;
+            /*! changes whenever the business days of this calendar
+                change; the precomputed table is rebuilt lazily when
+                it no longer matches.
+            */
+            virtual unsigned long revision() const;
+            //! to be called when the rules of this calendar are modified
+            void discardTable();
+          protected:
+            /*! sets the business days in the given table according
+                to the calendar rules. The default implementation
+                applies isBusinessDay() to each date.
+            */
+            virtual void fillTable(detail::BusinessDayTable&) const;
+            //! precomputed business days of another calendar
+            static const detail::BusinessDayTable& tableOf(const Calendar&);
+            //! revision of another calendar
+            static unsigned long revisionOf(const Calendar&);
+          private:
+            const detail::BusinessDayTable& updateTable() const;
+            mutable boost::shared_ptr<detail::BusinessDayTable> table_;
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            mutable boost::atomic<const detail::BusinessDayTable*> current_;
+            mutable boost::mutex mutex_;
+            boost::atomic<unsigned long> revision_;
+            #else
+            unsigned long revision_;
+            #endif
         };
         boost::shared_ptr<Impl> impl_;
+        //! to be called when the rules of this calendar are modified
+        void discardBusinessDayTables();
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -144,6 +250,18 @@ namespace QuantLib {
                                        bool includeLast = false) const;
         //@}
 
+        //! \name Precomputed business days
+        //@{
+        /*! Sets the range of years for which business days are
+            precomputed by all calendars.
+
+            \warning this method is not thread-safe.
+        */
+        static void setPrecomputedYears(Year first, Year last);
+        static Year firstPrecomputedYear();
+        static Year lastPrecomputedYear();
+        //@}
+
       protected:
         //! partial calendar implementation
         /*! This class provides the means of determining the Easter
@@ -167,6 +285,14 @@ namespace QuantLib {
             //! expressed relative to first day of year
             static Day easterMonday(Year);
         };
+      private:
+        static unsigned long rangeRevision();
+        static Year firstPrecomputedYear_, lastPrecomputedYear_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        static boost::atomic<unsigned long> rangeRevision_;
+        #else
+        static unsigned long rangeRevision_;
+        #endif
     };
 
     /*! Returns <tt>true</tt> iff the two calendars belong to the same
@@ -192,7 +318,31 @@ namespace QuantLib {
         return impl_->name();
     }
 
+    inline unsigned long Calendar::rangeRevision() {
+        return rangeRevision_;
+    }
+
+    inline unsigned long Calendar::Impl::revision() const {
+        // the range of years is shared by all calendars
+        return revision_ + Calendar::rangeRevision();
+    }
+
+    inline const detail::BusinessDayTable& Calendar::Impl::table() const {
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        const detail::BusinessDayTable* t =
+            current_.load(boost::memory_order_acquire);
+        #else
+        const detail::BusinessDayTable* t = table_.get();
+        #endif
+        if (t == 0 || t->revision() != revision())
+            t = &updateTable();
+        return *t;
+    }
+
     inline bool Calendar::isBusinessDay(const Date& d) const {
+        const detail::BusinessDayTable& table = impl_->table();
+        if (table.covers(d))
+            return table.isBusinessDay(d);
         if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
             return false;
         if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
@@ -50,6 +50,7 @@ namespace QuantLib {
 
     void BespokeCalendar::addWeekend(Weekday w) {
         bespokeImpl_->addWeekend(w);
+        discardBusinessDayTables();
     }
 
 }
@@ -114,6 +114,35 @@ namespace QuantLib {
         }
     }
 
+    unsigned long JointCalendar::Impl::revision() const {
+        // revisions only increase, so the sum changes whenever
+        // any of the joined calendars does
+        unsigned long r = Calendar::Impl::revision();
+        std::vector<Calendar>::const_iterator i;
+        for (i=calendars_.begin(); i!=calendars_.end(); ++i)
+            r += revisionOf(*i);
+        return r;
+    }
+
+    void JointCalendar::Impl::fillTable(
+                                    detail::BusinessDayTable& table) const {
+        // the table starts empty
+        std::vector<Calendar>::const_iterator i = calendars_.begin();
+        table.joinBusinessDays(tableOf(*i));
+        switch (rule_) {
+          case JoinHolidays:
+            for (++i; i!=calendars_.end(); ++i)
+                table.joinHolidays(tableOf(*i));
+            break;
+          case JoinBusinessDays:
+            for (++i; i!=calendars_.end(); ++i)
+                table.joinBusinessDays(tableOf(*i));
+            break;
+          default:
+            QL_FAIL("unknown joint calendar rule");
+        }
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
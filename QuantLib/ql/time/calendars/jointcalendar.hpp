@@ -45,6 +45,8 @@ namespace QuantLib {
     /*! Depending on the chosen rule, this calendar has a set of
         business days given by either the union or the intersection
         of the sets of business days of the given calendars.
+        Its precomputed business days are obtained by combining the
+        bitsets of the given calendars.
 
         \ingroup calendars
 
@@ -65,6 +67,9 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+            unsigned long revision() const;
+          protected:
+            void fillTable(detail::BusinessDayTable&) const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
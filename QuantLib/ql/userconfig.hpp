@@ -72,4 +72,12 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this to make registration, unregistration and notification
+   of observers safe when performed concurrently from different
+   threads. This requires Boost 1.58 or later and linking with the
+   Boost thread library. */
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+//#   define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#endif
+
 #endif
@@ -22,6 +22,9 @@
 #include "blackformula.hpp"
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <boost/timer.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -117,6 +120,214 @@ void BlackFormulaTest::testChambersImpliedVol() {
     }
 }
 
+void BlackFormulaTest::testBatchFormulas() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black formula, greeks and implied vol...");
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real displacements[] = { 0.0, 0.01 };
+    Real forwards[] = { 0.005, 0.02, 0.05, 1.0, 100.0 };
+    Real moneyness[] = { 0.3, 0.7, 0.9, 1.0, 1.1, 1.5, 3.0 };
+    Real stdDevs[] = { 0.0, 0.001, 0.05, 0.2, 0.5, 1.0, 2.5 };
+    Real discounts[] = { 1.0, 0.8 };
+
+    for (Size i1=0; i1<LENGTH(types); ++i1) {
+      for (Size i2=0; i2<LENGTH(displacements); ++i2) {
+        Real displacement = displacements[i2];
+
+        std::vector<Real> k, f, s, d;
+        for (Size i3=0; i3<LENGTH(forwards); ++i3)
+          for (Size i4=0; i4<LENGTH(moneyness); ++i4)
+            for (Size i5=0; i5<LENGTH(stdDevs); ++i5)
+              for (Size i6=0; i6<LENGTH(discounts); ++i6) {
+                  k.push_back(forwards[i3]*moneyness[i4] - displacement);
+                  f.push_back(forwards[i3] - displacement);
+                  s.push_back(stdDevs[i5]);
+                  d.push_back(discounts[i6]);
+              }
+        Array strikes(k.begin(), k.end()), fwds(f.begin(), f.end()),
+              devs(s.begin(), s.end()), discs(d.begin(), d.end());
+
+        Array values, deltas, gammas, vegas, implied;
+        blackFormula(types[i1], strikes, fwds, devs, discs,
+                     values, displacement);
+        blackFormulaGreeks(types[i1], strikes, fwds, devs, discs,
+                           deltas, gammas, vegas, displacement);
+        blackFormulaImpliedStdDev(types[i1], strikes, fwds, values, discs,
+                                  implied, displacement);
+
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real forward = fwds[i] + displacement,
+                 strike = strikes[i] + displacement;
+            Real tol = 1.0e-12*forward;
+
+            Real value = blackFormula(types[i1], strikes[i], fwds[i],
+                                      devs[i], discs[i], displacement);
+            BlackCalculator calculator(types[i1], strike, forward,
+                                       devs[i], discs[i]);
+            Real vega = blackFormulaStdDevDerivative(strikes[i], fwds[i],
+                                                     devs[i], discs[i],
+                                                     displacement);
+            if (std::fabs(values[i]-value) > tol)
+                BOOST_ERROR("failed to reproduce Black price for "
+                            << types[i1]
+                            << "\n    forward:      " << fwds[i]
+                            << "\n    strike:       " << strikes[i]
+                            << "\n    displacement: " << displacement
+                            << "\n    stdDev:       " << devs[i]
+                            << "\n    discount:     " << discs[i]
+                            << std::scientific
+                            << "\n    batch:        " << values[i]
+                            << "\n    expected:     " << value);
+            if (devs[i] > 0.0 &&
+                (std::fabs(deltas[i]-calculator.deltaForward()) > 1.0e-12 ||
+                 std::fabs(gammas[i]-calculator.gammaForward())
+                                               > 1.0e-10/forward ||
+                 std::fabs(vegas[i]-vega) > tol))
+                BOOST_ERROR("failed to reproduce Black greeks for "
+                            << types[i1]
+                            << "\n    forward:      " << fwds[i]
+                            << "\n    strike:       " << strikes[i]
+                            << "\n    displacement: " << displacement
+                            << "\n    stdDev:       " << devs[i]
+                            << "\n    discount:     " << discs[i]
+                            << std::scientific
+                            << "\n    delta:        " << deltas[i]
+                            << "\n    expected:     "
+                            << calculator.deltaForward()
+                            << "\n    gamma:        " << gammas[i]
+                            << "\n    expected:     "
+                            << calculator.gammaForward()
+                            << "\n    vega:         " << vegas[i]
+                            << "\n    expected:     " << vega);
+
+            // the implied standard deviation can only be recovered
+            // if the time value is not lost in the price
+            Real timeValue = values[i]/discs[i]
+                - std::max(types[i1]*(forward-strike), 0.0);
+            if (timeValue > 1.0e-6*forward &&
+                std::fabs(implied[i]-devs[i]) > 1.0e-8)
+                BOOST_ERROR("failed to recover implied stdDev for "
+                            << types[i1]
+                            << "\n    forward:      " << fwds[i]
+                            << "\n    strike:       " << strikes[i]
+                            << "\n    displacement: " << displacement
+                            << "\n    discount:     " << discs[i]
+                            << "\n    price:        " << values[i]
+                            << std::scientific
+                            << "\n    implied:      " << implied[i]
+                            << "\n    expected:     " << devs[i]);
+        }
+      }
+    }
+
+    // prices below the intrinsic value have no implied stdDev
+    {
+        Array strikes(2, 90.0), fwds(2, 100.0), discs(2, 0.9);
+        Array values(2), implied;
+        values[0] = blackFormula(Option::Call, strikes[0], fwds[0],
+                                 0.2, discs[0]);
+        values[1] = 0.99*discs[1]*(fwds[1]-strikes[1]);
+        BOOST_CHECK_THROW(blackFormulaImpliedStdDev(Option::Call, strikes,
+                                                    fwds, values, discs,
+                                                    implied),
+                          Error);
+    }
+
+    // options that don't converge are reported, not mispriced
+    {
+        Array strikes(3, 100.0), fwds(3, 100.0), discs(3, 1.0);
+        Array values(3), guesses(3), implied;
+        strikes[1] = 50.0;
+        strikes[2] = 200.0;
+        for (Size i=0; i<3; ++i) {
+            values[i] = blackFormula(Option::Call, strikes[i], fwds[i],
+                                     0.3, discs[i]);
+            guesses[i] = 3.0;
+        }
+        Size failures = blackFormulaImpliedStdDev(Option::Call, strikes,
+                                                  fwds, values, discs,
+                                                  implied, 0.0, guesses,
+                                                  1.0e-12, 1);
+        Size nulls = 0;
+        for (Size i=0; i<3; ++i) {
+            if (implied[i] == Null<Real>())
+                ++nulls;
+            else if (std::fabs(implied[i]-0.3) > 1.0e-8)
+                BOOST_ERROR("wrong implied stdDev reported as converged"
+                            << "\n    strike:   " << strikes[i]
+                            << std::scientific
+                            << "\n    implied:  " << implied[i]
+                            << "\n    expected: " << 0.3);
+        }
+        if (failures == 0 || failures != nulls)
+            BOOST_ERROR("non-converged implied stdDevs not reported"
+                        << "\n    failures: " << failures
+                        << "\n    nulls:    " << nulls);
+
+        failures = blackFormulaImpliedStdDev(Option::Call, strikes, fwds,
+                                             values, discs, implied, 0.0,
+                                             guesses);
+        for (Size i=0; i<3; ++i)
+            if (failures != 0 || std::fabs(implied[i]-0.3) > 1.0e-8)
+                BOOST_ERROR("failed to recover implied stdDev from guess"
+                            << "\n    strike:   " << strikes[i]
+                            << std::scientific
+                            << "\n    implied:  " << implied[i]
+                            << "\n    expected: " << 0.3);
+    }
+
+    // timing against the scalar functions
+    const Size n = 100000;
+    Array strikes(n), fwds(n, 100.0), devs(n), discs(n, 0.95);
+    Array values(n), implied(n), scalarImplied(n);
+    MersenneTwisterUniformRng rng(42);
+    for (Size i=0; i<n; ++i) {
+        strikes[i] = 80.0 + 45.0*rng.nextReal();
+        devs[i] = 0.1 + 0.4*rng.nextReal();
+    }
+
+    boost::timer t;
+    for (Size i=0; i<n; ++i)
+        values[i] = blackFormula(Option::Call, strikes[i], fwds[i],
+                                 devs[i], discs[i]);
+    Real scalarPricingTime = t.elapsed();
+    t.restart();
+    for (Size i=0; i<n; ++i)
+        scalarImplied[i] = blackFormulaImpliedStdDev(
+                                 Option::Call, strikes[i], fwds[i],
+                                 values[i], discs[i], 0.0, Null<Real>(),
+                                 1.0e-12);
+    Real scalarImpliedTime = t.elapsed();
+    t.restart();
+    blackFormula(Option::Call, strikes, fwds, devs, discs, values);
+    Real batchPricingTime = t.elapsed();
+    t.restart();
+    blackFormulaImpliedStdDev(Option::Call, strikes, fwds, values, discs,
+                              implied);
+    Real batchImpliedTime = t.elapsed();
+
+    BOOST_TEST_MESSAGE("    " << n << " options:"
+                       << "\n        scalar pricing:     "
+                       << scalarPricingTime*1e3 << " ms"
+                       << "\n        batch pricing:      "
+                       << batchPricingTime*1e3 << " ms"
+                       << "\n        scalar implied vol: "
+                       << scalarImpliedTime*1e3 << " ms"
+                       << "\n        batch implied vol:  "
+                       << batchImpliedTime*1e3 << " ms");
+
+    for (Size i=0; i<n; ++i) {
+        if (std::fabs(implied[i]-scalarImplied[i]) > 1.0e-8)
+            BOOST_ERROR("batch and scalar implied stdDev differ"
+                        << "\n    strike:  " << strikes[i]
+                        << "\n    price:   " << values[i]
+                        << std::scientific
+                        << "\n    batch:   " << implied[i]
+                        << "\n    scalar:  " << scalarImplied[i]);
+    }
+}
+
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -124,6 +335,8 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testChambersImpliedVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchFormulas));
 
     return suite;
 }
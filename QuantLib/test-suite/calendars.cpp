@@ -34,6 +34,7 @@
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/errors.hpp>
+#include <boost/timer.hpp>
 #include <fstream>
 
 using namespace QuantLib;
@@ -1004,6 +1005,187 @@ void CalendarTest::testBusinessDaysBetween() {
 }
 
 
+namespace {
+
+    class SavedPrecomputedYears {
+      public:
+        SavedPrecomputedYears()
+        : first_(Calendar::firstPrecomputedYear()),
+          last_(Calendar::lastPrecomputedYear()) {}
+        ~SavedPrecomputedYears() {
+            Calendar::setPrecomputedYears(first_, last_);
+        }
+      private:
+        Year first_, last_;
+    };
+
+    // counts the business-day tables it builds
+    class CountingCalendar : public Calendar {
+      private:
+        class Impl : public Calendar::WesternImpl {
+          public:
+            Impl() : tables(0) {}
+            std::string name() const { return "Counting"; }
+            bool isBusinessDay(const Date& d) const {
+                return !isWeekend(d.weekday());
+            }
+            mutable Size tables;
+          protected:
+            void fillTable(detail::BusinessDayTable& table) const {
+                ++tables;
+                Calendar::Impl::fillTable(table);
+            }
+        };
+        boost::shared_ptr<Impl> countingImpl_;
+      public:
+        CountingCalendar() {
+            countingImpl_ = boost::shared_ptr<Impl>(new Impl);
+            impl_ = countingImpl_;
+        }
+        Size tablesBuilt() const { return countingImpl_->tables; }
+    };
+
+}
+
+void CalendarTest::testPrecomputedBusinessDays() {
+
+    BOOST_TEST_MESSAGE("Testing precomputed business days...");
+
+    SavedPrecomputedYears backup;
+
+    std::vector<Calendar> calendars;
+    calendars.push_back(TARGET());
+    calendars.push_back(UnitedStates(UnitedStates::NYSE));
+    calendars.push_back(UnitedKingdom(UnitedKingdom::Exchange));
+    calendars.push_back(Japan());
+    calendars.push_back(Brazil());
+    calendars.push_back(JointCalendar(TARGET(), UnitedKingdom(),
+                                      JoinHolidays));
+    calendars.push_back(JointCalendar(TARGET(),
+                                      UnitedStates(UnitedStates::NYSE),
+                                      Japan(), JoinBusinessDays));
+
+    Date firstDate(1,January,1990), lastDate(31,December,2060);
+    Size days = lastDate - firstDate + 1;
+
+    std::vector<std::pair<Date,Date> > intervals;
+    for (Size i=0; i<1000; ++i) {
+        // cover reversed intervals and intervals ending outside
+        // the precomputed range
+        Date from = firstDate + BigInteger((i*7919) % days);
+        Date to = firstDate + BigInteger((i*104729 + 17) % (days+2000));
+        intervals.push_back(std::make_pair(from, to));
+    }
+
+    // business days according to the calendar rules
+    Calendar::setPrecomputedYears(1901, 1901);
+    std::vector<std::vector<bool> > expected(calendars.size(),
+                                             std::vector<bool>(days));
+    std::vector<std::vector<BigInteger> > expectedCount(
+                        calendars.size(), std::vector<BigInteger>(4*1000));
+    boost::timer timer;
+    for (Size k=0; k<calendars.size(); ++k) {
+        for (Size i=0; i<days; ++i)
+            expected[k][i] = calendars[k].isBusinessDay(firstDate+i);
+    }
+    Real rulesCheck = timer.elapsed();
+    timer.restart();
+    for (Size k=0; k<calendars.size(); ++k) {
+        for (Size i=0; i<intervals.size(); ++i) {
+            for (Size j=0; j<4; ++j)
+                expectedCount[k][4*i+j] = calendars[k].businessDaysBetween(
+                                              intervals[i].first,
+                                              intervals[i].second,
+                                              j%2 == 0, j/2 == 0);
+        }
+    }
+    Real rulesCount = timer.elapsed();
+
+    Calendar::setPrecomputedYears(1980, 2050);
+    // force precalculation to exclude it from timing
+    for (Size k=0; k<calendars.size(); ++k)
+        calendars[k].isBusinessDay(firstDate);
+
+    timer.restart();
+    for (Size k=0; k<calendars.size(); ++k) {
+        for (Size i=0; i<days; ++i) {
+            if (calendars[k].isBusinessDay(firstDate+i) != expected[k][i])
+                BOOST_FAIL("wrong precomputed business day for "
+                           << calendars[k].name() << " at "
+                           << firstDate+i);
+        }
+    }
+    Real tableCheck = timer.elapsed();
+    timer.restart();
+    for (Size k=0; k<calendars.size(); ++k) {
+        for (Size i=0; i<intervals.size(); ++i) {
+            for (Size j=0; j<4; ++j) {
+                BigInteger calculated = calendars[k].businessDaysBetween(
+                                              intervals[i].first,
+                                              intervals[i].second,
+                                              j%2 == 0, j/2 == 0);
+                if (calculated != expectedCount[k][4*i+j])
+                    BOOST_FAIL("wrong number of business days for "
+                               << calendars[k].name()
+                               << " from " << intervals[i].first
+                               << " to " << intervals[i].second << ":"
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   "
+                               << expectedCount[k][4*i+j]);
+            }
+        }
+    }
+    Real tableCount = timer.elapsed();
+
+    BOOST_TEST_MESSAGE("    " << calendars.size()*days
+                       << " business-day checks:"
+                       << "\n        calendar rules:    "
+                       << rulesCheck*1e3 << " ms"
+                       << "\n        precomputed:       "
+                       << tableCheck*1e3 << " ms"
+                       << "\n    " << calendars.size()*4*intervals.size()
+                       << " business-day counts:"
+                       << "\n        calendar rules:    "
+                       << rulesCount*1e3 << " ms"
+                       << "\n        precomputed:       "
+                       << tableCount*1e3 << " ms");
+
+    // modifications must be reflected in the joint calendars
+    Calendar target = TARGET();
+    Date d(26,April,2004);   // business day
+    QL_REQUIRE(calendars[5].isBusinessDay(d),
+               "wrong assumption---correct the test");
+    target.addHoliday(d);
+    if (calendars[0].isBusinessDay(d))
+        BOOST_FAIL(d << " still a business day for TARGET");
+    if (calendars[5].isBusinessDay(d))
+        BOOST_FAIL(d << " still a business day for " << calendars[5].name());
+    if (calendars[0].businessDaysBetween(d-1, d+1, true, true) != 1)
+        BOOST_FAIL("added holiday not excluded from business days");
+    target.removeHoliday(d);
+    if (calendars[0].isHoliday(d))
+        BOOST_FAIL(d << " still a holiday for TARGET");
+    if (calendars[5].isHoliday(d))
+        BOOST_FAIL(d << " still a holiday for " << calendars[5].name());
+
+    // ...but must not discard the tables of unrelated calendars
+    CountingCalendar counting;
+    counting.isBusinessDay(d);
+    target.addHoliday(d);
+    target.removeHoliday(d);
+    counting.isBusinessDay(d);
+    if (counting.tablesBuilt() != 1)
+        BOOST_FAIL(counting.tablesBuilt() << " tables built for a calendar "
+                   "not affected by the modifications (1 expected)");
+    counting.addHoliday(d);
+    if (counting.isBusinessDay(d))
+        BOOST_FAIL(d << " still a business day for " << counting.name());
+    if (counting.tablesBuilt() != 2)
+        BOOST_FAIL(counting.tablesBuilt() << " tables built for a modified "
+                   "calendar (2 expected)");
+}
+
+
 void CalendarTest::testBespokeCalendars() {
 
     BOOST_TEST_MESSAGE("Testing bespoke calendars...");
@@ -1150,6 +1332,8 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(
+                              &CalendarTest::testPrecomputedBusinessDays));
 
     return suite;
 }
@@ -57,6 +57,7 @@ class CalendarTest {
 
     static void testEndOfMonth();
     static void testBusinessDaysBetween();
+    static void testPrecomputedBusinessDays();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -34,10 +34,16 @@
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/currencies/europe.hpp>
 #include <iomanip>
 #include <iostream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace QuantLib;
 using namespace std;
 using namespace boost::unit_test_framework;
@@ -86,6 +92,34 @@ namespace {
                              << found << " vs. " << expected);
     }
 
+    // a pool of names with flat hazard rates, for the random models
+    boost::shared_ptr<Pool> makeFlatPool(Size poolSize, const Date& asofDate,
+                                         vector<string>& names) {
+        Handle<Quote> hazardRate(
+                          boost::shared_ptr<Quote>(new SimpleQuote(0.03)));
+        boost::shared_ptr<DefaultProbabilityTermStructure> ptr(
+               new FlatHazardRate(asofDate, hazardRate, ActualActual()));
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.push_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            Handle<DefaultProbabilityTermStructure>(ptr)));
+
+        boost::shared_ptr<Pool> pool(new Pool());
+        names.clear();
+        for (Size i=0; i<poolSize; ++i) {
+            ostringstream o;
+            o << "issuer-" << i;
+            names.push_back(o.str());
+            pool->add(names.back(), Issuer(probabilities),
+                      NorthAmericaCorpDefaultKey(EURCurrency(),
+                                                 QuantLib::SeniorSec,
+                                                 Period(), 1.));
+        }
+        return pool;
+    }
+
 }
 
 void CdoTest::testHW() {
@@ -360,8 +394,167 @@ void CdoTest::testHW() {
 }
 
 
+void CdoTest::testRandomDefaultLMStreaming() {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics of the random default "
+                       "latent model...");
+
+    SavedSettings backup;
+
+    Size poolSize = 20;
+    Size numSims = 4000;
+    Real recovery = 0.4;
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    vector<string> names;
+    boost::shared_ptr<Pool> pool = makeFlatPool(poolSize, asofDate, names);
+
+    Handle<Quote> hCorrelation(
+                          boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    boost::shared_ptr<GaussianConstantLossLM> gaussKtLossLM(
+        new GaussianConstantLossLM(hCorrelation,
+            std::vector<Real>(poolSize, recovery),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+
+    // a splittable generator, so that the simulations are sharded
+    typedef RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > RandomModel;
+    boost::shared_ptr<RandomModel> stored(
+                                  new RandomModel(gaussKtLossLM, numSims));
+    boost::shared_ptr<RandomModel> streamed(
+                                  new RandomModel(gaussKtLossLM, numSims));
+
+    std::vector<Date> dates;
+    dates.push_back(asofDate + 2*Years);
+    dates.push_back(asofDate + 5*Years);
+    streamed->setStreamingDates(dates);
+
+    boost::shared_ptr<Basket> storedBasket(new Basket(asofDate, names,
+        vector<Real>(poolSize, 100.0), pool, 0.03, 0.06));
+    boost::shared_ptr<Basket> streamedBasket(new Basket(asofDate, names,
+        vector<Real>(poolSize, 100.0), pool, 0.03, 0.06));
+    storedBasket->setLossModel(stored);
+    streamedBasket->setLossModel(streamed);
+
+    // both models draw the same scenarios
+    Real tolerance = 1.0e-10;
+    for (Size i=0; i<dates.size(); i++) {
+        Real expected = storedBasket->expectedTrancheLoss(dates[i]);
+        Real calculated = streamedBasket->expectedTrancheLoss(dates[i]);
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce expected tranche loss at "
+                        << dates[i] << "\n    streamed: " << calculated
+                        << "\n    stored:   " << expected);
+
+        for (Size n=1; n<=3; n++) {
+            expected = storedBasket->probAtLeastNEvents(n, dates[i]);
+            calculated = streamedBasket->probAtLeastNEvents(n, dates[i]);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce probability of at least "
+                            << n << " defaults at " << dates[i]
+                            << "\n    streamed: " << calculated
+                            << "\n    stored:   " << expected);
+
+            std::vector<Probability> expectedProbs =
+                storedBasket->probsBeingNthEvent(n, dates[i]);
+            std::vector<Probability> calculatedProbs =
+                streamedBasket->probsBeingNthEvent(n, dates[i]);
+            for (Size j=0; j<poolSize; j++) {
+                if (std::fabs(calculatedProbs[j] - expectedProbs[j])
+                                                               > tolerance)
+                    BOOST_ERROR("failed to reproduce probability of name "
+                                << j << " being default number " << n
+                                << " at " << dates[i]
+                                << "\n    streamed: " << calculatedProbs[j]
+                                << "\n    stored:   " << expectedProbs[j]);
+            }
+        }
+    }
+}
+
+
+void CdoTest::testRandomDefaultLMSharding() {
+
+    BOOST_TEST_MESSAGE("Testing sharded simulations of the random default "
+                       "latent model against a single thread...");
+
+    SavedSettings backup;
+
+    Size poolSize = 20;
+    Size numSims = 4000;
+    Real recovery = 0.4;
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    vector<string> names;
+    boost::shared_ptr<Pool> pool = makeFlatPool(poolSize, asofDate, names);
+
+    Handle<Quote> hCorrelation(
+                          boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    boost::shared_ptr<GaussianConstantLossLM> gaussKtLossLM(
+        new GaussianConstantLossLM(hCorrelation,
+            std::vector<Real>(poolSize, recovery),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+
+    // the Mersenne twister is split by reseeding, so the scenarios
+    // must not depend on the number of threads running the shards
+    typedef RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > RandomModel;
+    boost::shared_ptr<RandomModel> serial(
+                                  new RandomModel(gaussKtLossLM, numSims));
+    boost::shared_ptr<RandomModel> parallel(
+                                  new RandomModel(gaussKtLossLM, numSims));
+
+    boost::shared_ptr<Basket> serialBasket(new Basket(asofDate, names,
+        vector<Real>(poolSize, 100.0), pool, 0.03, 0.06));
+    boost::shared_ptr<Basket> parallelBasket(new Basket(asofDate, names,
+        vector<Real>(poolSize, 100.0), pool, 0.03, 0.06));
+    serialBasket->setLossModel(serial);
+    parallelBasket->setLossModel(parallel);
+
+    Date date = asofDate + 5*Years;
+
+    #ifdef _OPENMP
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    #endif
+    Real expectedLoss = serialBasket->expectedTrancheLoss(date);
+    std::vector<Probability> expectedProbs =
+        serialBasket->probsBeingNthEvent(2, date);
+    #ifdef _OPENMP
+    omp_set_num_threads(4);
+    #endif
+    Real calculatedLoss = parallelBasket->expectedTrancheLoss(date);
+    std::vector<Probability> calculatedProbs =
+        parallelBasket->probsBeingNthEvent(2, date);
+    #ifdef _OPENMP
+    omp_set_num_threads(threads);
+    #endif
+
+    Real tolerance = 1.0e-12;
+    if (std::fabs(calculatedLoss - expectedLoss) > tolerance)
+        BOOST_ERROR("failed to reproduce expected tranche loss"
+                    << std::setprecision(12)
+                    << "\n    4 threads: " << calculatedLoss
+                    << "\n    1 thread:  " << expectedLoss);
+    for (Size j=0; j<poolSize; j++) {
+        if (std::fabs(calculatedProbs[j] - expectedProbs[j]) > tolerance)
+            BOOST_ERROR("failed to reproduce probability of name "
+                        << j << " being the second default"
+                        << std::setprecision(12)
+                        << "\n    4 threads: " << calculatedProbs[j]
+                        << "\n    1 thread:  " << expectedProbs[j]);
+    }
+}
+
+
 test_suite* CdoTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     suite->add(QUANTLIB_TEST_CASE(&CdoTest::testHW));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testRandomDefaultLMStreaming));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testRandomDefaultLMSharding));
     return suite;
 }
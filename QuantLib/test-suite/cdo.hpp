@@ -28,6 +28,8 @@
 class CdoTest {
   public:
     static void testHW();
+    static void testRandomDefaultLMStreaming();
+    static void testRandomDefaultLMSharding();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -1513,6 +1513,152 @@ void EuropeanOptionTest::testLocalVolatility() {
     }
 }
 
+void EuropeanOptionTest::testFdMultipleStrikesEngine() {
+    BOOST_TEST_MESSAGE("Testing multiple-strikes FD Black-Scholes engine...");
+
+    SavedSettings backup;
+
+    const Date today(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = Actual360();
+    const boost::shared_ptr<Exercise> exercise(
+                               new EuropeanExercise(Date(28, March, 2005)));
+
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(100.0))),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    std::vector<Real> strikes;
+    for (Size i=0; i < 11; ++i)
+        strikes.push_back(70.0 + 6.0*i);
+
+    // a few implicit steps damp the oscillations caused by the kink
+    // of the payoff, which would otherwise spoil the at-the-money gamma
+    const Size dampingSteps = 2;
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> singleStrikeEngine(
+         new FdBlackScholesVanillaEngine(process, 100, 400, dampingSteps));
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> multiStrikeEngine(
+         new FdBlackScholesVanillaEngine(process, 100, 400, dampingSteps));
+    multiStrikeEngine->enableMultipleStrikesCaching(strikes);
+
+    const Real relTol = 5e-3;
+    for (Size i=0; i < strikes.size(); ++i) {
+        const boost::shared_ptr<StrikedTypePayoff> payoff(
+                             new PlainVanillaPayoff(Option::Put, strikes[i]));
+
+        EuropeanOption option(payoff, exercise);
+        option.setPricingEngine(multiStrikeEngine);
+
+        const Real npvCalculated   = option.NPV();
+        const Real deltaCalculated = option.delta();
+        const Real gammaCalculated = option.gamma();
+
+        option.setPricingEngine(singleStrikeEngine);
+        const Real npvExpected   = option.NPV();
+        const Real deltaExpected = option.delta();
+        const Real gammaExpected = option.gamma();
+
+        if (std::fabs(npvCalculated-npvExpected) > relTol*npvExpected) {
+            BOOST_FAIL("failed to reproduce price with FD multi strike engine"
+                       << "\n    strike:     " << strikes[i]
+                       << "\n    calculated: " << npvCalculated
+                       << "\n    expected:   " << npvExpected);
+        }
+        if (std::fabs(deltaCalculated-deltaExpected)
+                                            > relTol*std::fabs(deltaExpected)) {
+            BOOST_FAIL("failed to reproduce delta with FD multi strike engine"
+                       << "\n    strike:     " << strikes[i]
+                       << "\n    calculated: " << deltaCalculated
+                       << "\n    expected:   " << deltaExpected);
+        }
+        if (std::fabs(gammaCalculated-gammaExpected) > relTol*gammaExpected) {
+            BOOST_FAIL("failed to reproduce gamma with FD multi strike engine"
+                       << "\n    strike:     " << strikes[i]
+                       << "\n    calculated: " << gammaCalculated
+                       << "\n    expected:   " << gammaExpected);
+        }
+    }
+
+    // other payoffs are priced as usual and don't fill the cache
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> digitalEngine(
+         new FdBlackScholesVanillaEngine(process, 100, 400, dampingSteps));
+    digitalEngine->enableMultipleStrikesCaching(strikes);
+
+    EuropeanOption digital(boost::shared_ptr<StrikedTypePayoff>(
+                    new CashOrNothingPayoff(Option::Put, strikes[3], 10.0)),
+                           exercise);
+    digital.setPricingEngine(digitalEngine);
+    digital.NPV();
+
+    EuropeanOption put(boost::shared_ptr<StrikedTypePayoff>(
+                            new PlainVanillaPayoff(Option::Put, strikes[7])),
+                       exercise);
+    put.setPricingEngine(digitalEngine);
+    const Real npvCalculated = put.NPV();
+    put.setPricingEngine(singleStrikeEngine);
+    const Real npvExpected = put.NPV();
+    if (std::fabs(npvCalculated-npvExpected) > relTol*npvExpected) {
+        BOOST_FAIL("failed to reproduce price after pricing a digital "
+                   "with FD multi strike engine"
+                   << "\n    strike:     " << strikes[7]
+                   << "\n    calculated: " << npvCalculated
+                   << "\n    expected:   " << npvExpected);
+    }
+
+    // with a smile, the other strikes can't be obtained by homogeneity
+    // and each option is priced with its own solve
+    std::vector<Date> smileDates;
+    smileDates.push_back(Date(28, September, 2004));
+    smileDates.push_back(Date(28, March, 2005));
+    std::vector<Real> smileStrikes;
+    smileStrikes.push_back(70.0);
+    smileStrikes.push_back(100.0);
+    smileStrikes.push_back(130.0);
+    Matrix smileVols(3, 2);
+    smileVols[0][0] = 0.35; smileVols[0][1] = 0.32;
+    smileVols[1][0] = 0.25; smileVols[1][1] = 0.25;
+    smileVols[2][0] = 0.30; smileVols[2][1] = 0.28;
+
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> smileProcess(
+        new BlackScholesMertonProcess(
+            process->stateVariable(),
+            process->dividendYield(),
+            process->riskFreeRate(),
+            Handle<BlackVolTermStructure>(boost::shared_ptr<
+                BlackVolTermStructure>(new BlackVarianceSurface(
+                    today, TARGET(), smileDates, smileStrikes,
+                    smileVols, dc)))));
+
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> smileEngine(
+                  new FdBlackScholesVanillaEngine(smileProcess, 100, 400));
+    smileEngine->enableMultipleStrikesCaching(strikes);
+    const boost::shared_ptr<PricingEngine> smileSingleStrikeEngine(
+                  new FdBlackScholesVanillaEngine(smileProcess, 100, 400));
+
+    Size smileIndices[] = { 3, 7 };
+    for (Size i=0; i < LENGTH(smileIndices); ++i) {
+        const Real strike = strikes[smileIndices[i]];
+        EuropeanOption option(boost::shared_ptr<StrikedTypePayoff>(
+                                 new PlainVanillaPayoff(Option::Put, strike)),
+                              exercise);
+        option.setPricingEngine(smileEngine);
+        const Real npvCalculated = option.NPV();
+        option.setPricingEngine(smileSingleStrikeEngine);
+        const Real npvExpected = option.NPV();
+        if (std::fabs(npvCalculated-npvExpected) > 1e-12*npvExpected) {
+            BOOST_FAIL("failed to fall back to a single strike solve "
+                       "on a smile surface"
+                       << "\n    strike:     " << strike
+                       << "\n    calculated: " << npvCalculated
+                       << "\n    expected:   " << npvExpected);
+        }
+    }
+}
+
 
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
@@ -1541,6 +1687,8 @@ test_suite* EuropeanOptionTest::suite() {
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &EuropeanOptionTest::testFdMultipleStrikesEngine));
 
     return suite;
 }
@@ -40,6 +40,7 @@
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
@@ -50,6 +51,11 @@
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdm2dblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmhullwhiteop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmg2op.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
@@ -137,6 +143,55 @@ namespace {
         }
     };
 
+    void checkInPlaceResult(const std::string& name,
+                            const std::string& method,
+                            const Array& expected, const Array& calculated,
+                            const Real* storage) {
+        // the array passed by the caller must be reused as it is
+        if (calculated.begin() != storage)
+            BOOST_FAIL("in-place version allocated a new array"
+                       << "\n operator   : " << name
+                       << "\n method     : " << method);
+        const Real tol = 1e-14;
+        for (Size i=0; i < expected.size(); ++i) {
+            if (std::fabs(expected[i] - calculated[i]) > tol) {
+                BOOST_FAIL("in-place and returning versions differ"
+                           << "\n operator   : " << name
+                           << "\n method     : " << method
+                           << "\n index      : " << i
+                           << "\n expected   : " << expected[i]
+                           << "\n calculated : " << calculated[i]);
+            }
+        }
+    }
+
+    void checkInPlaceOperator(const std::string& name,
+                              const boost::shared_ptr<FdmLinearOpComposite>& op,
+                              const Array& u) {
+        op->setTime(0.25, 0.3);
+
+        // the first call of each method may size the output array
+        Array y(u.size());
+        const Real* storage = y.begin();
+        op->apply_into(u, y);
+        checkInPlaceResult(name, "apply", op->apply(u), y, storage);
+        op->apply_mixed_into(u, y);
+        checkInPlaceResult(name, "apply_mixed",
+                           op->apply_mixed(u), y, storage);
+        for (Size direction=0; direction < op->size(); ++direction) {
+            op->apply_direction_into(direction, u, y);
+            checkInPlaceResult(name, "apply_direction",
+                               op->apply_direction(direction, u), y, storage);
+            op->solve_splitting_into(direction, u, -0.01, y);
+            checkInPlaceResult(name, "solve_splitting",
+                               op->solve_splitting(direction, u, -0.01),
+                               y, storage);
+        }
+        // work arrays are allocated by the first calls only
+        op->apply_into(u, y);
+        checkInPlaceResult(name, "apply", op->apply(u), y, storage);
+    }
+
     template <class T, class U, class V>
     struct multiplies : public std::binary_function<T, U, V> {
         V operator()(T t, U u) { return t*u;}
@@ -591,6 +646,175 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
 }
 
 
+void FdmLinearOpTest::testTripleBandMapSolveInAllDirections() {
+
+    BOOST_TEST_MESSAGE("Testing triple-band map solution "
+                       "in all directions of a 3D grid...");
+
+    // sizes are chosen so that lines are solved in partial tiles
+    Size dims[] = {37, 70, 5};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(0.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 2.0));
+    boundaries.push_back(std::pair<Real, Real>(0.5, 1.5));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real a = -0.01, b = 1.5;
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        SecondDerivativeOp op(direction, mesher);
+        op.axpyb(Array(1, 0.3), FirstDerivativeOp(direction, mesher),
+                 op, Array());
+
+        // x solves (a*op + b) x = u
+        const Array x = op.solve_splitting(u, a, b);
+        const Array t = a*op.apply(x) + b*x;
+
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(u[i] - t[i]) > 1e-10) {
+                BOOST_FAIL("solve and apply are not consistent "
+                           << "\n direction     : " << direction
+                           << "\n index         : " << i
+                           << "\n expected      : " << u[i]
+                           << "\n calculated    : " << t[i]);
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testTripleBandMapSolveWithCachedFactorization() {
+
+    BOOST_TEST_MESSAGE("Testing triple-band map solution "
+                       "with cached factorization...");
+
+    Size dims[] = {30, 20, 10};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    boost::shared_ptr<FdmMesher> mesher(new UniformGridMesher(
+        layout, std::vector<std::pair<Real, Real> >(
+                                    3, std::pair<Real, Real>(-1.0, 2.0))));
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        const FirstDerivativeOp dx(direction, mesher);
+        const SecondDerivativeOp dxx(direction, mesher);
+
+        TripleBandLinearOp op(direction, mesher);
+        Array x;
+        for (Size k=0; k < 6; ++k) {
+            // the coefficients are set to the same values twice in a
+            // row, and a changes every third step
+            const Real drift = 0.1*(k/2);
+            const Real a = (k % 3 == 2) ? -0.02 : -0.01;
+            op.axpyb(Array(1, drift), dx, dxx, Array(1, -0.05));
+
+            op.solve_splitting_into(u, a, 1.0, x);
+            const Array expected = TripleBandLinearOp(op)
+                                                .solve_splitting(u, a, 1.0);
+
+            for (Size i=0; i < u.size(); ++i) {
+                if (std::fabs(x[i] - expected[i]) > 1e-12) {
+                    BOOST_FAIL("cached factorization gives wrong solution"
+                               << "\n direction  : " << direction
+                               << "\n step       : " << k
+                               << "\n index      : " << i
+                               << "\n expected   : " << expected[i]
+                               << "\n calculated : " << x[i]);
+                }
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testInPlaceOperators() {
+
+    BOOST_TEST_MESSAGE("Testing in-place versions of FDM operators...");
+
+    SavedSettings backup;
+
+    Size dims[] = {40, 21, 11};
+    const std::vector<Size> dim2(dims, dims+2), dim3(dims, dims+3);
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, 4.905274778));
+    boundaries.push_back(std::pair<Real, Real>(0.0, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher2d(
+        new UniformGridMesher(boost::shared_ptr<FdmLinearOpLayout>(
+                                  new FdmLinearOpLayout(dim2)), boundaries));
+
+    boundaries.push_back(std::pair<Real, Real>(-0.1, 0.1));
+    boost::shared_ptr<FdmMesher> mesher3d(
+        new UniformGridMesher(boost::shared_ptr<FdmLinearOpLayout>(
+                                  new FdmLinearOpLayout(dim3)), boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+    boost::shared_ptr<GeneralizedBlackScholesProcess> bsProcess1(
+        new BlackScholesMertonProcess(s0, qTS, rTS,
+                                      Handle<BlackVolTermStructure>(
+                                         flatVol(0.20, Actual365Fixed()))));
+    boost::shared_ptr<GeneralizedBlackScholesProcess> bsProcess2(
+        new BlackScholesMertonProcess(s0, qTS, rTS,
+                                      Handle<BlackVolTermStructure>(
+                                         flatVol(0.35, Actual365Fixed()))));
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+                                   new HullWhiteProcess(rTS, 0.07, 0.01));
+    boost::shared_ptr<HullWhite> hwModel(new HullWhite(rTS, 0.07, 0.01));
+    boost::shared_ptr<G2> g2Model(new G2(rTS, 0.07, 0.01, 0.1, 0.012, -0.6));
+
+    std::vector<std::pair<std::string,
+                          boost::shared_ptr<FdmLinearOpComposite> > > ops;
+    ops.push_back(std::make_pair(std::string("Black-Scholes"),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmBlackScholesOp(mesher2d, bsProcess1, 100.0))));
+    ops.push_back(std::make_pair(std::string("2D Black-Scholes"),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new Fdm2dBlackScholesOp(mesher2d, bsProcess1, bsProcess2,
+                                    0.4, 1.0))));
+    ops.push_back(std::make_pair(std::string("Heston"),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmHestonOp(mesher2d, hestonProcess))));
+    ops.push_back(std::make_pair(std::string("Hull-White"),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmHullWhiteOp(mesher3d, hwModel, 2))));
+    ops.push_back(std::make_pair(std::string("G2"),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmG2Op(mesher2d, g2Model, 0, 1))));
+    ops.push_back(std::make_pair(std::string("Heston-Hull-White"),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmHestonHullWhiteOp(mesher3d, hestonProcess,
+                                     hwProcess, 0.5))));
+
+    for (Size i=0; i < ops.size(); ++i) {
+        const Size n = (ops[i].first == "Hull-White" ||
+                        ops[i].first == "Heston-Hull-White")
+            ? mesher3d->layout()->size() : mesher2d->layout()->size();
+        Array u(n);
+        for (Size j=0; j < n; ++j)
+            u[j] = std::sin(0.1*j)+std::cos(0.35*j);
+
+        checkInPlaceOperator(ops[i].first, ops[i].second, u);
+    }
+}
+
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1146,6 +1370,186 @@ void FdmLinearOpTest::testBiCGstab() {
 #endif
 }
 
+void FdmLinearOpTest::testGMRES() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing GMRES algorithm with Heston operator...");
+
+    SavedSettings backup;
+
+    const Size n=41, m=21;
+    const Real theta = 1.0;
+    boost::numeric::ublas::compressed_matrix<Real> a(n*m, n*m);
+
+    for (Size i=0; i < n; ++i) {
+        for (Size j=0; j < m; ++j) {
+            const Size k = i*m+j;
+            a(k,k)=1.0;
+
+            if (i > 0 && j > 0 && i <n-1 && j < m-1) {
+                const Size im1 = i-1;
+                const Size ip1 = i+1;
+                const Size jm1 = j-1;
+                const Size jp1 = j+1;
+                const Real delta = theta/((ip1-im1)*(jp1-jm1));
+
+                a(k,im1*m+jm1) =  delta;
+                a(k,im1*m+jp1) = -delta;
+                a(k,ip1*m+jm1) = -delta;
+                a(k,ip1*m+jp1) =  delta;
+            }
+        }
+    }
+
+    boost::function<Disposable<Array>(const Array&)> matmult(
+                                                    boost::bind(&axpy, a, _1));
+
+    SparseILUPreconditioner ilu(a, 4);
+    boost::function<Disposable<Array>(const Array&)> precond(
+         boost::bind(&SparseILUPreconditioner::apply, &ilu, _1));
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-10;
+
+    const GMRES gmres(matmult, n*m, tol, precond);
+    const GMRESResult result = gmres.solve(b, b);
+    const Array x = result.x;
+
+    const Real errorCalculated = result.errors.back();
+    if (errorCalculated > tol) {
+        BOOST_FAIL("Error calculating the inverse using GMRES" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << errorCalculated);
+    }
+
+    const Real error = std::sqrt(DotProduct(b-axpy(a, x),
+                                 b-axpy(a, x))/DotProduct(b,b));
+    if (error > 10*tol) {
+        BOOST_FAIL("Error calculating the inverse using GMRES" <<
+                "\n tolerance:  " << 10*tol <<
+                "\n error:      " << error);
+    }
+
+    const GMRES gmresRestart(matmult, 5, tol, precond);
+    const Array xRestart = gmresRestart.solveWithRestart(100, b, b).x;
+
+    const Real errorRestart = std::sqrt(DotProduct(b-axpy(a, xRestart),
+                                b-axpy(a, xRestart))/DotProduct(b,b));
+    if (errorRestart > 10*tol) {
+        BOOST_FAIL("Error calculating the inverse using "
+                   "GMRES with restarts" <<
+                "\n tolerance:  " << 10*tol <<
+                "\n error:      " << errorRestart);
+    }
+#endif
+}
+
+void FdmLinearOpTest::testImplicitEulerSolvers() {
+    BOOST_TEST_MESSAGE("Testing implicit Euler scheme "
+                       "with BiCGstab and GMRES solvers...");
+
+    SavedSettings backup;
+
+    Size dims[] = {40, 21};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, 4.905274778));
+    boundaries.push_back(std::pair<Real, Real>(0.0, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    boost::shared_ptr<FdmLinearOpComposite> hestonOp(
+                                   new FdmHestonOp(mesher, hestonProcess));
+
+    Array rhs(layout->size());
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin();
+         iter != endIter; ++iter) {
+        rhs[iter.index()]=std::max(std::exp(mesher->location(iter,0))-100, 0.0);
+    }
+
+    const Real relTol = 1e-10;
+    Array biCGstabResult(rhs), gmresResult(rhs);
+
+    ImplicitEulerScheme biCGstabEvolver(hestonOp, FdmBoundaryConditionSet(),
+                                        relTol,
+                                        ImplicitEulerScheme::BiCGstabSolver);
+    FiniteDifferenceModel<ImplicitEulerScheme> biCGstabModel(
+                                                            biCGstabEvolver);
+    biCGstabModel.rollback(biCGstabResult, 1.0, 0.0, 10);
+
+    ImplicitEulerScheme gmresEvolver(hestonOp, FdmBoundaryConditionSet(),
+                                     relTol, ImplicitEulerScheme::GMRESSolver);
+    FiniteDifferenceModel<ImplicitEulerScheme> gmresModel(gmresEvolver);
+    gmresModel.rollback(gmresResult, 1.0, 0.0, 10);
+
+    for (Size i=0; i < rhs.size(); ++i) {
+        if (std::fabs(biCGstabResult[i] - gmresResult[i])
+                                > 1e-6*std::max(1.0, biCGstabResult[i])) {
+            BOOST_FAIL("BiCGstab and GMRES results differ"
+                       << "\n index    : " << i
+                       << "\n BiCGstab : " << biCGstabResult[i]
+                       << "\n GMRES    : " << gmresResult[i]);
+        }
+    }
+
+    // the solver choice must reach the scheme via the scheme
+    // description; the backward solver uses a tolerance of 1e-8,
+    // so its results are compared with those of the scheme using
+    // the same solver and tolerance.
+    const Real backwardTol = 1e-8;
+    Array biCGstabExpected(rhs), gmresExpected(rhs);
+    ImplicitEulerScheme biCGstabReference(
+        hestonOp, FdmBoundaryConditionSet(),
+        backwardTol, ImplicitEulerScheme::BiCGstabSolver);
+    FiniteDifferenceModel<ImplicitEulerScheme>(biCGstabReference)
+        .rollback(biCGstabExpected, 1.0, 0.0, 10);
+    ImplicitEulerScheme gmresReference(
+        hestonOp, FdmBoundaryConditionSet(),
+        backwardTol, ImplicitEulerScheme::GMRESSolver);
+    FiniteDifferenceModel<ImplicitEulerScheme>(gmresReference)
+        .rollback(gmresExpected, 1.0, 0.0, 10);
+
+    Array biCGstabSolverResult(rhs), gmresSolverResult(rhs);
+    FdmBackwardSolver(hestonOp, FdmBoundaryConditionSet(),
+                      boost::shared_ptr<FdmStepConditionComposite>(),
+                      FdmSchemeDesc::ImplicitEuler())
+        .rollback(biCGstabSolverResult, 1.0, 0.0, 10, 0);
+    FdmBackwardSolver(hestonOp, FdmBoundaryConditionSet(),
+                      boost::shared_ptr<FdmStepConditionComposite>(),
+                      FdmSchemeDesc::ImplicitEulerGMRES())
+        .rollback(gmresSolverResult, 1.0, 0.0, 10, 0);
+
+    for (Size i=0; i < rhs.size(); ++i) {
+        if (std::fabs(biCGstabSolverResult[i] - biCGstabExpected[i])
+                        > 1e-12*std::max(1.0, std::fabs(biCGstabExpected[i]))
+            || std::fabs(gmresSolverResult[i] - gmresExpected[i])
+                        > 1e-12*std::max(1.0, std::fabs(gmresExpected[i]))) {
+            BOOST_FAIL("backward solver doesn't use the requested solver"
+                       << "\n index             : " << i
+                       << "\n BiCGstab scheme   : " << biCGstabExpected[i]
+                       << "\n BiCGstab backward : " << biCGstabSolverResult[i]
+                       << "\n GMRES scheme      : " << gmresExpected[i]
+                       << "\n GMRES backward    : " << gmresSolverResult[i]);
+        }
+    }
+}
+
 void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 
     BOOST_TEST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1319,6 +1723,70 @@ void FdmLinearOpTest::testSparseMatrixZeroAssignment() {
 #endif
 }
 
+void FdmLinearOpTest::testStencilApplyAgainstMatrix() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing strided stencil application "
+                       "against sparse matrix product...");
+
+    // grids with short directions exercise the boundary handling
+    Size dims[][3] = { {7, 2, 5}, {2, 4, 3}, {3, 3, 9}, {20, 11, 6} };
+
+    for (Size k=0; k < LENGTH(dims); ++k) {
+        const std::vector<Size> dim(dims[k], dims[k]+3);
+        boost::shared_ptr<FdmLinearOpLayout> layout(
+                                              new FdmLinearOpLayout(dim));
+        boost::shared_ptr<FdmMesher> mesher(new UniformGridMesher(
+            layout, std::vector<std::pair<Real, Real> >(
+                                    3, std::pair<Real, Real>(-1.0, 2.0))));
+
+        Array u(layout->size());
+        for (Size i=0; i < layout->size(); ++i)
+            u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+        for (Size d0=0; d0 < dim.size(); ++d0) {
+            const TripleBandLinearOp op
+                = SecondDerivativeOp(d0, mesher)
+                    .add(FirstDerivativeOp(d0, mesher).mult(u));
+
+            const Array expected = axpy(op.toMatrix(), u);
+            const Array calculated = op.apply(u);
+            for (Size i=0; i < u.size(); ++i) {
+                if (std::fabs(expected[i]-calculated[i])
+                        > 1e-12*std::max(1.0, std::fabs(expected[i]))) {
+                    BOOST_FAIL("triple band apply differs from matrix"
+                               << "\n direction  : " << d0
+                               << "\n index      : " << i
+                               << "\n expected   : " << expected[i]
+                               << "\n calculated : " << calculated[i]);
+                }
+            }
+
+            for (Size d1=0; d1 < dim.size(); ++d1) {
+                if (d0 == d1)
+                    continue;
+
+                const NinePointLinearOp op
+                    = SecondOrderMixedDerivativeOp(d0, d1, mesher).mult(u);
+
+                const Array expected = axpy(op.toMatrix(), u);
+                const Array calculated = op.apply(u);
+                for (Size i=0; i < u.size(); ++i) {
+                    if (std::fabs(expected[i]-calculated[i])
+                            > 1e-12*std::max(1.0, std::fabs(expected[i]))) {
+                        BOOST_FAIL("nine point apply differs from matrix"
+                                   << "\n directions : "
+                                   << d0 << ", " << d1
+                                   << "\n index      : " << i
+                                   << "\n expected   : " << expected[i]
+                                   << "\n calculated : " << calculated[i]);
+                    }
+                }
+            }
+        }
+    }
+#endif
+}
+
 void FdmLinearOpTest::testFdmMesherIntegral() {
     BOOST_TEST_MESSAGE("Testing integrals over meshers functions...");
 
@@ -1390,17 +1858,26 @@ test_suite* FdmLinearOpTest::suite() {
             &FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testTripleBandMapSolveInAllDirections));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testTripleBandMapSolveWithCachedFactorization));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testInPlaceOperators));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testImplicitEulerSolvers));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testStencilApplyAgainstMatrix));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmMesherIntegral));
 
     return suite;
@@ -35,14 +35,20 @@ public:
     static void testSecondDerivativesMapApply();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandMapSolveInAllDirections();
+    static void testTripleBandMapSolveWithCachedFactorization();
+    static void testInPlaceOperators();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
     static void testBiCGstab();
+    static void testGMRES();
+    static void testImplicitEulerSolvers();
     static void testCrankNicolsonWithDamping();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
+    static void testStencilApplyAgainstMatrix();
     static void testFdmMesherIntegral();
 
     static boost::unit_test_framework::test_suite* suite();
@@ -23,6 +23,8 @@
 #include <ql/math/functional.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/linearleastsquaresregression.hpp>
+#include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/genericlsregression.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -250,6 +252,104 @@ void LinearLeastSquaresRegressionTest::test1dLinearRegression() {
 }
 
 
+void LinearLeastSquaresRegressionTest::testLsmRegressionKernel() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing batched basis values and normal-equations regression...");
+
+    SavedSettings backup;
+
+    const Size nr = 5000;
+    const Size order = 4;
+    PseudoRandom::rng_type rng(PseudoRandom::urng_type(1234u));
+
+    const LsmBasisSystem::PolynomType types[] = {
+        LsmBasisSystem::Monomial, LsmBasisSystem::Laguerre,
+        LsmBasisSystem::Hermite, LsmBasisSystem::Hyperbolic,
+        LsmBasisSystem::Legendre, LsmBasisSystem::Chebyshev,
+        LsmBasisSystem::Chebyshev2nd };
+
+    MersenneTwisterUniformRng uniform(4321u);
+
+    std::vector<Real> x(nr), y(nr);
+    for (Size i=0; i<nr; ++i) {
+        // inside the domain of every polynomial family
+        x[i] = 0.05 + 0.9*uniform.next().value;
+        y[i] = std::exp(x[i]) + 0.1*rng.next().value;
+    }
+
+    for (Size t=0; t<LENGTH(types); ++t) {
+        const std::vector<boost::function1<Real, Real> > v =
+            LsmBasisSystem::pathBasisSystem(order, types[t]);
+        const Matrix A =
+            LsmBasisSystem::pathBasisValues(order, types[t], x);
+
+        if (A.rows() != nr || A.columns() != v.size())
+            BOOST_FAIL("wrong design matrix size for polynom type " << t
+                       << "\n    rows:     " << A.rows()
+                       << "\n    columns:  " << A.columns());
+
+        for (Size i=0; i<nr; ++i) {
+            for (Size l=0; l<v.size(); ++l) {
+                const Real expected = v[l](x[i]);
+                if (std::fabs(A[i][l] - expected)
+                        > 1e-12*std::max(1.0, std::fabs(expected))) {
+                    BOOST_FAIL("failed to reproduce basis function value"
+                               << "\n    polynom type: " << t
+                               << "\n    order:        " << l
+                               << "\n    x:            " << x[i]
+                               << "\n    calculated:   " << A[i][l]
+                               << "\n    expected:     " << expected);
+                }
+            }
+        }
+
+        // some families are badly conditioned on the sample (and the
+        // normal equations square the condition number), so the fitted
+        // values are compared instead of the coefficients
+        const Array a = leastSquaresRegression(A, Array(y.begin(), y.end()));
+        const Array calculated = A*a;
+        const Array expected =
+            A*GeneralLinearLeastSquares(x, y, v).coefficients();
+
+        const Real tol = 1e-6;
+        for (Size i=0; i<nr; ++i) {
+            if (std::fabs(calculated[i] - expected[i]) > tol) {
+                BOOST_FAIL("failed to reproduce regression value"
+                           << "\n    polynom type: " << t
+                           << "\n    x:            " << x[i]
+                           << "\n    calculated:   " << calculated[i]
+                           << "\n    expected:     " << expected[i]);
+            }
+        }
+    }
+
+    // collinear basis functions: the SVD fallback must kick in
+    Matrix A(nr, 3);
+    for (Size i=0; i<nr; ++i) {
+        A[i][0] = 1.0;
+        A[i][1] = x[i];
+        A[i][2] = 2.0*x[i];
+    }
+    const Array a = leastSquaresRegression(A, Array(y.begin(), y.end()));
+
+    std::vector<boost::function1<Real, Real> > w;
+    w.push_back(constant<Real, Real>(1.0));
+    w.push_back(identity<Real>());
+    const Array expected = GeneralLinearLeastSquares(x, y, w).coefficients();
+
+    const Real tol = 1e-8;
+    if (std::fabs(a[0] - expected[0]) > tol
+        || std::fabs(a[1] + 2.0*a[2] - expected[1]) > tol) {
+        BOOST_ERROR("failed to regress on collinear basis functions"
+                    << "\n    calculated: " << a[0] << " + "
+                    << a[1] + 2.0*a[2] << "*x"
+                    << "\n    expected:   " << expected[0] << " + "
+                    << expected[1] << "*x");
+    }
+}
+
+
 test_suite* LinearLeastSquaresRegressionTest::suite() {
     test_suite* suite =
         BOOST_TEST_SUITE("linear least squares regression tests");
@@ -259,6 +359,8 @@ test_suite* LinearLeastSquaresRegressionTest::suite() {
         &LinearLeastSquaresRegressionTest::testMultiDimRegression));
     suite->add(QUANTLIB_TEST_CASE(
         &LinearLeastSquaresRegressionTest::test1dLinearRegression));
+    suite->add(QUANTLIB_TEST_CASE(
+        &LinearLeastSquaresRegressionTest::testLsmRegressionKernel));
     return suite;
 }
 
@@ -42,6 +42,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/batchlognormalfwdratepc.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -1274,6 +1275,189 @@ void MarketModelTest::testAllMultiStepProducts() {
 }
 
 
+void MarketModelTest::testBatchEvolution() {
+
+    BOOST_TEST_MESSAGE("Testing batched against single-path evolution "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    addCoinitialSwaps(product, subProductExpectedValues);
+    addCoterminalSwapsAndSwaptions(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+
+    // not a multiple of the batch size, so that the last batch is partial
+    const Size paths = std::min<Size>(paths_, 4095);
+    const Size batchSize = 64;
+    const Real tolerance = 1.0e-12;
+
+    MarketModelType marketModels[] = {
+        ExponentialCorrelationFlatVolatility,
+        ExponentialCorrelationAbcdVolatility };
+    for (Size j=0; j<LENGTH(marketModels); j++) {
+        Size testedFactors[] = { 4, todaysForwards.size() };
+        for (Size m=0; m<LENGTH(testedFactors); ++m) {
+            Size factors = testedFactors[m];
+            MeasureType measures[] = { Terminal, MoneyMarket };
+            for (Size k=0; k<LENGTH(measures); k++) {
+                std::vector<Size> numeraires =
+                    makeMeasure(product, measures[k]);
+                bool logNormal = true;
+                boost::shared_ptr<MarketModel> marketModel =
+                    makeMarketModel(logNormal, evolution, factors,
+                                    marketModels[j]);
+                Real initialNumeraireValue =
+                    todaysDiscounts[numeraires.front()];
+
+                SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+
+                boost::shared_ptr<MarketModelEvolver> evolver(
+                    new LogNormalFwdRatePc(marketModel, generatorFactory,
+                                           numeraires));
+                AccountingEngine engine(evolver, product,
+                                        initialNumeraireValue);
+                SequenceStatisticsInc stats(product.numberOfProducts());
+                engine.multiplePathValues(stats, paths);
+
+                boost::shared_ptr<MarketModelBatchEvolver> batchEvolver(
+                    new BatchLogNormalFwdRatePc(marketModel, generatorFactory,
+                                                numeraires, batchSize));
+                BatchAccountingEngine batchEngine(batchEvolver, product,
+                                                  initialNumeraireValue);
+                SequenceStatisticsInc batchStats(product.numberOfProducts());
+                batchEngine.multiplePathValues(batchStats, paths);
+
+                if (batchStats.samples() != stats.samples())
+                    BOOST_ERROR("wrong number of samples"
+                                << "\n    single-path: " << stats.samples()
+                                << "\n    batched:     "
+                                << batchStats.samples());
+
+                std::vector<Real> expected = stats.mean();
+                std::vector<Real> calculated = batchStats.mean();
+                for (Size i=0; i<expected.size(); ++i) {
+                    Real error = std::fabs(calculated[i]-expected[i]);
+                    if (error > tolerance)
+                        BOOST_ERROR("failed to reproduce single-path results"
+                                    << "\n    " << marketModelTypeToString(
+                                                         marketModels[j])
+                                    << ", " << factors << " factors, "
+                                    << measureTypeToString(measures[k])
+                                    << "\n    " << io::ordinal(i+1)
+                                    << " product"
+                                    << std::scientific
+                                    << "\n    single-path: " << expected[i]
+                                    << "\n    batched:     " << calculated[i]
+                                    << "\n    error:       " << error
+                                    << "\n    tolerance:   " << tolerance);
+                }
+            }
+        }
+    }
+}
+
+
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing accounting engine with several workers...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    addCoterminalSwapsAndSwaptions(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarket);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size paths = std::min<Size>(paths_, 4095);
+    const Size workers = 3;
+    const Real tolerance = 1.0e-12;
+
+    MTBrownianGeneratorFactory generatorFactory(seed_);
+    boost::shared_ptr<MarketModelEvolver> evolver(
+        new LogNormalFwdRatePc(marketModel, generatorFactory, numeraires));
+    Size n = product.numberOfProducts();
+
+    AccountingEngine engine(evolver, product, initialNumeraireValue);
+    SequenceStatisticsInc stats(n);
+    engine.multiplePathValues(stats, paths);
+
+    // the workers simulate clones of the evolver, so the results
+    // don't depend on the paths it already drew
+    AccountingEngine parallelEngine(evolver, product,
+                                    initialNumeraireValue, workers);
+    SequenceStatisticsInc parallelStats(n);
+    parallelEngine.multiplePathValues(parallelStats, paths);
+
+    AccountingEngine otherEngine(evolver, product,
+                                 initialNumeraireValue, workers);
+    SequenceStatisticsInc otherStats(n);
+    otherEngine.multiplePathValues(otherStats, paths);
+
+    // a second call must go on with new paths
+    SequenceStatisticsInc nextStats(n);
+    parallelEngine.multiplePathValues(nextStats, paths);
+
+    if (parallelStats.samples() != stats.samples()
+        || nextStats.samples() != stats.samples())
+        BOOST_FAIL("wrong number of samples"
+                   << "\n    serial:   " << stats.samples()
+                   << "\n    parallel: " << parallelStats.samples()
+                   << "\n    next:     " << nextStats.samples());
+
+    std::vector<Real> means = stats.mean();
+    std::vector<Real> errors = stats.errorEstimate();
+    std::vector<Real> parallelMeans = parallelStats.mean();
+    std::vector<Real> parallelErrors = parallelStats.errorEstimate();
+    std::vector<Real> otherMeans = otherStats.mean();
+    std::vector<Real> otherErrors = otherStats.errorEstimate();
+    std::vector<Real> nextMeans = nextStats.mean();
+    for (Size i=0; i<n; ++i) {
+        if (std::fabs(parallelMeans[i]-otherMeans[i]) > tolerance
+            || std::fabs(parallelErrors[i]-otherErrors[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce parallel results for "
+                        << io::ordinal(i+1) << " product"
+                        << std::scientific
+                        << "\n    first mean:   " << parallelMeans[i]
+                        << "\n    second mean:  " << otherMeans[i]
+                        << "\n    first error:  " << parallelErrors[i]
+                        << "\n    second error: " << otherErrors[i]
+                        << "\n    tolerance:    " << tolerance);
+
+        Real error = std::sqrt(errors[i]*errors[i]
+                               + parallelErrors[i]*parallelErrors[i]);
+        if (std::fabs(parallelMeans[i]-means[i]) > 4.0*error + tolerance)
+            BOOST_ERROR("parallel results inconsistent with serial ones for "
+                        << io::ordinal(i+1) << " product"
+                        << std::scientific
+                        << "\n    serial mean:    " << means[i]
+                        << "\n    parallel mean:  " << parallelMeans[i]
+                        << "\n    error estimate: " << error);
+
+        if (parallelErrors[i] > 0.0 && nextMeans[i] == parallelMeans[i])
+            BOOST_ERROR("same paths drawn by successive calls for "
+                        << io::ordinal(i+1) << " product"
+                        << std::scientific
+                        << "\n    mean: " << nextMeans[i]);
+    }
+}
+
+
 void MarketModelTest::testPeriodAdapter() {
 
     BOOST_TEST_MESSAGE("Testing period-adaptation routines in LIBOR market model...");
@@ -4891,6 +5075,8 @@ test_suite* MarketModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testStochVolForwardsAndOptionlets));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAllMultiStepProducts));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBatchEvolution));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelAccountingEngine));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testOneStepForwardsAndOptionlets));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testOneStepNormalForwardsAndOptionlets));
@@ -33,6 +33,8 @@ class MarketModelTest {
     static void testInverseFloater();
     static void testPeriodAdapter();
     static void testAllMultiStepProducts();
+    static void testBatchEvolution();
+    static void testParallelAccountingEngine();
     static void testOneStepForwardsAndOptionlets();
     static void testOneStepNormalForwardsAndOptionlets();
     static void testCallableSwapNaif();
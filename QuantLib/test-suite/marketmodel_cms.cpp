@@ -25,6 +25,7 @@
 #include <ql/models/marketmodels/correlations/timehomogeneousforwardcorrelation.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
 #include <ql/models/marketmodels/curvestates/cmswapcurvestate.hpp>
+#include <ql/models/marketmodels/evolvers/batchlognormalcmswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalcmswapratepc.hpp>
 #include <ql/legacy/libormarketmodels/lmlinexpcorrmodel.hpp>
 #include <ql/legacy/libormarketmodels/lmextlinexpvolmodel.hpp>
@@ -75,7 +76,7 @@ namespace {
     Real longTermCorrelation, beta;
     Size measureOffset_;
     unsigned long seed_;
-    Size paths_, trainingPaths_;
+    Size paths_, trainingPaths_, batchSize_;
     bool printReport_ = false;
     Size spanningForwards;
 
@@ -165,6 +166,7 @@ namespace {
         paths_ = 32767; //262144-1; //; // 2^15-1
         trainingPaths_ = 8191; // 2^13-1
         #endif
+        batchSize_ = 64;
     }
 
     const boost::shared_ptr<SequenceStatisticsInc> simulate(
@@ -180,6 +182,19 @@ namespace {
         return stats;
     }
 
+    const boost::shared_ptr<SequenceStatisticsInc> simulate(
+                   const boost::shared_ptr<MarketModelBatchEvolver>& evolver,
+                   const MarketModelMultiProduct& product) {
+        Size initialNumeraire = evolver->numeraires().front();
+        Real initialNumeraireValue = todaysDiscounts[initialNumeraire];
+
+        BatchAccountingEngine engine(evolver, product, initialNumeraireValue);
+        boost::shared_ptr<SequenceStatisticsInc> stats(
+                          new SequenceStatisticsInc(product.numberOfProducts()));
+        engine.multiplePathValues(*stats, paths_);
+        return stats;
+    }
+
 
     enum MarketModelType { ExponentialCorrelationFlatVolatility,
                            ExponentialCorrelationAbcdVolatility/*,
@@ -357,6 +372,24 @@ namespace {
         }
     }
 
+    boost::shared_ptr<MarketModelBatchEvolver> makeMarketModelBatchEvolver(
+                            const boost::shared_ptr<MarketModel>& marketModel,
+                            const std::vector<Size>& numeraires,
+                            const BrownianGeneratorFactory& generatorFactory,
+                            EvolverType evolverType,
+                            Size initialStep = 0) {
+        switch (evolverType) {
+          case Pc:
+            return boost::shared_ptr<MarketModelBatchEvolver>(new
+                BatchLogNormalCmSwapRatePc(spanningForwards,
+                                           marketModel, generatorFactory,
+                                           numeraires, batchSize_,
+                                           initialStep));
+          default:
+            QL_FAIL("unknown batched ConstantMaturitySwapMarketModelEvolver type");
+        }
+    }
+
 
     void checkCMSAndSwaptions(
               const SequenceStatisticsInc& stats,
@@ -530,6 +563,87 @@ void MarketModelCmsTest::testMultiStepCmSwapsAndSwaptions() {
 }
 
 
+void MarketModelCmsTest::testBatchEvolution() {
+
+    BOOST_TEST_MESSAGE("Testing batched against single-path evolution "
+                       "in a lognormal constant maturity swap market model...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+
+    std::vector<Time> swapPaymentTimes(rateTimes.begin()+1, rateTimes.end());
+    MultiStepCoterminalSwaps swaps(rateTimes, accruals, accruals,
+                                   swapPaymentTimes,
+                                   fixedRate);
+    std::vector<Time> swaptionPaymentTimes(rateTimes.begin(), rateTimes.end()-1);
+    std::vector<boost::shared_ptr<StrikedTypePayoff> >
+        payoffs(todaysForwards.size());
+    for (Size i=0; i<payoffs.size(); ++i)
+        payoffs[i] = boost::shared_ptr<StrikedTypePayoff>(new
+            PlainVanillaPayoff(Option::Call, fixedRate));
+    MultiStepCoterminalSwaptions swaptions(rateTimes,
+                                           swaptionPaymentTimes,
+                                           payoffs);
+    MultiProductComposite product;
+    product.add(swaps);
+    product.add(swaptions);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+
+    // not a multiple of the batch size, so that the last batch is partial
+    paths_ = std::min<Size>(paths_, 4095);
+    const Real tolerance = 1.0e-12;
+
+    MarketModelType marketModels[] = {
+        ExponentialCorrelationFlatVolatility,
+        ExponentialCorrelationAbcdVolatility };
+    for (Size j=0; j<LENGTH(marketModels); j++) {
+        Size testedFactors[] = { 4, todaysForwards.size() };
+        for (Size m=0; m<LENGTH(testedFactors); ++m) {
+            Size factors = testedFactors[m];
+            std::vector<Size> numeraires = makeMeasure(product, Terminal);
+            boost::shared_ptr<MarketModel> marketModel =
+                makeMarketModel(evolution, factors, marketModels[j]);
+
+            SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+            boost::shared_ptr<SequenceStatisticsInc> stats =
+                simulate(makeMarketModelEvolver(marketModel, numeraires,
+                                                generatorFactory, Pc),
+                         product);
+            boost::shared_ptr<SequenceStatisticsInc> batchStats =
+                simulate(makeMarketModelBatchEvolver(marketModel, numeraires,
+                                                     generatorFactory, Pc),
+                         product);
+
+            if (batchStats->samples() != stats->samples())
+                BOOST_ERROR("wrong number of samples"
+                            << "\n    single-path: " << stats->samples()
+                            << "\n    batched:     " << batchStats->samples());
+
+            std::vector<Real> expected = stats->mean();
+            std::vector<Real> calculated = batchStats->mean();
+            for (Size i=0; i<expected.size(); ++i) {
+                Real error = std::fabs(calculated[i]-expected[i]);
+                if (error > tolerance)
+                    BOOST_ERROR("failed to reproduce single-path results"
+                                << "\n    " << marketModelTypeToString(
+                                                         marketModels[j])
+                                << ", " << factors << " factors"
+                                << "\n    " << io::ordinal(i+1) << " product"
+                                << std::scientific
+                                << "\n    single-path: " << expected[i]
+                                << "\n    batched:     " << calculated[i]
+                                << "\n    error:       " << error
+                                << "\n    tolerance:   " << tolerance);
+            }
+        }
+    }
+}
+
+
 
 // --- Call the desired tests
 test_suite* MarketModelCmsTest::suite() {
@@ -537,6 +651,7 @@ test_suite* MarketModelCmsTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
                       &MarketModelCmsTest::testMultiStepCmSwapsAndSwaptions));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelCmsTest::testBatchEvolution));
 
     return suite;
 }
@@ -29,6 +29,7 @@
 class MarketModelCmsTest {
   public:
     static void testMultiStepCmSwapsAndSwaptions();
+    static void testBatchEvolution();
    
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -27,6 +27,7 @@
 #include <ql/models/marketmodels/products/multiproductcomposite.hpp>
 #include <ql/models/marketmodels/accountingengine.hpp>
 #include <ql/models/marketmodels/utilities.hpp>
+#include <ql/models/marketmodels/evolvers/batchlognormalcotswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalcotswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
 #include <ql/models/marketmodels/models/flatvol.hpp>
@@ -78,7 +79,7 @@ namespace {
     Real longTermCorrelation, beta;
     Size measureOffset_;
     unsigned long seed_;
-    Size paths_, trainingPaths_;
+    Size paths_, trainingPaths_, batchSize_;
     bool printReport_ = false;
 
     void setup() {
@@ -164,6 +165,7 @@ namespace {
         paths_ = 32767; //262144-1; //; // 2^15-1
         trainingPaths_ = 8191; // 2^13-1
 #endif
+        batchSize_ = 64;
     }
 
     const boost::shared_ptr<SequenceStatisticsInc> simulate(
@@ -179,6 +181,19 @@ namespace {
         return stats;
     }
 
+    const boost::shared_ptr<SequenceStatisticsInc> simulate(
+                   const boost::shared_ptr<MarketModelBatchEvolver>& evolver,
+                   const MarketModelMultiProduct& product) {
+        Size initialNumeraire = evolver->numeraires().front();
+        Real initialNumeraireValue = todaysDiscounts[initialNumeraire];
+
+        BatchAccountingEngine engine(evolver, product, initialNumeraireValue);
+        boost::shared_ptr<SequenceStatisticsInc> stats(
+                          new SequenceStatisticsInc(product.numberOfProducts()));
+        engine.multiplePathValues(*stats, paths_);
+        return stats;
+    }
+
 
     enum MarketModelType { ExponentialCorrelationFlatVolatility,
                            ExponentialCorrelationAbcdVolatility/*,
@@ -351,6 +366,23 @@ namespace {
         }
     }
 
+    boost::shared_ptr<MarketModelBatchEvolver> makeMarketModelBatchEvolver(
+                            const boost::shared_ptr<MarketModel>& marketModel,
+                            const std::vector<Size>& numeraires,
+                            const BrownianGeneratorFactory& generatorFactory,
+                            EvolverType evolverType,
+                            Size initialStep = 0) {
+        switch (evolverType) {
+          case Pc:
+            return boost::shared_ptr<MarketModelBatchEvolver>(new
+                BatchLogNormalCotSwapRatePc(marketModel, generatorFactory,
+                                            numeraires, batchSize_,
+                                            initialStep));
+          default:
+            QL_FAIL("unknown batched CoterminalSwapMarketModelEvolver type");
+        }
+    }
+
     void checkCoterminalSwapsAndSwaptions(const SequenceStatisticsInc& stats,
                                           const Rate fixedRate,
                                           const std::vector<boost::shared_ptr<StrikedTypePayoff> >& displacedPayoff,
@@ -511,6 +543,87 @@ void MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions() {
 }
 
 
+void MarketModelSmmTest::testBatchEvolution() {
+
+    BOOST_TEST_MESSAGE("Testing batched against single-path evolution "
+                       "in a lognormal coterminal swap rate market model...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+
+    std::vector<Time> swapPaymentTimes(rateTimes.begin()+1, rateTimes.end());
+    MultiStepCoterminalSwaps swaps(rateTimes, accruals, accruals,
+                                   swapPaymentTimes,
+                                   fixedRate);
+    std::vector<Time> swaptionPaymentTimes(rateTimes.begin(), rateTimes.end()-1);
+    std::vector<boost::shared_ptr<StrikedTypePayoff> >
+        payoffs(todaysForwards.size());
+    for (Size i=0; i<payoffs.size(); ++i)
+        payoffs[i] = boost::shared_ptr<StrikedTypePayoff>(new
+            PlainVanillaPayoff(Option::Call, fixedRate));
+    MultiStepCoterminalSwaptions swaptions(rateTimes,
+                                           swaptionPaymentTimes,
+                                           payoffs);
+    MultiProductComposite product;
+    product.add(swaps);
+    product.add(swaptions);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+
+    // not a multiple of the batch size, so that the last batch is partial
+    paths_ = std::min<Size>(paths_, 4095);
+    const Real tolerance = 1.0e-12;
+
+    MarketModelType marketModels[] = {
+        ExponentialCorrelationFlatVolatility,
+        ExponentialCorrelationAbcdVolatility };
+    for (Size j=0; j<LENGTH(marketModels); j++) {
+        Size testedFactors[] = { 4, todaysForwards.size() };
+        for (Size m=0; m<LENGTH(testedFactors); ++m) {
+            Size factors = testedFactors[m];
+            std::vector<Size> numeraires = makeMeasure(product, Terminal);
+            boost::shared_ptr<MarketModel> marketModel =
+                makeMarketModel(evolution, factors, marketModels[j]);
+
+            SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+            boost::shared_ptr<SequenceStatisticsInc> stats =
+                simulate(makeMarketModelEvolver(marketModel, numeraires,
+                                                generatorFactory, Pc),
+                         product);
+            boost::shared_ptr<SequenceStatisticsInc> batchStats =
+                simulate(makeMarketModelBatchEvolver(marketModel, numeraires,
+                                                     generatorFactory, Pc),
+                         product);
+
+            if (batchStats->samples() != stats->samples())
+                BOOST_ERROR("wrong number of samples"
+                            << "\n    single-path: " << stats->samples()
+                            << "\n    batched:     " << batchStats->samples());
+
+            std::vector<Real> expected = stats->mean();
+            std::vector<Real> calculated = batchStats->mean();
+            for (Size i=0; i<expected.size(); ++i) {
+                Real error = std::fabs(calculated[i]-expected[i]);
+                if (error > tolerance)
+                    BOOST_ERROR("failed to reproduce single-path results"
+                                << "\n    " << marketModelTypeToString(
+                                                         marketModels[j])
+                                << ", " << factors << " factors"
+                                << "\n    " << io::ordinal(i+1) << " product"
+                                << std::scientific
+                                << "\n    single-path: " << expected[i]
+                                << "\n    batched:     " << calculated[i]
+                                << "\n    error:       " << error
+                                << "\n    tolerance:   " << tolerance);
+            }
+        }
+    }
+}
+
+
 
 // --- Call the desired tests
 test_suite* MarketModelSmmTest::suite() {
@@ -518,6 +631,7 @@ test_suite* MarketModelSmmTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
               &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelSmmTest::testBatchEvolution));
 
     return suite;
 }
@@ -43,6 +43,7 @@ class MarketModelSmmTest {
     static void testDriftCalculator();
     static void testIsInSubset();*/
     static void testMultiStepCoterminalSwapsAndSwaptions();
+    static void testBatchEvolution();
     static boost::unit_test_framework::test_suite* suite();
 };
 
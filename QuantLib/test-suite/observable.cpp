@@ -0,0 +1,368 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "observable.hpp"
+#include "utilities.hpp"
+#include <ql/quotes/simplequote.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/settings.hpp>
+#include <boost/timer.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#endif
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+    class Counter : public Observer {
+      public:
+        Counter() : count_(0) {}
+        void update() { ++count_; }
+        Size count() const { return count_; }
+      private:
+        Size count_;
+    };
+
+    // sums its quotes and counts the updates it receives
+    class Sum : public LazyObject {
+      public:
+        explicit Sum(const std::vector<boost::shared_ptr<SimpleQuote> >& q)
+        : quotes_(q), updates_(0), calculations_(0) {
+            for (Size i=0; i<quotes_.size(); ++i)
+                registerWith(quotes_[i]);
+        }
+        void update() {
+            ++updates_;
+            LazyObject::update();
+        }
+        Real value() const {
+            calculate();
+            return value_;
+        }
+        Size updates() const { return updates_; }
+        Size calculations() const { return calculations_; }
+      private:
+        void performCalculations() const {
+            ++calculations_;
+            value_ = 0.0;
+            for (Size i=0; i<quotes_.size(); ++i)
+                value_ += quotes_[i]->value();
+        }
+        std::vector<boost::shared_ptr<SimpleQuote> > quotes_;
+        Size updates_;
+        mutable Size calculations_;
+        mutable Real value_;
+    };
+
+    // deletes its victims when notified
+    class Killer : public Observer {
+      public:
+        explicit Killer(std::vector<Counter*>& victims)
+        : victims_(victims) {}
+        void update() {
+            for (Size i=0; i<victims_.size(); ++i) {
+                delete victims_[i];
+                victims_[i] = 0;
+            }
+        }
+      private:
+        std::vector<Counter*>& victims_;
+    };
+
+}
+
+
+void ObservableTest::testRegistration() {
+
+    BOOST_TEST_MESSAGE("Testing observer registration...");
+
+    boost::shared_ptr<SimpleQuote> q1(new SimpleQuote(0.0));
+    boost::shared_ptr<SimpleQuote> q2(new SimpleQuote(0.0));
+
+    Counter c;
+    if (!c.registerWith(q1).second)
+        BOOST_FAIL("first registration was rejected");
+    if (c.registerWith(q1).second)
+        BOOST_FAIL("duplicate registration was accepted");
+    c.registerWith(q2);
+
+    q1->setValue(1.0);
+    q2->setValue(1.0);
+    if (c.count() != 2)
+        BOOST_FAIL("observer notified " << c.count()
+                   << " times\n    expected: 2");
+
+    // copies are registered with the same observables
+    Counter copy(c);
+    q1->setValue(2.0);
+    if (c.count() != 3 || copy.count() != 3)
+        BOOST_FAIL("copied observer not registered correctly");
+
+    if (c.unregisterWith(q1) != 1)
+        BOOST_FAIL("failed to unregister observer");
+    if (c.unregisterWith(q1) != 0)
+        BOOST_FAIL("observer unregistered twice");
+    q1->setValue(3.0);
+    if (c.count() != 3)
+        BOOST_FAIL("unregistered observer was notified");
+
+    c.unregisterWithAll();
+    q2->setValue(3.0);
+    if (c.count() != 3)
+        BOOST_FAIL("unregistered observer was notified");
+}
+
+
+void ObservableTest::testDestructionDuringNotification() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing destruction of observers during notification...");
+
+    boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.0));
+
+    std::vector<Counter*> victims(100);
+    for (Size i=0; i<victims.size(); ++i) {
+        victims[i] = new Counter;
+        victims[i]->registerWith(q);
+    }
+    Killer killer(victims);
+    killer.registerWith(q);
+
+    // whatever the notification order, victims deleted by the
+    // killer must not be notified afterwards
+    q->setValue(1.0);
+    for (Size i=0; i<victims.size(); ++i) {
+        if (victims[i] != 0)
+            BOOST_FAIL("observer not destroyed");
+    }
+
+    // the observable must be left in a consistent state
+    Counter survivor;
+    survivor.registerWith(q);
+    q->setValue(2.0);
+    if (survivor.count() != 1)
+        BOOST_FAIL("observer notified " << survivor.count()
+                   << " times\n    expected: 1");
+}
+
+
+void ObservableTest::testNotificationFanOut() {
+
+    BOOST_TEST_MESSAGE("Testing notification fan-out to many observers...");
+
+    const Size sizes[] = { 10000, 50000 };
+    const Size notifications = 100;
+
+    for (Size k=0; k<LENGTH(sizes); ++k) {
+        boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.0));
+        std::vector<boost::shared_ptr<Counter> > counters(sizes[k]);
+
+        boost::timer t;
+        for (Size i=0; i<counters.size(); ++i) {
+            counters[i] = boost::shared_ptr<Counter>(new Counter);
+            counters[i]->registerWith(q);
+        }
+        Real registration = t.elapsed();
+
+        t.restart();
+        for (Size n=0; n<notifications; ++n)
+            q->setValue(Real(n+1));
+        Real notification = t.elapsed()/notifications;
+
+        t.restart();
+        counters.erase(counters.begin() + counters.size()/2,
+                       counters.end());
+        Real destruction = t.elapsed();
+
+        BOOST_TEST_MESSAGE("    " << sizes[k] << " observers:"
+                           << "\n        registration:     "
+                           << registration*1e3 << " ms"
+                           << "\n        notification:     "
+                           << notification*1e6 << " us"
+                           << " (" << notification*1e9/sizes[k]
+                           << " ns per observer)"
+                           << "\n        half destroyed:   "
+                           << destruction*1e3 << " ms");
+
+        for (Size i=0; i<counters.size(); ++i) {
+            if (counters[i]->count() != notifications)
+                BOOST_FAIL("observer notified " << counters[i]->count()
+                           << " times\n    expected: " << notifications);
+        }
+
+        q->setValue(0.0);
+        for (Size i=0; i<counters.size(); ++i) {
+            if (counters[i]->count() != notifications+1)
+                BOOST_FAIL("observer notified " << counters[i]->count()
+                           << " times\n    expected: " << notifications+1);
+        }
+    }
+}
+
+
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+
+namespace {
+
+    // unlike SimpleQuote, it has no state to be corrupted by
+    // concurrent modifications
+    class Notifier : public Observable {
+      public:
+        void notify() { notifyObservers(); }
+    };
+
+    // registers, notifies and destroys observers while other
+    // threads do the same on the same observable
+    void churn(const boost::shared_ptr<Notifier>& q, Size iterations) {
+        for (Size n=0; n<iterations; ++n) {
+            std::vector<boost::shared_ptr<Counter> > counters(50);
+            for (Size i=0; i<counters.size(); ++i) {
+                counters[i] = boost::shared_ptr<Counter>(new Counter);
+                counters[i]->registerWith(q);
+            }
+            q->notify();
+            counters.resize(counters.size()/2);
+            q->notify();
+            for (Size i=0; i<counters.size(); ++i)
+                counters[i]->unregisterWith(q);
+        }
+    }
+
+}
+
+#endif
+
+void ObservableTest::testMultiThreadedNotification() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent registration and notification...");
+
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+
+    boost::shared_ptr<Notifier> q(new Notifier);
+    Counter watcher;
+    watcher.registerWith(q);
+
+    const Size nThreads = 4, iterations = 200;
+    boost::thread_group threads;
+    for (Size i=0; i<nThreads; ++i)
+        threads.create_thread(boost::bind(&churn, q, iterations));
+    threads.join_all();
+
+    // each iteration notifies twice
+    const Size expected = 2*nThreads*iterations;
+    if (watcher.count() != expected)
+        BOOST_FAIL("observer notified " << watcher.count()
+                   << " times\n    expected: " << expected);
+
+    #endif
+}
+
+
+void ObservableTest::testDeferredNotifications() {
+
+    BOOST_TEST_MESSAGE("Testing batched notifications...");
+
+    const Size n = 2000;
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes(n);
+    for (Size i=0; i<n; ++i)
+        quotes[i] = boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.0));
+
+    // quotes -> sum -> counter, plus a direct quote -> counter link
+    boost::shared_ptr<Sum> sum(new Sum(quotes));
+    Counter counter;
+    counter.registerWith(sum);
+    counter.registerWith(quotes[0]);
+    // a second, frozen sum doesn't forward notifications
+    boost::shared_ptr<Sum> frozen(new Sum(quotes));
+    Counter frozenCounter;
+    frozenCounter.registerWith(frozen);
+
+    sum->value();
+    frozen->value();
+    frozen->freeze();
+
+    {
+        NotificationBatch batch;
+        for (Size i=0; i<n; ++i)
+            quotes[i]->setValue(1.0);
+        {
+            // nested batches are merged into the outer one
+            NotificationBatch nested;
+            quotes[0]->setValue(2.0);
+        }
+        if (sum->updates() != 0 || counter.count() != 0)
+            BOOST_FAIL("notifications sent during batch");
+    }
+
+    if (sum->updates() != 1)
+        BOOST_FAIL("lazy object notified " << sum->updates()
+                   << " times\n    expected: 1");
+    if (counter.count() != 1)
+        BOOST_FAIL("observer notified " << counter.count()
+                   << " times\n    expected: 1");
+    if (frozen->updates() != 1 || frozenCounter.count() != 0)
+        BOOST_FAIL("frozen lazy object not handled correctly");
+
+    Real expected = n + 1.0;
+    if (sum->value() != expected)
+        BOOST_FAIL("wrong value after batch: " << sum->value()
+                   << "\n    expected: " << expected);
+    if (sum->calculations() != 2)
+        BOOST_FAIL("lazy object recalculated " << sum->calculations()
+                   << " times\n    expected: 2");
+    if (frozen->value() != 0.0)
+        BOOST_FAIL("frozen lazy object was recalculated");
+
+    // notifications are sent as usual after the batch
+    quotes[1]->setValue(3.0);
+    if (sum->updates() != 2 || counter.count() != 2)
+        BOOST_FAIL("notifications not resumed after batch");
+
+    // observers destroyed during the batch are not notified
+    {
+        NotificationBatch batch;
+        std::vector<boost::shared_ptr<Counter> > victims(10);
+        for (Size i=0; i<victims.size(); ++i) {
+            victims[i] = boost::shared_ptr<Counter>(new Counter);
+            victims[i]->registerWith(quotes[0]);
+        }
+        quotes[0]->setValue(4.0);
+    }
+    if (counter.count() != 3)
+        BOOST_FAIL("observer notified " << counter.count()
+                   << " times\n    expected: 3");
+}
+
+
+test_suite* ObservableTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Observer tests");
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testRegistration));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &ObservableTest::testDestructionDuringNotification));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testNotificationFanOut));
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    suite->add(QUANTLIB_TEST_CASE(
+                         &ObservableTest::testMultiThreadedNotification));
+    #endif
+    suite->add(QUANTLIB_TEST_CASE(
+                             &ObservableTest::testDeferredNotifications));
+    return suite;
+}
+
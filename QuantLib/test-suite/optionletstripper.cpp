@@ -501,6 +501,59 @@ void OptionletStripperTest::testTermVolatilityStripping2() {
   }
 }
 
+void OptionletStripperTest::testCapFloorPrices1() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing cap/floor prices used by OptionletStripper1 class...");
+
+    CommonVars vars;
+    Settings::instance().evaluationDate() = Date(28, October, 2013);
+
+    vars.setCapFloorTermVolSurface();
+
+    shared_ptr<IborIndex> iborIndex(new Euribor6M(vars.yieldTermStructure));
+
+    shared_ptr<OptionletStripper1> optionletStripper1(new
+        OptionletStripper1(vars.capFloorVolSurface,
+                           iborIndex,
+                           Null<Rate>(),
+                           vars.accuracy));
+
+    const Matrix& prices = optionletStripper1->capFloorPrices();
+    const Matrix& vols = optionletStripper1->capFloorVolatilities();
+    const std::vector<Period>& tenors =
+        optionletStripper1->optionletFixingTenors();
+    Rate switchStrike = optionletStripper1->switchStrike();
+
+    // the stripper prices the caps/floors without building them;
+    // check against the instruments priced with the Black engine
+    Real tolerance = 1.0e-12;
+    for (Size i=0; i<tenors.size(); ++i) {
+        Period length = tenors[i] + iborIndex->tenor();
+        for (Size j=0; j<vars.strikes.size(); ++j) {
+            CapFloor::Type type = vars.strikes[j] < switchStrike ?
+                                  CapFloor::Floor : CapFloor::Cap;
+            shared_ptr<PricingEngine> engine(new
+                BlackCapFloorEngine(vars.yieldTermStructure, vols[i][j],
+                                    vars.dayCounter));
+            shared_ptr<CapFloor> capFloor =
+                MakeCapFloor(type, length, iborIndex, vars.strikes[j],
+                             0*Days).withPricingEngine(engine);
+            Real expected = capFloor->NPV();
+
+            Real error = std::fabs(prices[i][j]-expected);
+            if (error>tolerance)
+                BOOST_ERROR("\nlength:     " << length <<
+                            "\nstrike:     " << io::rate(vars.strikes[j]) <<
+                            "\nvolatility: " << io::volatility(vols[i][j]) <<
+                            "\nprice:      " << prices[i][j] <<
+                            "\nexpected:   " << expected <<
+                            "\nerror:      " << error <<
+                            "\ntolerance:  " << tolerance);
+        }
+    }
+}
+
 test_suite* OptionletStripperTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("OptionletStripper Tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -511,5 +564,7 @@ test_suite* OptionletStripperTest::suite() {
                    &OptionletStripperTest::testFlatTermVolatilityStripping2));
     suite->add(QUANTLIB_TEST_CASE(
                        &OptionletStripperTest::testTermVolatilityStripping2));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &OptionletStripperTest::testCapFloorPrices1));
     return suite;
 }
@@ -32,6 +32,7 @@ class OptionletStripperTest {
     static void testTermVolatilityStripping1();
     static void testFlatTermVolatilityStripping2();
     static void testTermVolatilityStripping2();
+    static void testCapFloorPrices1();
     static boost::unit_test_framework::test_suite* suite();
 };
 
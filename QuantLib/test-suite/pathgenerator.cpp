@@ -20,7 +20,11 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
@@ -28,6 +32,8 @@
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <boost/timer.hpp>
+#include <numeric>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -290,11 +296,345 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+namespace {
+
+    class TerminalValue : public PathPricer<Path> {
+      public:
+        Real operator()(const Path& path) const { return path.back(); }
+    };
+
+    template <class RNG>
+    Real simulate(const boost::shared_ptr<StochasticProcess1D>& process,
+                  Size streams, Size samples) {
+        typedef MonteCarloModel<SingleVariate,RNG> model_type;
+        typedef typename model_type::path_generator_type generator_type;
+        typedef typename model_type::path_pricer_type pricer_type;
+        boost::shared_ptr<generator_type> generator(
+            new generator_type(process, 1.0, 10,
+                               RNG::make_sequence_generator(10, 42),
+                               false));
+        std::vector<boost::shared_ptr<pricer_type> > pricers(streams);
+        for (Size i=0; i<streams; ++i)
+            pricers[i] = boost::shared_ptr<pricer_type>(new TerminalValue);
+        model_type model(generator, pricers.front(), Statistics(), true);
+        model.useStreams(pricers);
+        // two batches, so that the generators are split twice
+        model.addSamples(samples/2);
+        model.addSamples(samples - samples/2);
+        return model.sampleAccumulator().mean();
+    }
+
+}
+
+
+void PathGeneratorTest::testSplitting() {
+
+    BOOST_TEST_MESSAGE("Testing path generation in separate streams...");
+
+    boost::shared_ptr<StochasticProcess1D> process(
+                             new GeometricBrownianMotionProcess(100.0, 0.03,
+                                                                0.20));
+
+    typedef LowDiscrepancy::rsg_type ld_rsg_type;
+    Size timeSteps = 12;
+    PathGenerator<ld_rsg_type> generator(
+              process, 1.0, timeSteps,
+              LowDiscrepancy::make_sequence_generator(timeSteps, 42), false);
+    PathGenerator<ld_rsg_type> reference(generator);
+
+    // splitting a low-discrepancy generator gives the same paths
+    Size blocks[] = { 5, 7, 1, 4 };
+    for (Size i=0; i<LENGTH(blocks); ++i) {
+        PathGenerator<ld_rsg_type> block = generator.split(blocks[i]);
+        for (Size j=0; j<blocks[i]; ++j) {
+            Real calculated = block.next().value.back();
+            Real expected = reference.next().value.back();
+            if (calculated != expected)
+                BOOST_FAIL("path " << j+1 << " of block " << i+1
+                           << " differs from unsplit generator:"
+                           << std::setprecision(13)
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+        }
+    }
+    Real calculated = generator.next().value.back();
+    Real expected = reference.next().value.back();
+    if (calculated != expected)
+        BOOST_FAIL("split generator not skipped correctly:"
+                   << std::setprecision(13)
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+
+    // pseudo-random streams are independent but reproducible
+    typedef PseudoRandom::rsg_type rsg_type;
+    PathGenerator<rsg_type> g1(
+                  process, 1.0, timeSteps,
+                  PseudoRandom::make_sequence_generator(timeSteps, 42), false);
+    PathGenerator<rsg_type> g2(g1);
+    PathGenerator<rsg_type> s11 = g1.split(10), s12 = g1.split(10);
+    PathGenerator<rsg_type> s21 = g2.split(10), s22 = g2.split(10);
+    for (Size j=0; j<10; ++j) {
+        Real x11 = s11.next().value.back(), x12 = s12.next().value.back();
+        Real x21 = s21.next().value.back(), x22 = s22.next().value.back();
+        if (x11 != x21 || x12 != x22)
+            BOOST_FAIL("split pseudo-random streams not reproducible");
+        if (x11 == x12)
+            BOOST_FAIL("split pseudo-random streams not independent");
+    }
+
+    // Monte Carlo results
+    Size samples = 1001;
+    Real serial = simulate<LowDiscrepancy>(process, 1, samples);
+    Real split = simulate<LowDiscrepancy>(process, 4, samples);
+    if (split != serial)
+        BOOST_FAIL("results from split low-discrepancy generator "
+                   "differ from unsplit one:"
+                   << std::setprecision(13)
+                   << "\n    split:   " << split
+                   << "\n    unsplit: " << serial);
+
+    Real first = simulate<PseudoRandom>(process, 4, samples);
+    Real second = simulate<PseudoRandom>(process, 4, samples);
+    if (first != second)
+        BOOST_FAIL("results from split pseudo-random generator "
+                   "not reproducible:"
+                   << std::setprecision(13)
+                   << "\n    first run:  " << first
+                   << "\n    second run: " << second);
+    Real tolerance = 1.0;
+    Real forward = 100.0*std::exp(0.03);
+    if (std::fabs(first-forward) > tolerance)
+        BOOST_FAIL("wrong expected value from split pseudo-random generator:"
+                   << std::setprecision(13)
+                   << "\n    calculated: " << first
+                   << "\n    expected:   " << forward);
+}
+
+
+namespace {
+
+    bool matches(Real x, Real y) {
+        return std::fabs(x-y) <= 1.0e-12*std::max(std::fabs(y), 1.0);
+    }
+
+    void checkBlock(PathGenerator<PseudoRandom::rsg_type>& generator,
+                    PathGenerator<PseudoRandom::rsg_type>& reference,
+                    const std::string& tag, Size paths) {
+        const PathBlock& block = generator.nextBlock(paths);
+        std::vector<Path> antithetic;
+        for (Size k=0; k<paths; ++k) {
+            const Path& path = reference.next().value;
+            for (Size i=0; i<path.length(); ++i) {
+                if (!matches(block(i,k), path[i]))
+                    BOOST_FAIL(tag << ": path " << k+1 << " of block "
+                               << "differs from single path at point "
+                               << i << ":" << std::setprecision(16)
+                               << "\n    block:  " << block(i,k)
+                               << "\n    single: " << path[i]);
+            }
+            antithetic.push_back(reference.antithetic().value);
+        }
+        const PathBlock& antitheticBlock = generator.antitheticBlock();
+        for (Size k=0; k<paths; ++k) {
+            for (Size i=0; i<antithetic[k].length(); ++i) {
+                if (!matches(antitheticBlock(i,k), antithetic[k][i]))
+                    BOOST_FAIL(tag << ": antithetic path " << k+1
+                               << " of block differs from single path "
+                               << "at point " << i << ":"
+                               << std::setprecision(16)
+                               << "\n    block:  " << antitheticBlock(i,k)
+                               << "\n    single: " << antithetic[k][i]);
+            }
+        }
+    }
+
+}
+
+
+void PathGeneratorTest::testBlockGeneration() {
+
+    BOOST_TEST_MESSAGE("Testing generation of blocks of paths...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    boost::shared_ptr<StochasticProcess1D> bsProcess(
+                                  new BlackScholesMertonProcess(x0,q,r,sigma));
+    boost::shared_ptr<StochasticProcess1D> ouProcess(
+                                    new OrnsteinUhlenbeckProcess(0.1, 0.20));
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    Time length = 1.0;
+    Size timeSteps = 12;
+    Size blocks[] = { 1, 10, 33 };
+
+    for (Size bb=0; bb<2; ++bb) {
+        bool brownianBridge = (bb == 1);
+        std::string which = brownianBridge ? " with Brownian bridge"
+                                           : " without Brownian bridge";
+        for (Size i=0; i<LENGTH(blocks); ++i) {
+            rsg_type rsg =
+                PseudoRandom::make_sequence_generator(timeSteps, 42);
+            PathGenerator<rsg_type> generator(bsProcess, length, timeSteps,
+                                              rsg, brownianBridge);
+            PathGenerator<rsg_type> reference(generator);
+            checkBlock(generator, reference,
+                       "Black-Scholes" + which, blocks[i]);
+            // the generators must stay in sync
+            checkBlock(generator, reference,
+                       "Black-Scholes" + which, blocks[i]);
+
+            PathGenerator<rsg_type> ouGenerator(ouProcess, length, timeSteps,
+                                                rsg, brownianBridge);
+            PathGenerator<rsg_type> ouReference(ouGenerator);
+            checkBlock(ouGenerator, ouReference,
+                       "Ornstein-Uhlenbeck" + which, blocks[i]);
+        }
+    }
+
+    // multi-dimensional paths
+    HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponentialMartingale,
+        HestonProcess::NonCentralChiSquareVariance
+    };
+    for (Size s=0; s<LENGTH(schemes); ++s) {
+        boost::shared_ptr<StochasticProcess> hestonProcess(
+                         new HestonProcess(r, q, x0, 0.04, 1.5, 0.04, 0.3,
+                                           -0.7, schemes[s]));
+        Size paths = 25;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(2*timeSteps, 42);
+        MultiPathGenerator<rsg_type> generator(hestonProcess,
+                                               TimeGrid(length, timeSteps),
+                                               rsg, false);
+        MultiPathGenerator<rsg_type> reference(generator);
+        for (Size b=0; b<2; ++b) {
+            const MultiPathBlock& block = generator.nextBlock(paths);
+            std::vector<MultiPath> antithetic;
+            for (Size k=0; k<paths; ++k) {
+                const MultiPath& path = reference.next().value;
+                for (Size j=0; j<path.assetNumber(); ++j) {
+                    for (Size i=0; i<path.pathSize(); ++i) {
+                        if (!matches(block[j](i,k), path[j][i]))
+                            BOOST_FAIL("Heston scheme " << s+1 << ": path "
+                                       << k+1 << " of block differs from "
+                                       << "single path at point " << i
+                                       << " of asset " << j+1 << ":"
+                                       << std::setprecision(16)
+                                       << "\n    block:  " << block[j](i,k)
+                                       << "\n    single: " << path[j][i]);
+                    }
+                }
+                antithetic.push_back(reference.antithetic().value);
+            }
+            const MultiPathBlock& antitheticBlock =
+                generator.antitheticBlock();
+            for (Size k=0; k<paths; ++k) {
+                for (Size j=0; j<antithetic[k].assetNumber(); ++j) {
+                    Size i = antithetic[k].pathSize()-1;
+                    if (!matches(antitheticBlock[j](i,k),
+                               antithetic[k][j][i]))
+                        BOOST_FAIL("Heston scheme " << s+1
+                                   << ": antithetic path " << k+1
+                                   << " of block differs from single path"
+                                   << std::setprecision(16)
+                                   << "\n    block:  "
+                                   << antitheticBlock[j](i,k)
+                                   << "\n    single: "
+                                   << antithetic[k][j][i]);
+                }
+            }
+        }
+    }
+
+    // Monte Carlo model pricing blocks of multi-paths
+    boost::shared_ptr<StochasticProcess> hestonProcess(
+                      new HestonProcess(r, q, x0, 0.04, 1.5, 0.04, 0.3, -0.7));
+    boost::shared_ptr<EuropeanHestonPathPricer> hestonPricer(
+             new EuropeanHestonPathPricer(Option::Put, 100.0,
+                                          r->discount(length)));
+    for (Size b=0; b<LENGTH(blocks); ++b) {
+        typedef MonteCarloModel<MultiVariate,PseudoRandom> model_type;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(2*timeSteps, 42);
+        boost::shared_ptr<model_type::path_generator_type> generator(
+             new model_type::path_generator_type(hestonProcess,
+                                                 TimeGrid(length, timeSteps),
+                                                 rsg, false));
+        boost::shared_ptr<model_type::path_generator_type> reference(
+                             new model_type::path_generator_type(*generator));
+        model_type blockModel(generator, hestonPricer, Statistics(), true);
+        blockModel.useBlocks(hestonPricer, blocks[b]);
+        model_type singleModel(reference, hestonPricer, Statistics(), true);
+        // uneven numbers of samples leave partial blocks
+        blockModel.addSamples(70);
+        singleModel.addSamples(70);
+        blockModel.addSamples(45);
+        singleModel.addSamples(45);
+        Real blocked = blockModel.sampleAccumulator().mean();
+        Real single = singleModel.sampleAccumulator().mean();
+        if (!matches(blocked, single))
+            BOOST_FAIL("Monte Carlo model using blocks of " << blocks[b]
+                       << " paths differs from single-path model:"
+                       << std::setprecision(16)
+                       << "\n    block:  " << blocked
+                       << "\n    single: " << single);
+    }
+
+    // pricing, and timing against the per-path loop
+    Size paths = 20000, blockSize = 1000;
+    timeSteps = 100;
+    EuropeanPathPricer pricer(Option::Call, 100.0,
+                              r->discount(length));
+    rsg_type rsg = PseudoRandom::make_sequence_generator(timeSteps, 42);
+    PathGenerator<rsg_type> generator(bsProcess, length, timeSteps,
+                                      rsg, false);
+    PathGenerator<rsg_type> reference(generator);
+
+    boost::timer t;
+    Real single = 0.0;
+    for (Size k=0; k<paths; ++k)
+        single += pricer(reference.next().value);
+    Real singleTime = t.elapsed();
+
+    t.restart();
+    Real blocked = 0.0;
+    Array values;
+    for (Size k=0; k<paths; k+=blockSize) {
+        pricer(generator.nextBlock(blockSize), values);
+        blocked = std::accumulate(values.begin(), values.end(), blocked);
+    }
+    Real blockTime = t.elapsed();
+
+    BOOST_TEST_MESSAGE("    " << paths << " paths, " << timeSteps
+                       << " steps:"
+                       << "\n        single paths:     "
+                       << singleTime*1e3 << " ms"
+                       << "\n        blocks of " << blockSize << ":   "
+                       << blockTime*1e3 << " ms");
+
+    if (!matches(blocked/paths, single/paths))
+        BOOST_FAIL("block pricing differs from single-path pricing:"
+                   << std::setprecision(16)
+                   << "\n    block:  " << blocked/paths
+                   << "\n    single: " << single/paths);
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testSplitting));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBlockGeneration));
     return suite;
 }
 
@@ -42,10 +42,12 @@
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/interpolations/convexmonotoneinterpolation.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <boost/timer.hpp>
 #include <iomanip>
 
 using namespace QuantLib;
@@ -638,6 +640,221 @@ void PiecewiseYieldCurveTest::testLocalBootstrapConsistency() {
 }
 
 
+void PiecewiseYieldCurveTest::testGlobalBootstrapConsistency() {
+    BOOST_TEST_MESSAGE(
+        "Testing consistency of global-bootstrap algorithm...");
+
+    CommonVars vars;
+    testCurveConsistency<Discount,LogLinear,GlobalBootstrap>(vars);
+    testBMACurveConsistency<Discount,LogLinear,GlobalBootstrap>(vars);
+    testCurveConsistency<ForwardRate,BackwardFlat,GlobalBootstrap>(vars);
+    testBMACurveConsistency<ForwardRate,BackwardFlat,GlobalBootstrap>(vars);
+    testCurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0));
+    testBMACurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0));
+}
+
+
+void PiecewiseYieldCurveTest::testGlobalBootstrapJacobian() {
+    BOOST_TEST_MESSAGE(
+        "Testing Jacobian of global-bootstrap algorithm...");
+
+    CommonVars vars;
+
+    Cubic cubic(CubicInterpolation::Spline, true,
+                CubicInterpolation::SecondDerivative, 0.0,
+                CubicInterpolation::SecondDerivative, 0.0);
+
+    boost::timer timer;
+    PiecewiseYieldCurve<ZeroYield,Cubic> iterative(vars.settlement,
+                                                   vars.instruments,
+                                                   Actual360(), cubic);
+    iterative.data();
+    Real iterativeTime = timer.elapsed();
+
+    timer.restart();
+    PiecewiseYieldCurve<ZeroYield,Cubic,GlobalBootstrap> curve(
+                                                   vars.settlement,
+                                                   vars.instruments,
+                                                   Actual360(), cubic);
+    std::vector<Real> data = curve.data();
+    Real globalTime = timer.elapsed();
+
+    BOOST_TEST_MESSAGE("    iterative bootstrap: " << iterativeTime*1e3
+                       << " ms\n    global bootstrap:    " << globalTime*1e3
+                       << " ms");
+
+    Real tolerance = 1.0e-10;
+    for (Size i=1; i<data.size(); ++i) {
+        if (std::fabs(data[i] - iterative.data()[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce iterative bootstrap at "
+                        << curve.dates()[i] << ":"
+                        << std::setprecision(12)
+                        << "\n    global:    " << data[i]
+                        << "\n    iterative: " << iterative.data()[i]);
+    }
+
+    // the inverse of the Jacobian must give the change of the curve
+    // data when a quote is moved; the curve is rebootstrapped
+    // starting from the previous solution.
+    Matrix jacobian = curve.bootstrap().jacobian();
+    Real bump = 1.0e-6;
+    for (Size i=0; i<vars.rates.size(); ++i) {
+        // rows follow the sorted pillars
+        const std::vector<Date>& dates = curve.dates();
+        Size k = std::find(dates.begin(), dates.end(),
+                           vars.instruments[i]->latestDate())
+                 - dates.begin() - 1;
+        Array dq(jacobian.rows(), 0.0);
+        dq[k] = bump;
+        Array expected = qrSolve(jacobian, dq);
+
+        vars.rates[i]->setValue(vars.rates[i]->value() + bump);
+        const std::vector<Real>& bumped = curve.data();
+        for (Size j=1; j<bumped.size(); ++j) {
+            Real calculated = bumped[j] - data[j];
+            if (std::fabs(calculated - expected[j-1]) > tolerance)
+                BOOST_ERROR("failed to reproduce sensitivity of "
+                            << io::ordinal(j) << " pillar to "
+                            << io::ordinal(i+1) << " quote:"
+                            << std::scientific
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected[j-1]);
+        }
+        vars.rates[i]->setValue(vars.rates[i]->value() - bump);
+    }
+}
+
+
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+    BOOST_TEST_MESSAGE(
+        "Testing incremental bootstrap after a change of quote...");
+
+    CommonVars vars;
+
+    PiecewiseYieldCurve<Discount,LogLinear> curve(vars.settlementDays,
+                                                  vars.calendar,
+                                                  vars.instruments,
+                                                  Actual360());
+    curve.data();
+
+    Real bump = 1.0e-4, tolerance = 1.0e-10;
+    for (Size i=0; i<vars.rates.size(); ++i) {
+        std::vector<Real> before = curve.data();
+        const std::vector<Date>& dates = curve.dates();
+        Size k = std::find(dates.begin(), dates.end(),
+                           vars.instruments[i]->latestDate())
+                 - dates.begin();
+
+        vars.rates[i]->setValue(vars.rates[i]->value() + bump);
+        std::vector<Real> after = curve.data();
+
+        // the previous pillars must be left alone...
+        for (Size j=0; j<k; ++j) {
+            if (after[j] != before[j])
+                BOOST_ERROR(io::ordinal(j) << " pillar modified by change "
+                            "in " << io::ordinal(i+1) << " quote");
+        }
+
+        // ...and the result must be the same as a full bootstrap
+        PiecewiseYieldCurve<Discount,LogLinear> expected(vars.settlementDays,
+                                                         vars.calendar,
+                                                         vars.instruments,
+                                                         Actual360());
+        for (Size j=0; j<after.size(); ++j) {
+            if (std::fabs(after[j] - expected.data()[j]) > tolerance)
+                BOOST_ERROR("failed to reproduce full bootstrap at "
+                            << io::ordinal(j) << " pillar after change "
+                            "in " << io::ordinal(i+1) << " quote:"
+                            << std::setprecision(12)
+                            << "\n    incremental: " << after[j]
+                            << "\n    full:        " << expected.data()[j]);
+        }
+
+        vars.rates[i]->setValue(vars.rates[i]->value() - bump);
+    }
+
+    // a change in jumps requires a full bootstrap, even if a quote
+    // changed as well
+    boost::shared_ptr<SimpleQuote> jump(new SimpleQuote(0.999));
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+    std::vector<Date> jumpDates(1, vars.calendar.advance(vars.today,
+                                                         18, Months));
+    PiecewiseYieldCurve<Discount,LogLinear> jumpCurve(vars.settlementDays,
+                                                      vars.calendar,
+                                                      vars.instruments,
+                                                      Actual360(), jumps,
+                                                      jumpDates);
+    jumpCurve.data();
+    jump->setValue(0.998);
+    vars.rates.back()->setValue(vars.rates.back()->value() + bump);
+    std::vector<Real> afterJump = jumpCurve.data();
+    PiecewiseYieldCurve<Discount,LogLinear> expectedJump(vars.settlementDays,
+                                                         vars.calendar,
+                                                         vars.instruments,
+                                                         Actual360(), jumps,
+                                                         jumpDates);
+    for (Size j=0; j<afterJump.size(); ++j) {
+        if (std::fabs(afterJump[j] - expectedJump.data()[j]) > tolerance)
+            BOOST_ERROR("failed to reproduce full bootstrap at "
+                        << io::ordinal(j) << " pillar after change "
+                        "in jump and quote:"
+                        << std::setprecision(12)
+                        << "\n    incremental: " << afterJump[j]
+                        << "\n    full:        " << expectedJump.data()[j]);
+    }
+    vars.rates.back()->setValue(vars.rates.back()->value() - bump);
+
+    // a change of evaluation date requires a full bootstrap
+    Settings::instance().evaluationDate() =
+        vars.calendar.advance(vars.today, 1, Days);
+    PiecewiseYieldCurve<Discount,LogLinear> expected(vars.settlementDays,
+                                                     vars.calendar,
+                                                     vars.instruments,
+                                                     Actual360());
+    for (Size j=0; j<curve.data().size(); ++j) {
+        if (std::fabs(curve.data()[j] - expected.data()[j]) > tolerance)
+            BOOST_ERROR("failed to reproduce full bootstrap at "
+                        << io::ordinal(j) << " pillar after change "
+                        "of evaluation date:"
+                        << std::setprecision(12)
+                        << "\n    incremental: " << curve.data()[j]
+                        << "\n    full:        " << expected.data()[j]);
+    }
+
+    Size n = 50;
+    boost::shared_ptr<SimpleQuote> last = vars.rates.back();
+    boost::timer timer;
+    for (Size i=0; i<n; ++i) {
+        last->setValue(last->value() + (i%2 == 0 ? bump : -bump));
+        PiecewiseYieldCurve<Discount,LogLinear> fresh(vars.settlementDays,
+                                                      vars.calendar,
+                                                      vars.instruments,
+                                                      Actual360());
+        fresh.data();
+    }
+    Real full = timer.elapsed()/n;
+    timer.restart();
+    for (Size i=0; i<n; ++i) {
+        last->setValue(last->value() + (i%2 == 0 ? bump : -bump));
+        curve.data();
+    }
+    Real incremental = timer.elapsed()/n;
+    BOOST_TEST_MESSAGE("    change in last quote:"
+                       << "\n        full bootstrap:        "
+                       << full*1e6 << " us"
+                       << "\n        incremental bootstrap: "
+                       << incremental*1e6 << " us");
+}
+
+
 void PiecewiseYieldCurveTest::testObservability() {
 
     BOOST_TEST_MESSAGE("Testing observability of piecewise yield curve...");
@@ -945,6 +1162,12 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testConvexMonotoneForwardConsistency));
     suite->add(QUANTLIB_TEST_CASE(
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testGlobalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testGlobalBootstrapJacobian));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testIncrementalBootstrap));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
@@ -41,6 +41,9 @@ class PiecewiseYieldCurveTest {
 
     static void testConvexMonotoneForwardConsistency();
     static void testLocalBootstrapConsistency();
+    static void testGlobalBootstrapConsistency();
+    static void testGlobalBootstrapJacobian();
+    static void testIncrementalBootstrap();
 
     static void testObservability();
     static void testLiborFixing();
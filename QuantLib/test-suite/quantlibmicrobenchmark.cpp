@@ -0,0 +1,846 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*
+ QuantLib Micro-Benchmark Suite
+
+ Times a set of hot paths of the library in isolation, as opposed to
+ quantlib-benchmark which times whole test cases and reports a single
+ index.  Each benchmark performs a fixed amount of work per iteration;
+ the number of iterations is increased until a run takes at least the
+ given minimum time, and the run is then repeated a number of times.
+ Per-iteration times are reported as mean, median, standard deviation,
+ minimum and maximum over the repetitions.
+
+ Usage: quantlib-microbenchmark [options]
+
+   --filter=<text>       only run benchmarks whose name contains <text>
+   --min-time=<seconds>  minimum duration of each repetition (0.1)
+   --repetitions=<n>     number of repetitions (5)
+   --json=<file>         write results in JSON format to <file>;
+                         use "-" to write them to standard output
+                         instead of the table
+   --list                list the available benchmarks and exit
+
+ Times are wall-clock times.  Process CPU times would add up the time
+ spent by each thread, which would hide the effect of parallel code.
+*/
+
+#include <ql/version.hpp>
+#include <ql/settings.hpp>
+#include <ql/errors.hpp>
+#include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/exercise.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/sabrinterpolation.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/statistics/generalstatistics.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/models/equity/hestonmodelhelper.hpp>
+#include <ql/patterns/observable.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/time/schedule.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_MSVC
+#  include <ql/auto_link.hpp>
+#endif
+
+using namespace QuantLib;
+
+#if defined(QL_ENABLE_SESSIONS)
+namespace QuantLib {
+    Integer sessionId() { return 0; }
+}
+#endif
+
+namespace {
+
+    // results are accumulated here so that the compiler can't
+    // optimize away the benchmarked code
+    volatile Real sink = 0.0;
+
+    class MicroBenchmark {
+      public:
+        explicit MicroBenchmark(const std::string& name) : name_(name) {}
+        virtual ~MicroBenchmark() {}
+        const std::string& name() const { return name_; }
+        //! called once before timing
+        virtual void setUp() {}
+        //! performs one iteration
+        virtual void run() = 0;
+        //! called once after timing
+        virtual void tearDown() {}
+      private:
+        std::string name_;
+    };
+
+    struct BenchmarkResult {
+        std::string name;
+        Size iterations, repetitions;
+        Real mean, median, stdDev, min, max;
+    };
+
+
+    // curve bootstrap
+
+    class BootstrapBenchmark : public MicroBenchmark {
+      public:
+        explicit BootstrapBenchmark(Size pillars)
+        : MicroBenchmark("Bootstrap/PiecewiseYieldCurve/"
+                         + boost::lexical_cast<std::string>(pillars)),
+          pillars_(pillars) {}
+        void setUp() {
+            Calendar calendar = TARGET();
+            boost::shared_ptr<IborIndex> euribor(new Euribor6M);
+            Size deposits = std::min<Size>(pillars_, 4);
+            Integer depositTenors[] = { 1, 3, 6, 9 };
+            for (Size i=0; i<pillars_; ++i) {
+                boost::shared_ptr<SimpleQuote> q(
+                                      new SimpleQuote(0.02 + 0.0005*i));
+                Handle<Quote> h(q);
+                if (i < deposits)
+                    helpers_.push_back(boost::shared_ptr<RateHelper>(
+                        new DepositRateHelper(h, depositTenors[i]*Months, 2,
+                                              calendar, ModifiedFollowing,
+                                              true, Actual360())));
+                else
+                    helpers_.push_back(boost::shared_ptr<RateHelper>(
+                        new SwapRateHelper(h, (i-deposits+1)*Years,
+                                           calendar, Annual, Unadjusted,
+                                           Thirty360(), euribor)));
+            }
+        }
+        void run() {
+            PiecewiseYieldCurve<Discount,LogLinear> curve(
+                           Settings::instance().evaluationDate(), helpers_,
+                           Actual365Fixed());
+            sink = sink + curve.discount(1.0);
+        }
+        void tearDown() { helpers_.clear(); }
+      private:
+        Size pillars_;
+        std::vector<boost::shared_ptr<RateHelper> > helpers_;
+    };
+
+
+    // interpolation, dates and calendars
+
+    class InterpolationBenchmark : public MicroBenchmark {
+      public:
+        explicit InterpolationBenchmark(Size points)
+        : MicroBenchmark("Interpolation/locate/"
+                         + boost::lexical_cast<std::string>(points)),
+          x_(points), y_(points), xs_(1000) {}
+        void setUp() {
+            for (Size i=0; i<x_.size(); ++i) {
+                x_[i] = 0.25*i;
+                y_[i] = std::exp(-0.01*x_[i]);
+            }
+            // scattered evaluation points, as in the typical use
+            for (Size i=0; i<xs_.size(); ++i)
+                xs_[i] = x_.back() * ((i*7919) % xs_.size()) / xs_.size();
+            f_ = LinearInterpolation(x_.begin(), x_.end(), y_.begin());
+        }
+        void run() {
+            Real s = 0.0;
+            for (Size i=0; i<xs_.size(); ++i)
+                s += f_(xs_[i]);
+            sink = sink + s;
+        }
+      private:
+        std::vector<Real> x_, y_, xs_;
+        Interpolation f_;
+    };
+
+    class DateArithmeticBenchmark : public MicroBenchmark {
+      public:
+        DateArithmeticBenchmark()
+        : MicroBenchmark("Date/arithmetic") {}
+        void run() {
+            Date d(15, January, 2015);
+            BigInteger s = 0;
+            for (Integer i=0; i<1000; ++i) {
+                Date d1 = d + i*Days;
+                Date d2 = d1 + Period(i%120 + 1, Months);
+                s += (d2 - d1) + d2.year() + d2.month() + d1.weekday();
+            }
+            sink = sink + Real(s);
+        }
+    };
+
+    class CalendarAdvanceBenchmark : public MicroBenchmark {
+      public:
+        CalendarAdvanceBenchmark(const std::string& name,
+                                 const Calendar& calendar)
+        : MicroBenchmark("Calendar/advance/" + name),
+          calendar_(calendar) {}
+        void run() {
+            Date d(15, January, 2015);
+            BigInteger s = 0;
+            for (Integer i=0; i<1000; ++i) {
+                Date d1 = calendar_.advance(d + i*Days, i%30 + 1, Days);
+                Date d2 = calendar_.advance(d1, 6, Months, ModifiedFollowing);
+                s += d2 - d1;
+            }
+            sink = sink + Real(s);
+        }
+      private:
+        Calendar calendar_;
+    };
+
+
+    // cash flows
+
+    class CashFlowsNpvBenchmark : public MicroBenchmark {
+      public:
+        explicit CashFlowsNpvBenchmark(bool floating)
+        : MicroBenchmark(floating ? "CashFlows/npv/IborLeg"
+                                  : "CashFlows/npv/FixedRateLeg"),
+          floating_(floating) {}
+        void setUp() {
+            Date today = Settings::instance().evaluationDate();
+            curve_ = boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(today, 0.03, Actual365Fixed()));
+            Handle<YieldTermStructure> h(curve_);
+            Schedule schedule(TARGET().advance(today, 2, Days),
+                              today + 30*Years, 6*Months, TARGET(),
+                              ModifiedFollowing, ModifiedFollowing,
+                              DateGeneration::Forward, false);
+            if (floating_)
+                leg_ = IborLeg(schedule,
+                               boost::shared_ptr<IborIndex>(new Euribor6M(h)))
+                    .withNotionals(100.0)
+                    .withPaymentDayCounter(Actual360());
+            else
+                leg_ = FixedRateLeg(schedule)
+                    .withNotionals(100.0)
+                    .withCouponRates(0.03, Thirty360());
+        }
+        void run() {
+            sink = sink + CashFlows::npv(leg_, *curve_, false);
+        }
+        void tearDown() { leg_.clear(); }
+      private:
+        bool floating_;
+        boost::shared_ptr<YieldTermStructure> curve_;
+        Leg leg_;
+    };
+
+
+    // Black formula
+
+    class BlackFormulaBenchmark : public MicroBenchmark {
+      public:
+        BlackFormulaBenchmark(bool implied, bool batch)
+        : MicroBenchmark(std::string("BlackFormula/")
+                         + (implied ? "impliedStdDev/" : "price/")
+                         + (batch ? "batch" : "scalar")),
+          implied_(implied), batch_(batch) {}
+        void setUp() {
+            // 1000 calls on a strip of strikes and maturities
+            Size n = 1000;
+            strikes_ = forwards_ = stdDevs_ = Array(n);
+            discounts_ = prices_ = results_ = Array(n);
+            for (Size i=0; i<n; ++i) {
+                strikes_[i] = 70.0 + 0.06*i;
+                forwards_[i] = 100.0;
+                stdDevs_[i] = 0.2*std::sqrt(0.25 + 0.02*(i%100));
+                discounts_[i] = 0.95;
+            }
+            blackFormula(Option::Call, strikes_, forwards_, stdDevs_,
+                         discounts_, prices_);
+        }
+        void run() {
+            Size n = strikes_.size();
+            if (implied_ && batch_) {
+                blackFormulaImpliedStdDev(Option::Call, strikes_, forwards_,
+                                          prices_, discounts_, results_);
+            } else if (implied_) {
+                for (Size i=0; i<n; ++i)
+                    results_[i] = blackFormulaImpliedStdDev(
+                        Option::Call, strikes_[i], forwards_[i],
+                        prices_[i], discounts_[i], 0.0, Null<Real>(),
+                        1.0e-12);
+            } else if (batch_) {
+                blackFormula(Option::Call, strikes_, forwards_, stdDevs_,
+                             discounts_, results_);
+            } else {
+                for (Size i=0; i<n; ++i)
+                    results_[i] = blackFormula(Option::Call, strikes_[i],
+                                               forwards_[i], stdDevs_[i],
+                                               discounts_[i]);
+            }
+            sink = sink + results_[n/2];
+        }
+      private:
+        bool implied_, batch_;
+        Array strikes_, forwards_, stdDevs_, discounts_, prices_, results_;
+    };
+
+
+    // finite differences
+
+    class TripleBandBenchmark : public MicroBenchmark {
+      public:
+        TripleBandBenchmark(Size direction, bool solve)
+        : MicroBenchmark(std::string("Fdm/TripleBandLinearOp/")
+                         + (solve ? "solve_splitting/" : "apply/")
+                         + boost::lexical_cast<std::string>(direction)),
+          direction_(direction), solve_(solve) {}
+        void setUp() {
+            // 200x100x50 grid, as for a Heston-Hull-White problem
+            boost::shared_ptr<FdmMesher> mesher(new FdmMesherComposite(
+                boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0,1,200)),
+                boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0,1,100)),
+                boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0,1,50))));
+            op_ = boost::shared_ptr<TripleBandLinearOp>(
+                             new SecondDerivativeOp(direction_, mesher));
+            x_ = Array(mesher->layout()->size());
+            for (Size i=0; i<x_.size(); ++i)
+                x_[i] = std::sin(0.001*i);
+        }
+        void run() {
+            Array y = solve_ ? op_->solve_splitting(x_, -0.5e-5)
+                             : op_->apply(x_);
+            sink = sink + y[y.size()/2];
+        }
+        void tearDown() { op_.reset(); x_ = Array(); }
+      private:
+        Size direction_;
+        bool solve_;
+        boost::shared_ptr<TripleBandLinearOp> op_;
+        Array x_;
+    };
+
+    class NinePointBenchmark : public MicroBenchmark {
+      public:
+        NinePointBenchmark()
+        : MicroBenchmark("Fdm/NinePointLinearOp/apply") {}
+        void setUp() {
+            boost::shared_ptr<FdmMesher> mesher(new FdmMesherComposite(
+                boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0,1,200)),
+                boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0,1,100)),
+                boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0,1,50))));
+            op_ = boost::shared_ptr<NinePointLinearOp>(
+                       new SecondOrderMixedDerivativeOp(0, 1, mesher));
+            x_ = Array(mesher->layout()->size());
+            for (Size i=0; i<x_.size(); ++i)
+                x_[i] = std::sin(0.001*i);
+        }
+        void run() {
+            Array y = op_->apply(x_);
+            sink = sink + y[y.size()/2];
+        }
+        void tearDown() { op_.reset(); x_ = Array(); }
+      private:
+        boost::shared_ptr<NinePointLinearOp> op_;
+        Array x_;
+    };
+
+    boost::shared_ptr<HestonModel> makeHestonModel(Real v0, Real kappa,
+                                                   Real theta, Real sigma,
+                                                   Real rho) {
+        Date today = Settings::instance().evaluationDate();
+        Handle<YieldTermStructure> rTS(boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(today, 0.03, Actual365Fixed())));
+        Handle<YieldTermStructure> qTS(boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(today, 0.01, Actual365Fixed())));
+        Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+        return boost::shared_ptr<HestonModel>(new HestonModel(
+            boost::shared_ptr<HestonProcess>(new HestonProcess(
+                          rTS, qTS, s0, v0, kappa, theta, sigma, rho))));
+    }
+
+    class FdHestonBenchmark : public MicroBenchmark {
+      public:
+        FdHestonBenchmark()
+        : MicroBenchmark("Fdm/FdHestonVanillaEngine/50x100x50") {}
+        void setUp() {
+            Date today = Settings::instance().evaluationDate();
+            option_ = boost::shared_ptr<VanillaOption>(new VanillaOption(
+                boost::shared_ptr<StrikedTypePayoff>(
+                                 new PlainVanillaPayoff(Option::Put, 100.0)),
+                boost::shared_ptr<Exercise>(
+                                 new EuropeanExercise(today + 1*Years))));
+            option_->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new FdHestonVanillaEngine(
+                    makeHestonModel(0.04, 1.5, 0.04, 0.3, -0.6),
+                    50, 100, 50)));
+        }
+        void run() {
+            option_->recalculate();
+            sink = sink + option_->NPV();
+        }
+        void tearDown() { option_.reset(); }
+      private:
+        boost::shared_ptr<VanillaOption> option_;
+    };
+
+
+    // Monte Carlo
+
+    template <class RNG>
+    class PathGeneratorBenchmark : public MicroBenchmark {
+      public:
+        PathGeneratorBenchmark(const std::string& rngName, bool blocks)
+        : MicroBenchmark("MonteCarlo/PathGenerator/" + rngName
+                         + (blocks ? "/block" : "/single")),
+          blocks_(blocks) {}
+        void setUp() {
+            Date today = Settings::instance().evaluationDate();
+            boost::shared_ptr<StochasticProcess1D> process(
+                new BlackScholesMertonProcess(
+                    Handle<Quote>(boost::shared_ptr<Quote>(
+                                                  new SimpleQuote(100.0))),
+                    Handle<YieldTermStructure>(
+                        boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(today, 0.01, Actual365Fixed()))),
+                    Handle<YieldTermStructure>(
+                        boost::shared_ptr<YieldTermStructure>(
+                         new FlatForward(today, 0.03, Actual365Fixed()))),
+                    Handle<BlackVolTermStructure>(
+                        boost::shared_ptr<BlackVolTermStructure>(
+                           new BlackConstantVol(today, TARGET(), 0.2,
+                                                Actual365Fixed())))));
+            TimeGrid grid(1.0, 100);
+            generator_ = boost::shared_ptr<PathGenerator<rsg_type> >(
+                new PathGenerator<rsg_type>(
+                    process, grid,
+                    RNG::make_sequence_generator(grid.size()-1, 42),
+                    true));
+        }
+        void run() {
+            // 1000 paths of 100 steps per iteration
+            if (blocks_) {
+                const PathBlock& block = generator_->nextBlock(1000);
+                sink = sink + block(block.length()-1, 0);
+            } else {
+                Real s = 0.0;
+                for (Size i=0; i<1000; ++i)
+                    s += generator_->next().value.back();
+                sink = sink + s;
+            }
+        }
+        void tearDown() { generator_.reset(); }
+      private:
+        typedef typename RNG::rsg_type rsg_type;
+        bool blocks_;
+        boost::shared_ptr<PathGenerator<rsg_type> > generator_;
+    };
+
+
+    // calibration
+
+    class SabrCalibrationBenchmark : public MicroBenchmark {
+      public:
+        SabrCalibrationBenchmark()
+        : MicroBenchmark("Calibration/SABR") {}
+        void setUp() {
+            for (Size i=0; i<31; ++i) {
+                strikes_.push_back(0.03 + 0.002*i);
+                vols_.push_back(sabrVolatility(strikes_.back(), forward_,
+                                               1.0, 0.3, 0.6, 0.02, 0.01));
+            }
+        }
+        void run() {
+            SABRInterpolation sabr(
+                strikes_.begin(), strikes_.end(), vols_.begin(),
+                1.0, forward_, std::sqrt(0.2), 0.5, std::sqrt(0.4), 0.0,
+                false, false, false, false, true,
+                boost::shared_ptr<EndCriteria>(
+                          new EndCriteria(100000, 100, 1e-8, 1e-8, 1e-8)),
+                boost::shared_ptr<OptimizationMethod>(
+                          new LevenbergMarquardt(1e-8, 1e-8, 1e-8)));
+            sabr.update();
+            sink = sink + sabr.alpha();
+        }
+        void tearDown() { strikes_.clear(); vols_.clear(); }
+      private:
+        static const Real forward_;
+        std::vector<Real> strikes_, vols_;
+    };
+
+    const Real SabrCalibrationBenchmark::forward_ = 0.039;
+
+    class HestonCalibrationBenchmark : public MicroBenchmark {
+      public:
+        HestonCalibrationBenchmark()
+        : MicroBenchmark("Calibration/Heston") {}
+        void setUp() {
+            model_ = makeHestonModel(0.1, 1.0, 0.1, 0.5, -0.5);
+            initialParams_ = model_->params();
+            const boost::shared_ptr<HestonProcess>& process =
+                model_->process();
+            boost::shared_ptr<PricingEngine> engine(
+                                     new AnalyticHestonEngine(model_, 64));
+            Integer maturities[] = { 3, 6, 12, 24 };
+            Real strikes[] = { 80.0, 90.0, 100.0, 110.0, 120.0 };
+            for (Size i=0; i<4; ++i) {
+                for (Size j=0; j<5; ++j) {
+                    // a skewed smile
+                    Real m = std::log(strikes[j]/100.0);
+                    Volatility vol = 0.2 - 0.2*m + 0.3*m*m;
+                    boost::shared_ptr<CalibrationHelper> helper(
+                        new HestonModelHelper(
+                            maturities[i]*Months, TARGET(), 100.0,
+                            strikes[j], Handle<Quote>(
+                                boost::shared_ptr<Quote>(new SimpleQuote(vol))),
+                            process->riskFreeRate(),
+                            process->dividendYield()));
+                    helper->setPricingEngine(engine);
+                    helpers_.push_back(helper);
+                }
+            }
+        }
+        void run() {
+            model_->setParams(initialParams_);
+            LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+            model_->calibrate(helpers_, om,
+                              EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+            sink = sink + model_->v0();
+        }
+        void tearDown() { helpers_.clear(); model_.reset(); }
+      private:
+        boost::shared_ptr<HestonModel> model_;
+        Array initialParams_;
+        std::vector<boost::shared_ptr<CalibrationHelper> > helpers_;
+    };
+
+
+    // observer pattern
+
+    class CountingObserver : public Observer {
+      public:
+        CountingObserver() : counter_(0) {}
+        void update() { ++counter_; }
+        Size counter() const { return counter_; }
+      private:
+        Size counter_;
+    };
+
+    class NotificationBenchmark : public MicroBenchmark {
+      public:
+        explicit NotificationBenchmark(Size observers)
+        : MicroBenchmark("Observable/notifyObservers/"
+                         + boost::lexical_cast<std::string>(observers)),
+          n_(observers) {}
+        void setUp() {
+            quote_ = boost::shared_ptr<SimpleQuote>(new SimpleQuote(1.0));
+            for (Size i=0; i<n_; ++i) {
+                observers_.push_back(boost::shared_ptr<CountingObserver>(
+                                                     new CountingObserver));
+                observers_.back()->registerWith(quote_);
+            }
+        }
+        void run() {
+            quote_->setValue(quote_->value() + 1.0);
+            sink = sink + Real(observers_.front()->counter());
+        }
+        void tearDown() { observers_.clear(); quote_.reset(); }
+      private:
+        Size n_;
+        boost::shared_ptr<SimpleQuote> quote_;
+        std::vector<boost::shared_ptr<CountingObserver> > observers_;
+    };
+
+
+    // driver
+
+    std::vector<boost::shared_ptr<MicroBenchmark> > benchmarks() {
+        std::vector<boost::shared_ptr<MicroBenchmark> > b;
+        typedef boost::shared_ptr<MicroBenchmark> ptr;
+
+        b.push_back(ptr(new BootstrapBenchmark(10)));
+        b.push_back(ptr(new BootstrapBenchmark(20)));
+        b.push_back(ptr(new BootstrapBenchmark(40)));
+
+        b.push_back(ptr(new InterpolationBenchmark(100)));
+        b.push_back(ptr(new InterpolationBenchmark(10000)));
+        b.push_back(ptr(new DateArithmeticBenchmark));
+        b.push_back(ptr(new CalendarAdvanceBenchmark("TARGET", TARGET())));
+        b.push_back(ptr(new CalendarAdvanceBenchmark(
+            "JointCalendar",
+            JointCalendar(TARGET(), UnitedKingdom(UnitedKingdom::Exchange)))));
+
+        b.push_back(ptr(new CashFlowsNpvBenchmark(false)));
+        b.push_back(ptr(new CashFlowsNpvBenchmark(true)));
+
+        for (Size i=0; i<2; ++i) {
+            b.push_back(ptr(new BlackFormulaBenchmark(i == 1, false)));
+            b.push_back(ptr(new BlackFormulaBenchmark(i == 1, true)));
+        }
+
+        for (Size i=0; i<3; ++i) {
+            b.push_back(ptr(new TripleBandBenchmark(i, false)));
+            b.push_back(ptr(new TripleBandBenchmark(i, true)));
+        }
+        b.push_back(ptr(new NinePointBenchmark));
+        b.push_back(ptr(new FdHestonBenchmark));
+
+        b.push_back(ptr(new PathGeneratorBenchmark<PseudoRandom>(
+                                                "MersenneTwister", false)));
+        b.push_back(ptr(new PathGeneratorBenchmark<PseudoRandom>(
+                                                "MersenneTwister", true)));
+        b.push_back(ptr(new PathGeneratorBenchmark<LowDiscrepancy>(
+                                                "Sobol", false)));
+        b.push_back(ptr(new PathGeneratorBenchmark<LowDiscrepancy>(
+                                                "Sobol", true)));
+
+        b.push_back(ptr(new SabrCalibrationBenchmark));
+        b.push_back(ptr(new HestonCalibrationBenchmark));
+
+        b.push_back(ptr(new NotificationBenchmark(100)));
+        b.push_back(ptr(new NotificationBenchmark(10000)));
+
+        return b;
+    }
+
+    Real timeIterations(MicroBenchmark& b, Size iterations) {
+        using namespace boost::posix_time;
+        ptime start = microsec_clock::universal_time();
+        for (Size i=0; i<iterations; ++i)
+            b.run();
+        time_duration elapsed = microsec_clock::universal_time() - start;
+        return elapsed.total_microseconds()*1.0e-6;
+    }
+
+    BenchmarkResult runBenchmark(MicroBenchmark& b,
+                                 Real minTime, Size repetitions) {
+        b.setUp();
+
+        // warm-up; this also triggers any lazy initialization
+        b.run();
+
+        // find the number of iterations needed to reach the minimum time
+        Size iterations = 1;
+        Real elapsed = timeIterations(b, iterations);
+        while (elapsed < minTime && iterations < 1000000000) {
+            Size factor = (elapsed > 0.01*minTime)
+                ? Size(1.4*minTime/elapsed) + 1 : 10;
+            iterations *= std::min<Size>(factor, 10);
+            elapsed = timeIterations(b, iterations);
+        }
+
+        GeneralStatistics stats;
+        stats.add(elapsed/iterations);
+        for (Size i=1; i<repetitions; ++i)
+            stats.add(timeIterations(b, iterations)/iterations);
+
+        b.tearDown();
+
+        BenchmarkResult r;
+        r.name = b.name();
+        r.iterations = iterations;
+        r.repetitions = repetitions;
+        r.mean = stats.mean();
+        r.median = stats.percentile(0.5);
+        r.stdDev = repetitions > 1 ? stats.standardDeviation() : 0.0;
+        r.min = stats.min();
+        r.max = stats.max();
+        return r;
+    }
+
+    std::string jsonString(const std::string& s) {
+        std::string r = "\"";
+        for (Size i=0; i<s.size(); ++i) {
+            if (s[i] == '"' || s[i] == '\\')
+                r += '\\';
+            r += s[i];
+        }
+        return r + "\"";
+    }
+
+    void writeJson(std::ostream& out,
+                   const std::vector<BenchmarkResult>& results,
+                   Real minTime, Size repetitions) {
+        out << "{\n"
+            << "  \"context\": {\n"
+            << "    \"library\": " << jsonString("QuantLib " QL_VERSION)
+            << ",\n"
+            << "    \"date\": "
+            << jsonString(boost::lexical_cast<std::string>(
+                                                    Date::todaysDate()))
+            << ",\n"
+            << "    \"clock\": \"wall\",\n"
+            << "    \"time_unit\": \"ns\",\n"
+            << "    \"min_time\": " << minTime << ",\n"
+            << "    \"repetitions\": " << repetitions << "\n"
+            << "  },\n"
+            << "  \"benchmarks\": [";
+        out << std::setprecision(12);
+        for (Size i=0; i<results.size(); ++i) {
+            const BenchmarkResult& r = results[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\n"
+                << "      \"name\": " << jsonString(r.name) << ",\n"
+                << "      \"iterations\": " << r.iterations << ",\n"
+                << "      \"repetitions\": " << r.repetitions << ",\n"
+                << "      \"mean\": " << r.mean*1e9 << ",\n"
+                << "      \"median\": " << r.median*1e9 << ",\n"
+                << "      \"stddev\": " << r.stdDev*1e9 << ",\n"
+                << "      \"min\": " << r.min*1e9 << ",\n"
+                << "      \"max\": " << r.max*1e9 << "\n"
+                << "    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    std::string formatTime(Real t) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(1);
+        if (t < 1e-6)
+            s << t*1e9 << " ns";
+        else if (t < 1e-3)
+            s << t*1e6 << " us";
+        else
+            s << t*1e3 << " ms";
+        return s.str();
+    }
+
+    void writeTableHeader(std::ostream& out) {
+        out << std::left << std::setw(48) << "Benchmark"
+            << std::right << std::setw(14) << "Median"
+            << std::setw(14) << "Mean"
+            << std::setw(10) << "StdDev"
+            << std::setw(12) << "Iterations" << std::endl
+            << std::string(98, '-') << std::endl;
+    }
+
+    void writeTableRow(std::ostream& out, const BenchmarkResult& r) {
+        std::ostringstream rsd;
+        rsd << std::fixed << std::setprecision(1)
+            << (r.mean > 0.0 ? 100.0*r.stdDev/r.mean : 0.0) << " %";
+        out << std::left << std::setw(48) << r.name
+            << std::right << std::setw(14) << formatTime(r.median)
+            << std::setw(14) << formatTime(r.mean)
+            << std::setw(10) << rsd.str()
+            << std::setw(12) << r.iterations << std::endl;
+    }
+
+    bool startsWith(const std::string& s, const std::string& prefix) {
+        return s.compare(0, prefix.size(), prefix) == 0;
+    }
+
+}
+
+
+int main(int argc, char* argv[]) {
+
+    try {
+        std::string filter, jsonFile;
+        Real minTime = 0.1;
+        Size repetitions = 5;
+        bool list = false;
+
+        for (int i=1; i<argc; ++i) {
+            std::string arg = argv[i];
+            if (startsWith(arg, "--filter="))
+                filter = arg.substr(9);
+            else if (startsWith(arg, "--min-time="))
+                minTime = boost::lexical_cast<Real>(arg.substr(11));
+            else if (startsWith(arg, "--repetitions="))
+                repetitions = boost::lexical_cast<Size>(arg.substr(14));
+            else if (startsWith(arg, "--json="))
+                jsonFile = arg.substr(7);
+            else if (arg == "--list")
+                list = true;
+            else
+                QL_FAIL("unknown option: " << arg);
+        }
+        QL_REQUIRE(repetitions > 0, "at least one repetition required");
+        QL_REQUIRE(minTime >= 0.0, "negative minimum time given");
+
+        Settings::instance().evaluationDate() = Date(15, June, 2015);
+
+        std::vector<boost::shared_ptr<MicroBenchmark> > all = benchmarks();
+        std::vector<boost::shared_ptr<MicroBenchmark> > selected;
+        for (Size i=0; i<all.size(); ++i) {
+            if (all[i]->name().find(filter) != std::string::npos)
+                selected.push_back(all[i]);
+        }
+
+        if (list) {
+            for (Size i=0; i<selected.size(); ++i)
+                std::cout << selected[i]->name() << std::endl;
+            return 0;
+        }
+
+        bool table = (jsonFile != "-");
+        if (table) {
+            std::cout << "Micro-benchmark suite QuantLib " QL_VERSION
+                      << std::endl << std::endl;
+            writeTableHeader(std::cout);
+        }
+
+        std::vector<BenchmarkResult> results;
+        for (Size i=0; i<selected.size(); ++i) {
+            results.push_back(runBenchmark(*selected[i],
+                                           minTime, repetitions));
+            if (table)
+                writeTableRow(std::cout, results.back());
+        }
+
+        if (jsonFile == "-") {
+            writeJson(std::cout, results, minTime, repetitions);
+        } else if (!jsonFile.empty()) {
+            std::ofstream out(jsonFile.c_str());
+            QL_REQUIRE(out, "unable to open " << jsonFile);
+            writeJson(out, results, minTime, repetitions);
+        }
+
+        return 0;
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+        return 1;
+    }
+}
@@ -24,10 +24,17 @@
 #include "shortratemodels.hpp"
 #include "utilities.hpp"
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/onefactormodels/blackkarasinski.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/swaption/treeswaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
+#include <ql/pricingengines/capfloor/treecapfloorengine.hpp>
+#include <ql/pricingengines/capfloor/discretizedcapfloor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/makecapfloor.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/math/optimization/simplex.hpp>
@@ -287,6 +294,101 @@ void ShortRateModelTest::testCachedHullWhite2() {
     }
 }
 
+void ShortRateModelTest::testConcurrentCalibration() {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration with one engine "
+                       "per helper against a shared engine...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    CalibrationHelper::CalibrationErrorType errorTypes[] = {
+        CalibrationHelper::RelativePriceError,
+        CalibrationHelper::ImpliedVolError };
+
+    // the tree engine is checked on fewer helpers to save time
+    bool useTree[] = { false, true };
+
+    for (Size e=0; e<LENGTH(useTree); e++) {
+      for (Size k=0; k<LENGTH(errorTypes); k++) {
+        boost::shared_ptr<HullWhite> serialModel(new HullWhite(termStructure));
+        boost::shared_ptr<HullWhite> concurrentModel(
+                                               new HullWhite(termStructure));
+        boost::shared_ptr<PricingEngine> sharedEngine;
+        if (useTree[e])
+            sharedEngine = boost::shared_ptr<PricingEngine>(
+                                   new TreeSwaptionEngine(serialModel, 40));
+        else
+            sharedEngine = boost::shared_ptr<PricingEngine>(
+                                   new JamshidianSwaptionEngine(serialModel));
+        Size maxLength = useTree[e] ? 2 : 5;
+
+        std::vector<boost::shared_ptr<CalibrationHelper> > serialHelpers,
+                                                           concurrentHelpers;
+        for (Size start=1; start<=5; start++) {
+            for (Size length=1; length<=maxLength; length++) {
+                Handle<Quote> vol(boost::shared_ptr<Quote>(
+                    new SimpleQuote(0.12 - 0.002*start - 0.001*length)));
+
+                boost::shared_ptr<CalibrationHelper> helper(
+                    new SwaptionHelper(Period(start, Years),
+                                       Period(length, Years), vol, index,
+                                       Period(1, Years), Thirty360(),
+                                       Actual360(), termStructure,
+                                       errorTypes[k]));
+                helper->setPricingEngine(sharedEngine);
+                serialHelpers.push_back(helper);
+
+                helper = boost::shared_ptr<CalibrationHelper>(
+                    new SwaptionHelper(Period(start, Years),
+                                       Period(length, Years), vol, index,
+                                       Period(1, Years), Thirty360(),
+                                       Actual360(), termStructure,
+                                       errorTypes[k]));
+                if (useTree[e])
+                    helper->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                             new TreeSwaptionEngine(concurrentModel, 40)));
+                else
+                    helper->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                             new JamshidianSwaptionEngine(concurrentModel)));
+                concurrentHelpers.push_back(helper);
+            }
+        }
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+        serialModel->calibrate(serialHelpers, optimizationMethod,
+                               endCriteria);
+        concurrentModel->calibrate(concurrentHelpers, optimizationMethod,
+                                   endCriteria, Constraint(),
+                                   std::vector<Real>(), std::vector<bool>(),
+                                   true);
+
+        // the helpers are priced in the same way, only in parallel
+        Array expected = serialModel->params();
+        Array calculated = concurrentModel->params();
+        Real tolerance = 1.0e-12;
+        for (Size i=0; i<expected.size(); i++) {
+            if (std::fabs(calculated[i]-expected[i]) > tolerance)
+                BOOST_ERROR("Failed to reproduce serial calibration:"
+                            << "\n    engine:      "
+                            << (useTree[e] ? "tree" : "Jamshidian")
+                            << "\n    error type:  " << errorTypes[k]
+                            << "\n    parameter:   " << i
+                            << "\n    calculated:  " << calculated[i]
+                            << "\n    expected:    " << expected[i]);
+        }
+      }
+    }
+}
+
 void ShortRateModelTest::testSwaps() {
     BOOST_TEST_MESSAGE("Testing Hull-White swap pricing against known values...");
 
@@ -427,13 +529,160 @@ void ShortRateModelTest::testFuturesConvexityBias() {
     }
 }
 
+void ShortRateModelTest::testTreeRollback() {
+    BOOST_TEST_MESSAGE("Testing short-rate tree rollback against "
+                       "its lattice interface...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(flatRate(today, 0.04,
+                                                      Actual365Fixed()));
+
+    std::vector<boost::shared_ptr<OneFactorModel> > models;
+    models.push_back(boost::shared_ptr<OneFactorModel>(
+                               new HullWhite(termStructure, 0.05, 0.01)));
+    models.push_back(boost::shared_ptr<OneFactorModel>(
+                         new BlackKarasinski(termStructure, 0.05, 0.2)));
+
+    TimeGrid grid(10.0, 200);
+    Real tolerance = 1.0e-15;
+
+    for (Size k=0; k<models.size(); k++) {
+        boost::shared_ptr<OneFactorModel::ShortRateTree> tree =
+            boost::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(
+                                                    models[k]->tree(grid));
+        BOOST_REQUIRE(tree);
+
+        for (Size i=0; i<grid.size()-1; i++) {
+            Array values(tree->size(i+1));
+            for (Size j=0; j<values.size(); j++)
+                values[j] = std::exp(0.1*tree->underlying(i+1,j));
+
+            Array newValues(tree->size(i));
+            tree->stepback(i, values, newValues);
+
+            for (Size j=0; j<newValues.size(); j++) {
+                Real expected = 0.0;
+                for (Size l=0; l<3; l++)
+                    expected += tree->probability(i,j,l) *
+                                values[tree->descendant(i,j,l)];
+                expected *= tree->discount(i,j);
+
+                Real error = std::fabs(newValues[j]-expected);
+                if (error > tolerance*expected)
+                    BOOST_ERROR("failed to reproduce lattice rollback"
+                                << "\n    model:    " << k
+                                << "\n    level:    " << i
+                                << "\n    node:     " << j
+                                << std::setprecision(16)
+                                << "\n    value:    " << newValues[j]
+                                << "\n    expected: " << expected
+                                << QL_SCIENTIFIC
+                                << "\n    error:    " << error);
+            }
+        }
+    }
+}
+
+void ShortRateModelTest::testLatticeBook() {
+    BOOST_TEST_MESSAGE("Testing a book of instruments priced together "
+                       "on a short-rate lattice...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(today, 0.04875825,
+                                                      Actual365Fixed()));
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+    boost::shared_ptr<HullWhite> model(new HullWhite(termStructure,
+                                                     0.048696, 0.0058904));
+    Date referenceDate = termStructure->referenceDate();
+    DayCounter dayCounter = termStructure->dayCounter();
+
+    std::vector<boost::shared_ptr<Instrument> > instruments;
+    std::vector<boost::shared_ptr<DiscretizedAsset> > assets;
+
+    for (Size start=1; start<=3; start++) {
+        for (Size length=2; length<=4; length++) {
+            boost::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(Period(length, Years), index,
+                                0.045 + 0.0025*length,
+                                Period(start, Years));
+            std::vector<Date> exerciseDates;
+            const Leg& leg = swap->fixedLeg();
+            for (Size i=0; i<leg.size(); i++)
+                exerciseDates.push_back(
+                    boost::dynamic_pointer_cast<Coupon>(leg[i])
+                                                    ->accrualStartDate());
+            boost::shared_ptr<Swaption> swaption(new Swaption(swap,
+                boost::shared_ptr<Exercise>(
+                                   new BermudanExercise(exerciseDates))));
+            Swaption::arguments arguments;
+            swaption->setupArguments(&arguments);
+            instruments.push_back(swaption);
+            assets.push_back(boost::shared_ptr<DiscretizedAsset>(new
+                DiscretizedSwaption(arguments, referenceDate, dayCounter)));
+        }
+    }
+    for (Size length=2; length<=6; length+=2) {
+        boost::shared_ptr<CapFloor> cap =
+            MakeCapFloor(CapFloor::Cap, Period(length, Years), index, 0.05);
+        CapFloor::arguments arguments;
+        cap->setupArguments(&arguments);
+        instruments.push_back(cap);
+        assets.push_back(boost::shared_ptr<DiscretizedAsset>(new
+            DiscretizedCapFloor(arguments, referenceDate, dayCounter)));
+    }
+
+    Size timeSteps = 100;
+    TreeSwaptionEngine bookEngine(model, timeSteps);
+    std::vector<Real> values = bookEngine.presentValues(assets);
+
+    // the instruments priced one by one on the same time grid
+    std::vector<Time> times;
+    for (Size k=0; k<assets.size(); k++) {
+        std::vector<Time> assetTimes = assets[k]->mandatoryTimes();
+        times.insert(times.end(), assetTimes.begin(), assetTimes.end());
+    }
+    TimeGrid grid(times.begin(), times.end(), timeSteps);
+    boost::shared_ptr<PricingEngine> swaptionEngine(
+                                      new TreeSwaptionEngine(model, grid));
+    boost::shared_ptr<PricingEngine> capEngine(
+                                      new TreeCapFloorEngine(model, grid));
+
+    Real tolerance = 1.0e-10;
+    for (Size k=0; k<instruments.size(); k++) {
+        if (boost::dynamic_pointer_cast<Swaption>(instruments[k]))
+            instruments[k]->setPricingEngine(swaptionEngine);
+        else
+            instruments[k]->setPricingEngine(capEngine);
+        Real expected = instruments[k]->NPV();
+
+        Real error = std::fabs(values[k]-expected);
+        if (error > tolerance)
+            BOOST_ERROR("failed to reproduce single-instrument price"
+                        << "\n    instrument: " << k
+                        << QL_FIXED << std::setprecision(12)
+                        << "\n    book:       " << values[k]
+                        << "\n    single:     " << expected
+                        << QL_SCIENTIFIC
+                        << "\n    error:      " << error);
+    }
+}
+
 test_suite* ShortRateModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhiteFixedReversion));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testConcurrentCalibration));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeRollback));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testLatticeBook));
     return suite;
 }
 
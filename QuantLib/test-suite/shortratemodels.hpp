@@ -31,7 +31,10 @@ class ShortRateModelTest {
     static void testCachedHullWhite();
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
+    static void testConcurrentCalibration();
     static void testSwaps();
+    static void testTreeRollback();
+    static void testLatticeBook();
     static boost::unit_test_framework::test_suite* suite();
 };
 
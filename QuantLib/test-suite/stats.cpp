@@ -26,6 +26,9 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -119,6 +122,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingRiskStatistics>(std::string("StreamingRiskStatistics"));
 }
 
 
@@ -239,6 +243,8 @@ void StatisticsTest::testSequenceStatistics() {
     checkSequence<IncrementalStatistics>(
         std::string("IncrementalStatistics"),5);
     checkSequence<Statistics>(std::string("Statistics"),5);
+    checkSequence<StreamingRiskStatistics>(
+        std::string("StreamingRiskStatistics"),5);
 }
 
 
@@ -319,6 +325,116 @@ void StatisticsTest::testConvergenceStatistics() {
     checkConvergence<IncrementalStatistics>(
                               std::string("IncrementalStatistics"));
     checkConvergence<Statistics>(std::string("Statistics"));
+    checkConvergence<StreamingRiskStatistics>(
+                              std::string("StreamingRiskStatistics"));
+}
+
+
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics...");
+
+    // few samples are kept exactly
+    StreamingRiskStatistics small;
+    Statistics reference;
+    for (Size i=0; i<LENGTH(data); i++) {
+        small.add(data[i], weights[i]);
+        reference.add(data[i], weights[i]);
+    }
+    Real percentiles[] = { 0.1, 0.25, 0.5, 0.75, 0.9, 1.0 };
+    for (Size i=0; i<LENGTH(percentiles); i++) {
+        Real calculated = small.percentile(percentiles[i]);
+        Real expected = reference.percentile(percentiles[i]);
+        if (calculated != expected)
+            BOOST_FAIL("wrong " << io::percent(percentiles[i])
+                       << " percentile for small sample:"
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+        calculated = small.topPercentile(percentiles[i]);
+        expected = reference.topPercentile(percentiles[i]);
+        if (calculated != expected)
+            BOOST_FAIL("wrong " << io::percent(percentiles[i])
+                       << " top percentile for small sample:"
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+    }
+
+    // large samples are accumulated in separate instances and merged
+    Size samples = 400000, parts = 4;
+    MersenneTwisterUniformRng rng(42);
+    InverseCumulativeNormal invNormal(0.05, 0.2);
+    Statistics exact;
+    StreamingRiskStatistics single;
+    std::vector<StreamingRiskStatistics> partial(parts);
+    for (Size i=0; i<samples; i++) {
+        Real x = invNormal(rng.next().value);
+        exact.add(x);
+        single.add(x);
+        partial[i % parts].add(x);
+    }
+    StreamingRiskStatistics merged = partial[0];
+    for (Size j=1; j<parts; j++)
+        merged.merge(partial[j]);
+
+    if (merged.samples() != samples || single.samples() != samples)
+        BOOST_FAIL("wrong number of samples:"
+                   << "\n    single: " << single.samples()
+                   << "\n    merged: " << merged.samples()
+                   << "\n    expected:   " << samples);
+
+    Real tolerance = 1.0e-10;
+    #define CHECK_MOMENT(METHOD) \
+    if (std::fabs(single.METHOD()-exact.METHOD()) > tolerance \
+        || std::fabs(merged.METHOD()-exact.METHOD()) > tolerance) \
+        BOOST_FAIL("wrong " #METHOD ":" \
+                   << std::setprecision(12) \
+                   << "\n    single:   " << single.METHOD() \
+                   << "\n    merged:   " << merged.METHOD() \
+                   << "\n    expected: " << exact.METHOD());
+    CHECK_MOMENT(mean)
+    CHECK_MOMENT(variance)
+    CHECK_MOMENT(skewness)
+    CHECK_MOMENT(kurtosis)
+    CHECK_MOMENT(min)
+    CHECK_MOMENT(max)
+    #undef CHECK_MOMENT
+
+    // the estimates are checked against the empirical distribution by
+    // measuring the error on the rank of the returned values
+    CumulativeNormalDistribution cdf(0.05, 0.2);
+    Real centiles[] = { 0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99 };
+    for (Size i=0; i<LENGTH(centiles); i++) {
+        Real p = centiles[i];
+        Real maxError = std::sqrt(p*(1.0-p))/merged.compression();
+        Real q[] = { single.percentile(p), merged.percentile(p) };
+        for (Size k=0; k<LENGTH(q); k++) {
+            Real rankError = std::fabs(cdf(q[k]) - cdf(exact.percentile(p)));
+            if (rankError > maxError)
+                BOOST_FAIL("wrong " << io::percent(p) << " percentile ("
+                           << (k == 0 ? "single" : "merged") << "):"
+                           << std::setprecision(8)
+                           << "\n    calculated: " << q[k]
+                           << "\n    expected:   " << exact.percentile(p)
+                           << "\n    rank error: " << rankError
+                           << "\n    tolerance:  " << maxError);
+        }
+    }
+
+    // expectation values are approximated by replacing the samples
+    // with the centroids of the sketch
+    tolerance = 1.0e-2;
+    Real calculated = merged.valueAtRisk(0.99);
+    Real expected = exact.valueAtRisk(0.99);
+    if (std::fabs(calculated-expected) > tolerance*expected)
+        BOOST_FAIL("wrong value at risk:"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+    calculated = merged.expectedShortfall(0.99);
+    expected = exact.expectedShortfall(0.99);
+    if (std::fabs(calculated-expected) > tolerance*expected)
+        BOOST_FAIL("wrong expected shortfall:"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
 }
 
 
@@ -328,6 +444,7 @@ test_suite* StatisticsTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
     return suite;
 }
 
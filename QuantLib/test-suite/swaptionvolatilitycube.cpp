@@ -442,6 +442,114 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testSabrRecalibration() {
+    BOOST_TEST_MESSAGE("Testing sabr volatility cube recalibration "
+                       "after an atm volatility change...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SwaptionVolCube1 volCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             true);
+    SwaptionVolCube1 warmStartedCube(vars.atmVolMatrix,
+                                     vars.cube.tenors.options,
+                                     vars.cube.tenors.swaps,
+                                     vars.cube.strikeSpreads,
+                                     vars.cube.volSpreadsHandle,
+                                     vars.swapIndexBase,
+                                     vars.shortSwapIndexBase,
+                                     vars.vegaWeighedSmileFit,
+                                     parametersGuess,
+                                     isParameterFixed,
+                                     true,
+                                     boost::shared_ptr<EndCriteria>(),
+                                     Null<Real>(),
+                                     boost::shared_ptr<OptimizationMethod>(),
+                                     Null<Real>(), false, 50, false, 0.0001,
+                                     true);
+    Rate dummyStrike = 0.03;
+    volCube.volatility(vars.cube.tenors.options[0], vars.cube.tenors.swaps[0],
+                       dummyStrike, false);
+    warmStartedCube.volatility(vars.cube.tenors.options[0],
+                               vars.cube.tenors.swaps[0], dummyStrike, false);
+
+    // only the nodes around the changed atm volatility are fitted again
+    boost::shared_ptr<SimpleQuote> atmVol =
+        boost::dynamic_pointer_cast<SimpleQuote>(
+                                   vars.atm.volsHandle[2][1].currentLink());
+    atmVol->setValue(atmVol->value() + 0.005);
+
+    SwaptionVolCube1 newCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             true);
+
+    for (Size i=0;i<vars.cube.tenors.options.size(); i++ ) {
+        for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+            for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                Rate strike = dummyStrike + vars.cube.strikeSpreads[k];
+                Volatility expected =
+                    newCube.volatility(vars.cube.tenors.options[i],
+                                       vars.cube.tenors.swaps[j],
+                                       strike, false);
+                Volatility calculated =
+                    volCube.volatility(vars.cube.tenors.options[i],
+                                       vars.cube.tenors.swaps[j],
+                                       strike, false);
+                if (std::fabs(calculated - expected) > 1e-14)
+                    BOOST_ERROR("recalibrated cube differs from new cube:" <<
+                                " option tenor = " << vars.cube.tenors.options[i] <<
+                                " swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                " strike = " << io::rate(strike) <<
+                                "  calculated = " << io::volatility(calculated) <<
+                                "  expected = " << io::volatility(expected));
+
+                calculated =
+                    warmStartedCube.volatility(vars.cube.tenors.options[i],
+                                               vars.cube.tenors.swaps[j],
+                                               strike, false);
+                if (std::fabs(calculated - expected) > 1e-4)
+                    BOOST_ERROR("warm-started cube differs from new cube:" <<
+                                " option tenor = " << vars.cube.tenors.options[i] <<
+                                " swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                " strike = " << io::rate(strike) <<
+                                "  calculated = " << io::volatility(calculated) <<
+                                "  expected = " << io::volatility(expected));
+            }
+        }
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -459,5 +567,8 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                         &SwaptionVolatilityCubeTest::testSabrRecalibration));
+
     return suite;
 }